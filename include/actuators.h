@@ -18,22 +18,35 @@ void actuators_init();
 // Reads from g_state.output and writes to hardware
 void actuators_update();
 
+// Background work between control loop ticks
+// Sends the DShot stop frame owed by actuators_emergency_stop()
+// Call this from the main loop's idle time
+void actuators_idle();
+
 // Emergency stop - force all outputs to safe states immediately
-// Bypasses g_state and directly commands hardware
+// Bypasses g_state and directly commands hardware. Safe to call from an
+// ISR (the CRSF fast kill path does). Outputs stay held safe until the
+// kill is released and the weapon has taken the stop event. A DShot
+// weapon ESC gets its stop frame from actuators_idle() or the next
+// actuators_update(), whichever runs first
 void actuators_emergency_stop();
 
+// Take (read and clear) the pending emergency stop event
+// Returns true once per actuators_emergency_stop(); the weapon disarms on it
+bool actuators_take_stop_event();
+
 // ============================================================================
 // PHASE 3: INDIVIDUAL MOTOR CONTROL
 // ============================================================================
 
-// Set individual motor command with slew-rate limiting and polarity correction
+// Set individual motor command with compensation and thermal limiting
 // motor_index: 0=RL, 1=RR, 2=FL, 3=FR
 // command: Signed command [-255, +255] (positive = forward, negative = reverse)
 // This function applies:
-// - Polarity inversion (if motor is flagged as inverted)
-// - Global duty cycle clamping (thermal protection)
-// - Slew-rate limiting (prevents current spikes)
-// Updates g_state.output with the clamped/slewed value
+// - Per-motor deadzone/gain compensation (see motor_comp.h)
+// - Dynamic duty limit from the L293D thermal model (see thermal.h)
+// Polarity inversion is applied later, when outputs are written
+// Updates g_state.output with the compensated/clamped value
 void actuators_set_motor(uint8_t motor_index, int16_t command);
 
 #endif // ACTUATORS_H
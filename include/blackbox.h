@@ -0,0 +1,60 @@
+// blackbox.h - Black-box flight recorder (delta-encoded control frames)
+// UpVote Battlebot - Phase 8
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// RECORDING FORMAT
+// ============================================================================
+
+// Fields recorded every tick, in order (the decoder uses the same order):
+//   0-7   raw_channels[0..7]      11 - BLACKBOX_CHANNEL_SHIFT bits in a keyframe
+//   8-11  motor FL, FR, RL, RR    9 bits (PWM + 256)
+//   12    weapon_us               12 bits
+//   13    servo_us                12 bits
+//   14    arm_state               1 bit
+//   15    loop duration           8 bits (us >> BLACKBOX_LOOP_SHIFT, saturated)
+#define BLACKBOX_FIELDS  16
+
+// Block (byte aligned, bits MSB first):
+//   [tick count][start ms, 16 bits][keyframe: every field at its width]
+//   then (tick count - 1) ticks: 1 bit "changed", and if set every field as
+//   an Exp-Golomb coded, zigzagged difference from the previous tick
+#define BLACKBOX_FORMAT_VERSION  1
+
+// Why the ring was frozen
+enum BlackboxTrigger {
+  BLACKBOX_TRIGGER_NONE = 0,      // Still recording (a dump shows the latest ticks)
+  BLACKBOX_TRIGGER_FAILSAFE = 1,  // Link lost
+  BLACKBOX_TRIGGER_ERROR = 2      // Error latched (see safety_get_error())
+};
+
+// Dump frame (CRSF frame type, ignored by the receiver)
+#define CRSF_FRAMETYPE_BLACKBOX    0x7F
+#define BLACKBOX_DUMP_CHUNK        24    // Ring bytes per data frame
+#define BLACKBOX_DUMP_PAYLOAD_MAX  (3 + BLACKBOX_DUMP_CHUNK)
+
+// ============================================================================
+// BLACKBOX MODULE INTERFACE
+// ============================================================================
+
+// Start an empty recording
+// Call this ONCE in setup()
+void blackbox_init();
+
+// Record this tick, watch for triggers and the dump gesture
+// Call this every control loop iteration (100 Hz), after actuators_update()
+void blackbox_update();
+
+// Next dump frame payload for the telemetry UART, if one is due
+// Frames: 'H' header, 'D' data (byte offset + up to BLACKBOX_DUMP_CHUNK
+// bytes), 'E' end (byte count + CRC); payload holds BLACKBOX_DUMP_PAYLOAD_MAX
+// Returns: Payload length written to payload (0 = nothing due)
+uint8_t blackbox_dump_frame(uint8_t* payload);
+
+// Check if the recording is frozen (trigger hit, waiting for a dump)
+bool blackbox_frozen();
+
+#endif // BLACKBOX_H
@@ -11,22 +11,22 @@
 // See: docs/hardware/pin_assignments.md for full pinout details
 
 // --- Drive Motors (via L293D Shield) ---
-// PHASE 7: AFMotor library now controls motor PWM - these pins are RESERVED
-// AFMotor pin usage: Pin 3 (M2), Pin 5 (M4), Pin 6 (M3), Pin 11 (M1)
-// Old manual PWM control (deprecated - kept for reference only):
-#define PIN_MOTOR_FL_PWM    9   // OLD: Front-Left motor (M3 on shield, Timer1) - NOW USED FOR WEAPON
-#define PIN_MOTOR_FR_PWM   10   // OLD: Front-Right motor (M4 on shield, Timer1) - NOW USED FOR SERVO
-#define PIN_MOTOR_RL_PWM    5   // OLD: Rear-Left motor (M1 on shield, Timer0) - RESERVED BY AFMOTOR
-#define PIN_MOTOR_RR_PWM    6   // OLD: Rear-Right motor (M2 on shield, Timer0) - RESERVED BY AFMOTOR
+// Driven directly by motor_driver.cpp (PWM compare registers + port I/O)
+// Shield PWM pins: fixed by the shield wiring, listed for reference
+#define PIN_MOTOR_RL_PWM   11   // M1 terminal, Timer2A (OC2A / PB3)
+#define PIN_MOTOR_RR_PWM    3   // M2 terminal, Timer2B (OC2B / PD3)
+#define PIN_MOTOR_FR_PWM    6   // M3 terminal, Timer0A (OC0A / PD6)
+#define PIN_MOTOR_FL_PWM    5   // M4 terminal, Timer0B (OC0B / PD5)
 
 // 74HC595 Shift Register Control (for motor direction)
-#define PIN_SR_LATCH       12   // Shift register latch (STcp)
-#define PIN_SR_ENABLE       7   // Shift register output enable (OE, active LOW)
-#define PIN_SR_DATA         8   // Serial data input (DS)
-#define PIN_SR_CLOCK        4   // Shift clock (SHcp)
+// motor_driver.cpp accesses these through their port bits (noted right)
+#define PIN_SR_LATCH       12   // Shift register latch (STcp)         PB4
+#define PIN_SR_ENABLE       7   // Shift register output enable (OE)  PD7, active LOW
+#define PIN_SR_DATA         8   // Serial data input (DS)              PB0
+#define PIN_SR_CLOCK        4   // Shift clock (SHcp)                  PD4
 
 // --- Weapon ESC (bypasses shield, uses Timer1) ---
-// CRITICAL: AFMotor library uses pins 3,5,6,11 for motor PWM - cannot use these!
+// CRITICAL: The motor driver uses pins 3,5,6,11 for motor PWM - cannot use these!
 // Pin 3 = M2 PWM (Timer2B/OC2B), Pin 11 = M1 PWM (Timer2A/OC2A)
 // Available pins: 9 (Timer1A/OC1A), 10 (Timer1B/OC1B)
 #define PIN_WEAPON_ESC      9   // Weapon motor ESC PWM signal (Timer1A)
@@ -34,13 +34,31 @@
 // --- Self-Righting Servo (bypasses shield, uses Timer1) ---
 #define PIN_SELFRIGHT_SERVO 10  // Self-righting servo PWM signal (Timer1B)
 
-// --- CRSF Receiver (Hardware Serial) ---
-#define PIN_CRSF_RX         0   // Hardware Serial RX (Arduino RX pin)
-#define PIN_CRSF_TX         1   // Hardware Serial TX (Arduino TX pin)
+// --- CRSF Receiver (USART0, driven by crsf_uart.cpp instead of Serial) ---
+#define PIN_CRSF_RX         0   // USART0 RX (Arduino RX pin)
+#define PIN_CRSF_TX         1   // USART0 TX (Arduino TX pin)
 
 // --- Diagnostics ---
 #define PIN_STATUS_LED     LED_BUILTIN  // Status LED (pin 13)
 
+// --- Optional: Wheel Encoders (Phase 8) ---
+// Single-channel encoders on spare pins (direction taken from the command)
+// A1-A3 share pin-change vector PCINT1, pin 2 uses external interrupt INT0
+#define PIN_ENCODER_RL     A1   // PC1 / PCINT9
+#define PIN_ENCODER_RR     A2   // PC2 / PCINT10
+#define PIN_ENCODER_FL     A3   // PC3 / PCINT11
+#define PIN_ENCODER_FR      2   // PD2 / INT0
+
+// --- Optional: Weapon Tachometer (Phase 8) ---
+// Hall sensor / optical tach on the weapon (open collector, one pulse per
+// magnet). Input capture (ICP1 / D8) is taken by the shift register data
+// line, so the pulse is timestamped on INT0 - the pin the FR encoder uses
+#define PIN_WEAPON_TACH     2   // PD2 / INT0 (not with ENCODER_BACKEND_HW)
+
+// --- Optional: Gyro / IMU (I2C, Phase 8) ---
+// MPU-6050 breakout on the hardware I2C pins (A4 = SDA, A5 = SCL)
+#define GYRO_I2C_ADDRESS   0x68  // MPU-6050 with AD0 low (0x69 with AD0 high)
+
 // --- Optional: Battery Voltage Monitoring ---
 // #define PIN_BATTERY_MONITOR A0  // Analog pin for voltage divider (optional)
 
@@ -61,27 +79,122 @@
 #define MOTOR_PWM_MIN       0   // Motor stopped
 #define MOTOR_PWM_MAX     255   // Motor full speed
 
-// Motor direction bit positions in shift register
-// Shift register bit layout (8 bits total):
-// [M4_B | M4_A | M3_B | M3_A | M2_B | M2_A | M1_B | M1_A]
-#define SR_M1_A  0  // Rear-Left motor, direction A
-#define SR_M1_B  1  // Rear-Left motor, direction B
-#define SR_M2_A  2  // Rear-Right motor, direction A
-#define SR_M2_B  3  // Rear-Right motor, direction B
-#define SR_M3_A  4  // Front-Left motor, direction A
-#define SR_M3_B  5  // Front-Left motor, direction B
-#define SR_M4_A  6  // Front-Right motor, direction A
-#define SR_M4_B  7  // Front-Right motor, direction B
-
-// Phase 3: Slew-rate limiting (Phase 3)
-// Maximum PWM change per control loop iteration (100 Hz = 10ms)
-// 25 units/tick = 0-255 in ~100ms (prevents current spikes)
-#define MOTOR_SLEW_RATE_MAX  25
-
-// Phase 3: Global duty cycle clamp (thermal protection)
-// Limits maximum PWM duty cycle for all motors
-// 255 = 100% duty, 204 = 80% duty (recommended for thermal safety)
-#define MOTOR_DUTY_CLAMP_MAX  204  // 80% max duty cycle
+// Motor PWM frequency, identical on all four channels (Timer2 for M1/M2,
+// Timer0 for M3/M4, both fast PWM at this prescaler)
+//   8  - 7.8 kHz: quieter (default), but the winding current barely builds
+//        in a short on-time: much less torque at low duty, starts later
+//   64 - 976 Hz: Arduino's stock Timer0 rate, whines; more low-duty torque
+//        and a straighter duty-to-speed curve (test/native/test_pwm_linearity)
+// Timer0 is also the millis()/micros() timebase - use timebase_millis() /
+// timebase_micros(), which rescale for the prescaler. Prescaler 1 (62.5 kHz,
+// ultrasonic) is not offered: Timer0's overflow ISR would fire every 16us
+// (~35% CPU), and the L293D's ~1us switching delays eat the low duties.
+// Recalibrate the motor deadzones (MOTOR_COMP_CALIBRATION) after changing
+#ifndef MOTOR_PWM_PRESCALER
+#define MOTOR_PWM_PRESCALER   8
+#endif
+
+// Motor direction bit positions in the shield's 74HC595 shift register
+// (L293D V1 shield wiring, same as the Adafruit AFMotor library)
+// Shift register bit layout (bit 7 first out):
+// [M3_B | M4_B | M3_A | M2_B | M1_B | M1_A | M2_A | M4_A]
+// Forward = A high/B low, reverse = A low/B high, coast = both low,
+// brake = both high (strength set by the PWM duty on the enable pin)
+#define SR_M1_A  2  // Rear-Left motor, direction A
+#define SR_M1_B  3  // Rear-Left motor, direction B
+#define SR_M2_A  1  // Rear-Right motor, direction A
+#define SR_M2_B  4  // Rear-Right motor, direction B
+#define SR_M3_A  5  // Front-Right motor, direction A
+#define SR_M3_B  7  // Front-Right motor, direction B
+#define SR_M4_A  0  // Front-Left motor, direction A
+#define SR_M4_B  6  // Front-Left motor, direction B
+
+// Phase 8: Wheel direction reversal (per motor, after compensation)
+// A wheel command that flips sign brakes the motor (A = B = HIGH) for
+// REVERSE_BRAKE_MS, then ramps the new direction in from zero over
+// REVERSE_RAMP_MS, instead of plugging it straight into reverse. Only a
+// wheel last driven above its breakaway duty (motor_comp deadzone) plus
+// REVERSE_MIN_DUTY counts as reversing; slower wheels, and wheels stopped
+// for REVERSE_BRAKE_MS, change direction without the brake.
+// Stopped wheels coast or brake per drive profile (<MODE>_STOP_BRAKE)
+#define MOTOR_REVERSE_BRAKE_MS    30   // Brake dead time on a sign change
+#define MOTOR_REVERSE_BRAKE_DUTY 255   // Brake strength during the dead time
+#define MOTOR_REVERSE_RAMP_MS     60   // 0 -> full duty after a reversal (0 = off)
+#define MOTOR_REVERSE_MIN_DUTY    20   // Duty over breakaway that makes a reversal
+
+// Phase 3: Continuous duty cycle rating (thermal protection)
+// Duty a motor may hold indefinitely: 255 = 100% duty, 204 = 80% duty
+// Phase 8: Enforced by the thermal model below, not as a fixed clamp. A cool
+// channel gets full duty; under continuous full demand the derating settles
+// near this duty (keep THERMAL_DERATE_START_DUTY below it)
+#define MOTOR_DUTY_CLAMP_MAX  204  // 80% continuous duty cycle
+
+// Phase 8: L293D thermal model (I²t estimate per motor channel)
+// Each tick: heat += duty²/256, heat -= heat >> THERMAL_TAU_SHIFT
+// Equilibrium heat for a steady duty D is (D²/256) << THERMAL_TAU_SHIFT
+// Time constant = 2^THERMAL_TAU_SHIFT ticks (256 ticks = ~2.6s at 100 Hz)
+#define THERMAL_TAU_SHIFT          8     // Must stay <= 8 (uint16_t heat)
+#define THERMAL_HEAT_AT_DUTY(d)    ((uint16_t)((((uint16_t)(d) * (uint16_t)(d)) >> 8) << THERMAL_TAU_SHIFT))
+
+// Derating: limit falls linearly from 255 to the floor between the START
+// and END heat levels (expressed as equivalent steady duty). Full demand
+// settles where the limit equals the duty that makes that heat: ~202 here
+#define THERMAL_DERATE_START_DUTY  180   // Start derating at 71%-duty equilibrium
+#define THERMAL_DERATE_END_DUTY    230   // Fully derated at 90%-duty equilibrium
+#define THERMAL_DUTY_FLOOR         127   // Never derate below 50% duty
+
+// Boost: 100% duty through the derate band for a limited window, once per
+// cool-down (ends early at the END heat level)
+#define THERMAL_BOOST_ENTRY_DUTY   160   // Boost re-arms below 63%-duty equilibrium
+#define THERMAL_BOOST_MS          3000   // Boost window length (3 seconds)
+
+#if THERMAL_TAU_SHIFT > 8
+#error "THERMAL_TAU_SHIFT > 8 overflows the 16-bit heat estimate"
+#endif
+
+// Phase 8: Per-motor compensation (applied after mixing, see motor_comp.h)
+// duty = deadzone + |command| * gain * (255 - deadzone) / 255
+// DEADZONE: breakaway duty per motor and direction (PWM counts), defaults
+//   reproduce the old flat +30 front boost at low command; overridden by
+//   values from a calibration sweep stored in EEPROM
+// GAIN: per-motor, per-direction trim (1.0 = unchanged, max 3.9)
+#define MOTOR_COMP_DEADZONE_RL_FWD   0
+#define MOTOR_COMP_DEADZONE_RL_REV   0
+#define MOTOR_COMP_DEADZONE_RR_FWD   0
+#define MOTOR_COMP_DEADZONE_RR_REV   0
+#define MOTOR_COMP_DEADZONE_FL_FWD  30
+#define MOTOR_COMP_DEADZONE_FL_REV  30
+#define MOTOR_COMP_DEADZONE_FR_FWD  30
+#define MOTOR_COMP_DEADZONE_FR_REV  30
+
+#define MOTOR_COMP_GAIN_RL_FWD     1.0f
+#define MOTOR_COMP_GAIN_RL_REV     1.0f
+#define MOTOR_COMP_GAIN_RR_FWD     1.0f
+#define MOTOR_COMP_GAIN_RR_REV     1.0f
+#define MOTOR_COMP_GAIN_FL_FWD     1.0f
+#define MOTOR_COMP_GAIN_FL_REV     1.0f
+#define MOTOR_COMP_GAIN_FR_FWD     1.0f
+#define MOTOR_COMP_GAIN_FR_REV     1.0f
+
+// Optional per-motor nonlinearity (curves.h description macros, applied to
+// |command| before the deadzone/gain map). 0 skips the lookup entirely.
+#define MOTOR_COMP_CURVES_ENABLED  0
+#define MOTOR_COMP_CURVE_RL        CURVE_POINTS5(0, 25, 50, 75, 100)
+#define MOTOR_COMP_CURVE_RR        CURVE_POINTS5(0, 25, 50, 75, 100)
+#define MOTOR_COMP_CURVE_FL        CURVE_POINTS5(0, 25, 50, 75, 100)
+#define MOTOR_COMP_CURVE_FR        CURVE_POINTS5(0, 25, 50, 75, 100)
+
+// Calibration sweep (build with MOTOR_COMP_CALIBRATION 1, bot on blocks)
+// Each motor/direction ramps up from 0; push the pitch stick fully forward
+// the moment the wheel starts turning. Results are saved to EEPROM.
+#ifndef MOTOR_COMP_CALIBRATION
+#define MOTOR_COMP_CALIBRATION       0
+#endif
+#define MOTOR_COMP_CAL_RAMP_TICKS    4     // 1 count per 40ms (~25 counts/s)
+#define MOTOR_COMP_CAL_MAX_DUTY    128     // Give up (keep default) above this
+#define MOTOR_COMP_CAL_REACTION      5     // Counts subtracted for reaction time
+#define MOTOR_COMP_CAL_REST_MS     750     // Pause between sweeps
+#define MOTOR_COMP_CAL_MARK_RAW   1600     // Pitch stick raw value that marks breakaway
 
 // Phase 3: Motor polarity inversion flags
 // Set to true to invert a motor's direction (corrects wiring polarity)
@@ -95,8 +208,41 @@
 // WEAPON ESC CONSTANTS
 // ============================================================================
 
-// Weapon ESC PWM timing (standard servo timing, 50 Hz)
-#define WEAPON_ESC_FREQ_HZ    50    // 50 Hz PWM for ESC
+// Phase 8: Timer1 pulse rate shared by the weapon ESC and servo (pulse_out.cpp)
+// 50 Hz suits any servo; ESCs and digital servos accept up to ~400 Hz
+#define PULSE_OUT_HZ          50
+
+// Phase 8: Weapon ESC signal protocol
+//   ESC_PROTOCOL_PWM        - 1000-2000us pulses at PULSE_OUT_HZ (any ESC)
+//   ESC_PROTOCOL_ONESHOT125 - 125-250us pulses, 62.5ns resolution
+//   ESC_PROTOCOL_MULTISHOT  - 5-25us pulses, 62.5ns resolution
+//   ESC_PROTOCOL_DSHOT150   - digital frames with CRC (dshot.cpp)
+//   ESC_PROTOCOL_DSHOT300   - digital frames with CRC, half the masked time
+// The fast protocols run Timer1 at PULSE_FAST_HZ and start a new frame as
+// soon as the control loop writes a value; the servo keeps PULSE_OUT_HZ.
+// Only select them for an ESC that supports the protocol.
+#define ESC_PROTOCOL_PWM         0
+#define ESC_PROTOCOL_ONESHOT125  1
+#define ESC_PROTOCOL_MULTISHOT   2
+#define ESC_PROTOCOL_DSHOT150    3
+#define ESC_PROTOCOL_DSHOT300    4
+#ifndef WEAPON_ESC_PROTOCOL
+#define WEAPON_ESC_PROTOCOL      ESC_PROTOCOL_PWM
+#endif
+#define PULSE_FAST_HZ          400   // Timer1 frame rate for the fast protocols
+#define WEAPON_ESC_DSHOT       (WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_DSHOT150 || \
+                                WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_DSHOT300)
+
+// DShot: one 16-bit frame per control tick, bit-banged with interrupts
+// masked for the whole frame (DShot300 ~54us, DShot150 ~107us per tick).
+// Lost-robot beacon: disarmed with the link lost for BEACON_DELAY, the ESC
+// beeps (DShot beacon command 1-5) every BEACON_INTERVAL
+#define DSHOT_BEACON_DELAY_MS    5000
+#define DSHOT_BEACON_INTERVAL_MS 1000
+#define DSHOT_BEACON_TONE        1
+
+// Weapon ESC pulse timing (standard servo timing)
+// Throttle is always expressed in these units; the fast protocols scale it
 #define WEAPON_ESC_MIN_US   1000    // Minimum pulse width (stopped)
 #define WEAPON_ESC_MAX_US   2000    // Maximum pulse width (full throttle)
 #define WEAPON_ESC_NEUTRAL_US 1500  // Neutral/idle (for calibration)
@@ -105,8 +251,7 @@
 // SERVO CONSTANTS
 // ============================================================================
 
-// Self-righting servo timing (standard servo, 50 Hz)
-#define SERVO_FREQ_HZ        50     // 50 Hz PWM
+// Self-righting servo timing (standard servo, PULSE_OUT_HZ)
 #define SERVO_MIN_US        544     // Minimum pulse width (0 degrees)
 #define SERVO_MAX_US       2400     // Maximum pulse width (180 degrees)
 #define SERVO_NEUTRAL_US   1500     // Neutral position (90 degrees)
@@ -124,19 +269,70 @@
 #define SAFE_WEAPON_US     WEAPON_ESC_MIN_US  // Weapon at minimum throttle
 #define SAFE_SERVO_US      SERVO_NEUTRAL_US   // Servo at neutral position
 
+// Phase 8: Fast kill path (crsf_uart.cpp)
+// The UART receive interrupt checks every RC channels frame as it arrives
+// (CRC included) and stops all outputs when channel 3 (kill) is asserted,
+// without waiting for the next control tick. The frame check itself always
+// runs: its frame times give the link timeout (LINK_TIMEOUT_MS)
+#define KILL_FAST_PATH_ENABLED   1
+#define KILL_RAW_THRESHOLD     992   // Raw CH3 below this = kill (1500us in input.cpp)
+
 // Phase 5: Arming state machine constants
 #define SWITCH_DEBOUNCE_MS       10     // Switch debounce time (10ms)
 #define ARM_THROTTLE_THRESHOLD   0.03f  // Maximum throttle to allow arming (3%)
 #define REARM_THROTTLE_THRESHOLD 0.10f  // Throttle must drop below this to re-arm (10%)
 
 // Phase 5: Weapon ramping (slower than drive motors for safety)
-#define WEAPON_SLEW_RATE_MAX     10     // 10 units/tick = ~2 seconds 0-100%
+// Phase 8: S-curve in real time. Spin-up and spin-down times (full range)
+// are per drive profile (<MODE>_WEAPON_SPINUP_MS / _SPINDOWN_MS); the ramp
+// advances in fixed WEAPON_RAMP_STEP_MS steps of elapsed time, so it does
+// not depend on the control loop rate or on late ticks. Spin-down is never
+// faster than spin-up: braking a spinning weapon pushes its energy back
+// into the ESC and pack, and twists the chassis the other way
+#define WEAPON_RAMP_STEP_MS      5      // Ramp time step
+#define WEAPON_RAMP_MAX_STEPS    8      // Steps caught up per tick at most
+#define WEAPON_RAMP_JERK_MS    150      // Time to build up to the full ramp rate
+                                        // (rounded corners add up to this much
+                                        // to the nominal ramp times)
+
+// Low battery: spin up more gently so the pack is not pulled down further
+// (battery percentage from the telemetry monitor; 100 = no change)
+#define WEAPON_LOWBAT_PCT       20      // Below this battery % ...
+#define WEAPON_LOWBAT_RAMP_PCT 150      // ... spin-up time is 150%
 
 // Phase 6: Self-righting servo constants
-#define SERVO_SLEW_RATE_MAX      5      // 5 us/tick = ~400ms neutral→endpoint
+#define SERVO_SLEW_RATE_MAX      5      // Return to neutral when idle: 5 us/tick
 #define SERVO_ENDPOINT_RETRACT  700     // Retracted position (microseconds)
 #define SERVO_ENDPOINT_EXTEND  2300     // Extended position (microseconds)
 
+// Phase 8: Self-righting sequences (servo.cpp), stored in flash
+// CH7 going high starts SELFRIGHT_SEQUENCE; it plays to the end even if CH7
+// is released, then replays from its _REPEAT keyframe while CH7 stays high.
+// Kill or link loss aborts it at once (servo back to neutral, kick off).
+// Keyframe: { servo_us, move_ms, hold_ms, kick_pct }
+//   move_ms  - time to travel in a straight line from the previous keyframe
+//   hold_ms  - time to stay there
+//   kick_pct - drive pulse through the mixer for the whole keyframe
+//              (% of full forward; negative = reverse, 0 = none)
+#define SELFRIGHT_PUSH_FRAMES { \
+  { SERVO_ENDPOINT_EXTEND, 1600,   0,  0 }, /* Slow push (pre-sequencer behaviour) */ \
+  { SERVO_ENDPOINT_EXTEND,    0, 100,  0 }  /* Hold while CH7 is high */ \
+}
+#define SELFRIGHT_PUSH_REPEAT   1
+
+#define SELFRIGHT_FLICK_FRAMES { \
+  { SERVO_ENDPOINT_EXTEND,   80, 150,  0 }, /* Flick */ \
+  { SERVO_NEUTRAL_US,       200, 100,  0 }, /* Retract */ \
+  { SERVO_ENDPOINT_EXTEND,   80, 150, 60 }, /* Flick with a drive kick */ \
+  { SERVO_NEUTRAL_US,       200, 100,  0 }  /* Retract */ \
+}
+#define SELFRIGHT_FLICK_REPEAT  2
+
+#ifndef SELFRIGHT_SEQUENCE
+#define SELFRIGHT_SEQUENCE      FLICK   // PUSH or FLICK
+#endif
+#define SELFRIGHT_MAX_MS       5000     // Stop repeating after this long (servo/battery)
+
 // ============================================================================
 // LED DIAGNOSTIC TIMING
 // ============================================================================
@@ -184,21 +380,334 @@
 // HOLONOMIC MIXING CONSTANTS (Phase 4)
 // ============================================================================
 
-// Drive mode parameters
+// Drive mode parameters (compiled defaults for the drive profiles below)
 // Beginner mode: 50% max duty, gentle control
 #define BEGINNER_MAX_DUTY      127  // 50% of 255
-#define BEGINNER_EXPO          0.3f // Light exponential curve
+#define BEGINNER_ROTATION_PCT  100  // Rotation sensitivity (% of full)
+#define BEGINNER_WEAPON_SPINUP_MS   1000 // Weapon 0-100% ramp time
+#define BEGINNER_WEAPON_SPINDOWN_MS 1000 // Weapon 100-0% ramp time
+#define BEGINNER_STOP_BRAKE    255  // Wheels at zero: 0 = coast, else brake duty
 
 // Normal mode: 80% max duty (same as thermal clamp), balanced control
 #define NORMAL_MAX_DUTY        204  // 80% of 255 (same as MOTOR_DUTY_CLAMP_MAX)
-#define NORMAL_EXPO            0.2f // Moderate exponential curve
+#define NORMAL_ROTATION_PCT    100
+#define NORMAL_WEAPON_SPINUP_MS     1000
+#define NORMAL_WEAPON_SPINDOWN_MS   1000
+#define NORMAL_STOP_BRAKE      255
 
-// Aggressive mode: 100% max duty (still respects thermal clamp), responsive control
+// Aggressive mode: 100% max duty (still respects thermal model), responsive control
 #define AGGRESSIVE_MAX_DUTY    255  // 100% of 255
-#define AGGRESSIVE_EXPO        0.1f // Minimal exponential curve
+#define AGGRESSIVE_ROTATION_PCT 100
+#define AGGRESSIVE_WEAPON_SPINUP_MS 1000
+#define AGGRESSIVE_WEAPON_SPINDOWN_MS 1000
+#define AGGRESSIVE_STOP_BRAKE  0    // Coast: keeps momentum between moves
+
+// Phase 8: Mixing arithmetic (compile-time selection)
+// 1 = Q12 integer pipeline (no soft-float in the control loop)
+// 0 = float reference back end (matrix and normalization in float)
+// Stick normalization, curves and motion shaping are shared by both;
+// the back ends produce motor commands within one PWM count of each other
+#ifndef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT     1
+#endif
+
+// Phase 8: Desaturation strategy per drive mode (see DesatStrategy in mixing.h)
+// Applies to the integer pipeline; the float reference pipeline is always uniform
+#define BEGINNER_DESAT         DESAT_UNIFORM
+#define NORMAL_DESAT           DESAT_UNIFORM
+#define AGGRESSIVE_DESAT       DESAT_YAW_PRIORITY  // Keep turning authority at full throttle
+
+// Phase 8: Chassis geometry (mixer coefficient matrix, see mixer_presets.h)
+#define MIXER_LAYOUT_MECANUM_X  0   // 4 mecanum wheels, X rollers (default)
+#define MIXER_LAYOUT_OMNI_X     1   // 4 omni wheels on the corners at 45 degrees
+#define MIXER_LAYOUT_TANK       2   // 4-wheel skid steer, no strafe
+#define MIXER_LAYOUT_KIWI       3   // 3 omni wheels at 120 degrees (FR unused)
+#define MIXER_LAYOUT           MIXER_LAYOUT_MECANUM_X
+
+// Phase 8: Stick-to-chassis mixing strategy per drive mode (mixer_policies.h)
+#define MIXER_POLICY_HOLONOMIC    0   // Right stick translates, left stick rotates
+#define MIXER_POLICY_TANK_STRAFE  1   // Left/right stick Y drive the left/right wheels,
+                                      // left stick X strafes (needs left stick Y on CH9)
+#define MIXER_POLICY_ARCADE       2   // Right stick drives + turns, no strafe
+// Using the same policy for every mode compiles a single pipeline with a
+// direct call; mixing policies per mode costs one indirect call per tick
+#define BEGINNER_MIXER         MIXER_POLICY_HOLONOMIC
+#define NORMAL_MIXER           MIXER_POLICY_HOLONOMIC
+#define AGGRESSIVE_MIXER       MIXER_POLICY_HOLONOMIC
+
+// Per-motor output scaling applied after the matrix (1.0 = unchanged)
+#define MIXER_SCALE_RL         1.0f
+#define MIXER_SCALE_RR         1.0f
+#define MIXER_SCALE_FL         1.0f
+#define MIXER_SCALE_FR         1.0f
+
+// Phase 8: Stick response curve library (17-point PROGMEM tables, see curves.h)
+// Drive profiles pick a curve per axis by ID. Available descriptions:
+//   CURVE_EXPO(expo, scale)             - scale * (expo*u^3 + (1-expo)*u)
+//   CURVE_POINTS5(p0, p25, p50, p75, p100) - output % at 0/25/50/75/100% stick
+// Rotation sensitivity is the profile's ROTATION_PCT, not a curve scale
+#define CURVE_ID_LINEAR        0
+#define CURVE_ID_EXPO10        1
+#define CURVE_ID_EXPO20        2
+#define CURVE_ID_EXPO30        3
+#define CURVE_ID_EXPO50        4
+#define CURVE_ID_CUSTOM        5
+#define CURVE_COUNT            6
+
+#define CURVE_LIB_LINEAR       CURVE_EXPO(0.0f, 1.0f)
+#define CURVE_LIB_EXPO10       CURVE_EXPO(0.1f, 1.0f)
+#define CURVE_LIB_EXPO20       CURVE_EXPO(0.2f, 1.0f)
+#define CURVE_LIB_EXPO30       CURVE_EXPO(0.3f, 1.0f)
+#define CURVE_LIB_EXPO50       CURVE_EXPO(0.5f, 1.0f)
+#define CURVE_LIB_CUSTOM       CURVE_POINTS5(0, 15, 35, 60, 100)
+
+// Default curve per drive mode and axis
+#define BEGINNER_CURVE_X       CURVE_ID_EXPO30
+#define BEGINNER_CURVE_Y       CURVE_ID_EXPO30
+#define BEGINNER_CURVE_R       CURVE_ID_EXPO30
+
+#define NORMAL_CURVE_X         CURVE_ID_EXPO20
+#define NORMAL_CURVE_Y         CURVE_ID_EXPO20
+#define NORMAL_CURVE_R         CURVE_ID_EXPO20
+
+#define AGGRESSIVE_CURVE_X     CURVE_ID_EXPO10
+#define AGGRESSIVE_CURVE_Y     CURVE_ID_EXPO10
+#define AGGRESSIVE_CURVE_R     CURVE_ID_EXPO10
+
+// Phase 8: Chassis motion shaping (per drive mode and axis, before mixing)
+// Limits act on the commanded chassis velocity (X strafe, Y forward,
+// R rotation) so all wheels ramp together and the direction of travel
+// matches the stick. ACCEL = ms from stop to full command, DECEL = ms from
+// full command to stop (keep shorter than ACCEL), JERK = ms to build up to
+// the full accel/decel rate (rounds the ramp corners). 0 = unlimited.
+#define BEGINNER_ACCEL_MS_X    400
+#define BEGINNER_ACCEL_MS_Y    400
+#define BEGINNER_ACCEL_MS_R    300
+#define BEGINNER_DECEL_MS_X    200
+#define BEGINNER_DECEL_MS_Y    200
+#define BEGINNER_DECEL_MS_R    150
+#define BEGINNER_JERK_MS       100
+
+#define NORMAL_ACCEL_MS_X      250
+#define NORMAL_ACCEL_MS_Y      250
+#define NORMAL_ACCEL_MS_R      200
+#define NORMAL_DECEL_MS_X      120
+#define NORMAL_DECEL_MS_Y      120
+#define NORMAL_DECEL_MS_R      100
+#define NORMAL_JERK_MS          60
+
+#define AGGRESSIVE_ACCEL_MS_X  150
+#define AGGRESSIVE_ACCEL_MS_Y  150
+#define AGGRESSIVE_ACCEL_MS_R  120
+#define AGGRESSIVE_DECEL_MS_X   80
+#define AGGRESSIVE_DECEL_MS_Y   80
+#define AGGRESSIVE_DECEL_MS_R   60
+#define AGGRESSIVE_JERK_MS      40
+
+// ============================================================================
+// DRIVE PROFILES (Phase 8)
+// ============================================================================
+
+// Named parameter sets (max duty, curves, rotation scale, motion shaping,
+// weapon spin-up/down, stop brake) stored in EEPROM and loaded into RAM once at boot. Each
+// drive mode switch position runs the profile mapped to it; the map and
+// the profiles fall back to the compiled defaults below if EEPROM is blank
+// or corrupt. Desaturation and mixer policy stay per drive mode.
+#define PROFILE_COUNT          4     // Profiles in the store
+#define PROFILE_NAME_LEN      12     // Name bytes including terminator
+
+// Default profiles 0-2 are the BEGINNER/NORMAL/AGGRESSIVE settings above
+#define BEGINNER_PROFILE_NAME   "Beginner"
+#define NORMAL_PROFILE_NAME     "Normal"
+#define AGGRESSIVE_PROFILE_NAME "Aggressive"
+
+// Profile 3: pusher - full power, soft rotation, long ramps for traction
+#define PUSHER_PROFILE_NAME    "Pusher"
+#define PUSHER_MAX_DUTY        255
+#define PUSHER_ROTATION_PCT    60
+#define PUSHER_WEAPON_SPINUP_MS 1500
+#define PUSHER_WEAPON_SPINDOWN_MS 1500
+#define PUSHER_STOP_BRAKE      255
+#define PUSHER_CURVE_X         CURVE_ID_EXPO30
+#define PUSHER_CURVE_Y         CURVE_ID_LINEAR
+#define PUSHER_CURVE_R         CURVE_ID_EXPO50
+#define PUSHER_ACCEL_MS_X      300
+#define PUSHER_ACCEL_MS_Y      350
+#define PUSHER_ACCEL_MS_R      250
+#define PUSHER_DECEL_MS_X      150
+#define PUSHER_DECEL_MS_Y      150
+#define PUSHER_DECEL_MS_R      100
+#define PUSHER_JERK_MS          80
+
+// Profile selection while the kill switch is active: hold the yaw stick
+// fully right to step the current switch position to the next profile
+#define PROFILE_SELECT_RAW     1700  // Yaw raw value that counts as "held"
+#define PROFILE_SELECT_HOLD_MS 1000  // Hold time per step
+
+// ============================================================================
+// GYRO / YAW-RATE CONTROL (Phase 8)
+// ============================================================================
+
+// Gyro source (see gyro.h)
+#define GYRO_BACKEND_NONE      0   // No gyro - yaw stays open loop
+#define GYRO_BACKEND_MPU6050   1   // MPU-6050 IMU on I2C
+#define GYRO_BACKEND_SIM       2   // Simulated chassis (bench testing, wheels off ground)
+#ifndef GYRO_BACKEND
+#define GYRO_BACKEND           GYRO_BACKEND_NONE
+#endif
+
+// Full stick yaw commands this rate; gyro readings are scaled to the same
+// Q12 range so the controller compares like with like
+#define YAW_RATE_MAX_DPS       720   // deg/s at full yaw stick
+#define GYRO_YAW_INVERTED      true  // true if the sensor Z axis points up (CCW positive)
+#define GYRO_BIAS_SAMPLES      64    // Samples averaged at boot for zero-rate bias (keep still)
+
+// Fixed-point PI controller trimming the mixer's rotation term
+// rotation = command + Kp * error + integral(Ki * error)
+#define YAW_KP                 0.8f  // Proportional gain
+#define YAW_KI                 0.05f // Integral gain per tick
+#define YAW_I_LIMIT            0.5f  // Integral clamp (fraction of full rotation)
+
+// Simulated chassis (GYRO_BACKEND_SIM): first-order yaw response to the
+// wheel commands, plus a constant drift and a periodic hit
+#define GYRO_SIM_TAU_SHIFT     3     // Response time constant = 2^3 ticks (~80ms)
+#define GYRO_SIM_DRIFT         0.1f  // Constant disturbance (fraction of full rate)
+#define GYRO_SIM_HIT           0.6f  // Hit impulse (fraction of full rate)
+#define GYRO_SIM_HIT_PERIOD_MS 3000  // Time between hits
+
+// ============================================================================
+// WHEEL ENCODERS / SPEED CONTROL (Phase 8)
+// ============================================================================
+
+// Encoder source (see encoders.h)
+#define ENCODER_BACKEND_NONE   0   // No encoders - wheels stay open loop
+#define ENCODER_BACKEND_HW     1   // Encoders on the PIN_ENCODER_* pins
+#define ENCODER_BACKEND_SIM    2   // Simulated wheels (bench testing)
+#ifndef ENCODER_BACKEND
+#define ENCODER_BACKEND        ENCODER_BACKEND_NONE
+#endif
+
+// Speed estimation: count edges per tick at speed, time between edges when slow
+#define ENCODER_MAX_EPS        1500  // Edges/s of a free wheel at full duty
+#define ENCODER_COUNT_MIN      8     // Edges per tick needed to use the count method
+#define ENCODER_TIMEOUT_MS     100   // No edge for this long = stopped
+
+// Per-wheel PI speed loop (PWM counts out, speed error scaled to PWM counts)
+// output = command + Kp * error + integral(Ki * error)
+#define SPEED_KP               0.5f  // Proportional gain
+#define SPEED_KI               0.05f // Integral gain per tick
+#define SPEED_I_LIMIT          60    // Integral clamp (PWM counts)
+
+// Slip: wheel faster than commanded by this margin (lost traction / airborne)
+// Its integral is frozen and output pulled back to the feed-forward command
+#define SPEED_SLIP_RATIO       0.3f  // Overspeed as a fraction of the target
+#define SPEED_SLIP_MIN_EPS     150   // Minimum overspeed before flagging slip
+
+// Simulated wheels (ENCODER_BACKEND_SIM): first-order response with the
+// front/rear friction mismatch the old FRONT_MOTOR_BOOST papered over
+#define ENCODER_SIM_TAU_SHIFT      2     // Wheel time constant = 2^2 ticks
+#define ENCODER_SIM_DEADZONE_FRONT 30    // Front wheel breakaway duty
+#define ENCODER_SIM_DEADZONE_REAR  10    // Rear wheel breakaway duty
+#define ENCODER_SIM_SLIP_PERIOD_MS 4000  // Every period one wheel loses traction...
+#define ENCODER_SIM_SLIP_MS        300   // ...for this long, spinning at double speed
 
-// Axis scaling (reduce rotation sensitivity relative to translation)
-#define ROTATION_SCALE         0.7f  // 70% rotation sensitivity
+// ============================================================================
+// WEAPON RPM / GOVERNOR (Phase 8)
+// ============================================================================
+
+// RPM source (see weapon_rpm.h)
+#define WEAPON_RPM_BACKEND_NONE  0   // No sensor - weapon stays open loop
+#define WEAPON_RPM_BACKEND_TACH  1   // Tach pulses on PIN_WEAPON_TACH
+#define WEAPON_RPM_BACKEND_SIM   2   // Simulated weapon (bench testing, no blade)
+#ifndef WEAPON_RPM_BACKEND
+#define WEAPON_RPM_BACKEND       WEAPON_RPM_BACKEND_NONE
+#endif
+
+#define WEAPON_TACH_PULSES_PER_REV  2     // Magnets on the weapon (pulses per revolution)
+#define WEAPON_RPM_TIMEOUT_MS     100     // No pulse for this long = stopped
+#define WEAPON_RPM_MAX          12000     // Weapon RPM at full throttle on a full pack
+
+// Governor: the slider sets a target RPM (fraction of WEAPON_RPM_MAX)
+// instead of a throttle; a fixed-point PI loop trims the throttle around
+// the open-loop value to hold it through battery sag and hits
+// throttle = ramped target + Kp * error + integral(Ki * error)
+#ifndef WEAPON_GOVERNOR_ENABLED
+#define WEAPON_GOVERNOR_ENABLED  (WEAPON_RPM_BACKEND != WEAPON_RPM_BACKEND_NONE)
+#endif
+#define WEAPON_GOV_KP            0.8f   // Proportional gain
+#define WEAPON_GOV_KI            0.05f  // Integral gain per tick
+#define WEAPON_GOV_AUTHORITY     0.3f   // Correction limit (fraction of full throttle)
+#define WEAPON_GOV_FAULT_PCT     25     // Open-loop throttle above this % ...
+#define WEAPON_GOV_FAULT_MS     300     // ... with no RPM for this long = sensor fault
+
+// Impact log: a drop of this much below the settled RPM starts an impact,
+// recovery ends it once the RPM is back within WEAPON_IMPACT_RECOVER_PCT
+#define WEAPON_IMPACT_DROP_PCT     15
+#define WEAPON_IMPACT_RECOVER_PCT   5
+#define WEAPON_IMPACT_MIN_RPM    1000    // Ignore drops below this speed
+#define WEAPON_IMPACT_TIMEOUT_MS 3000    // Not recovered by then = not logged
+
+// Simulated weapon (WEAPON_RPM_BACKEND_SIM): first-order spin-up to the
+// throttle, free speed falling with the battery, and a periodic hit
+#define WEAPON_SIM_TAU_SHIFT       5     // Time constant = 2^5 ticks (~320ms)
+#define WEAPON_SIM_SAG_PCT        80     // Free speed at 0% battery (% of full)
+#define WEAPON_SIM_HIT_PCT        40     // Speed lost per hit (%)
+#define WEAPON_SIM_HIT_PERIOD_MS 4000    // Time between hits
+
+// ============================================================================
+// ERROR HISTORY (Phase 8)
+// ============================================================================
+
+// Every error event (not just the first) is logged with its time, loop
+// stage and a context word, buffered in RAM and written to EEPROM from
+// idle time only (see error_log.h)
+#define ERROR_LOG_RAM_EVENTS       8     // Events waiting for idle time (power of 2)
+#define ERROR_LOG_REPEAT_MS     1000     // Same error again within this = counted, not logged
+
+// Dump over telemetry while the kill switch is active: hold the yaw stick
+// fully left and the flight mode shows the stored events one at a time
+#define ERROR_LOG_DUMP_RAW       284     // Yaw raw value that counts as "held"
+#define ERROR_LOG_DUMP_HOLD_MS  2000     // Hold time to start a dump
+#define ERROR_LOG_DUMP_MS        500     // Time each event is shown
+
+// ============================================================================
+// BLACK-BOX RECORDER (Phase 8)
+// ============================================================================
+
+// Every control loop tick goes into a RAM ring: the 8 raw channels, four
+// motor outputs, weapon_us, servo_us, arm state and loop duration. Blocks
+// start with a full keyframe; each later tick is coded bit-packed as the
+// change from the tick before (unchanged field = 1 bit, unchanged tick = 1 bit).
+// A failsafe or a latched error freezes the ring BLACKBOX_POST_TRIGGER_MS later.
+#ifndef BLACKBOX_ENABLED
+#define BLACKBOX_ENABLED           1
+#endif
+#define BLACKBOX_BUFFER_BYTES    384     // Ring size (oldest blocks dropped first)
+#define BLACKBOX_BLOCK_FRAMES     64     // Ticks per block (keyframe interval)
+#define BLACKBOX_CHANNEL_SHIFT     2     // Raw channels stored in 4-count (~2.5us) steps
+#define BLACKBOX_LOOP_SHIFT        6     // Loop duration stored in 64us units
+#define BLACKBOX_POST_TRIGGER_MS 500     // Keep recording this long after a trigger
+
+// Dump while the kill switch is active: hold the roll stick fully left;
+// the ring goes out as CRSF frames on the receiver UART (decode with
+// tools/blackbox_decode.py), then recording starts over
+#define BLACKBOX_DUMP_RAW        284     // Roll raw value that counts as "held"
+#define BLACKBOX_DUMP_HOLD_MS   2000     // Hold time to start a dump
+#define BLACKBOX_DUMP_FRAME_MS    20     // Time between dump frames
+
+// ============================================================================
+// EEPROM LAYOUT (ATmega328P: 1024 bytes)
+// ============================================================================
+
+// Phase 8: Fixed record addresses (each record carries its own version/check)
+#define EEPROM_ADDR_MOTOR_COMP     0     // Motor compensation (16 bytes reserved)
+#define EEPROM_SIZE_MOTOR_COMP    16
+#define EEPROM_ADDR_PROFILE_MAP   16     // Drive mode -> profile map (2 wear slots)
+#define EEPROM_SIZE_PROFILE_MAP   16
+#define EEPROM_ADDR_PROFILES      64     // Drive profiles (2 wear slots each)
+#define EEPROM_SIZE_PROFILES     448
+#define EEPROM_ADDR_ERROR_LOG    512     // Error history (ring of records, written in turn)
+#define EEPROM_SIZE_ERROR_LOG    512
 
 // ============================================================================
 // MEMORY BUDGET TRACKING
@@ -212,4 +721,14 @@
 #define PHASE5_RAM_BUDGET_BYTES 1536   // Phase 5-6: 75% of 2KB
 #define PHASE7_RAM_BUDGET_BYTES 1800   // Phase 7: 87.5% of 2KB (10% margin)
 
+// Phase 8: Stack high-water mark
+// Free RAM is painted with STACK_CANARY before main(); idle time scans it
+// for the deepest stack excursion. Worst-case use (static data + heap +
+// deepest stack) above RAM_BUDGET_BYTES is logged as ERR_RAM_BUDGET.
+#define STACK_CANARY            0xC5  // Paint byte (unlikely as stack data)
+#define STACK_SCAN_CHUNK          32  // Bytes checked per idle call
+#ifndef RAM_BUDGET_BYTES
+#define RAM_BUDGET_BYTES  PHASE7_RAM_BUDGET_BYTES
+#endif
+
 #endif // CONFIG_H
@@ -0,0 +1,60 @@
+// crsf_uart.h - Interrupt-driven CRSF UART with a fast kill path
+// UpVote Battlebot - Phase 8
+#ifndef CRSF_UART_H
+#define CRSF_UART_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// CRSF UART STREAM
+// ============================================================================
+
+// USART0 driver handed to AlfredoCRSF in place of Serial (which would own
+// the same interrupt vectors). Besides buffering bytes for the library,
+// the receive interrupt validates RC channels frames itself and calls
+// actuators_emergency_stop() the moment one arrives with the kill asserted
+class CrsfUart : public Stream {
+public:
+  void begin(unsigned long baud);
+
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t byte);
+  using Print::write;
+  void flush();
+};
+
+// Global instance (defined in crsf_uart.cpp)
+extern CrsfUart CrsfSerial;
+
+// ============================================================================
+// RC FRAME SCANNER AND FAST KILL PATH
+// ============================================================================
+
+// Check if a valid RC channels frame arrived within LINK_TIMEOUT_MS
+// Timed with timebase_millis() (the library's own link check uses the
+// core's millis(), which runs fast at motor PWM prescalers below 64)
+bool crsf_uart_link_up();
+
+// Kill state of the newest valid RC frame seen by the receive interrupt
+// Lets the control loop release the output lock only once the kill is off
+bool crsf_uart_kill_active();
+
+// Worst kill latency seen since boot (microseconds)
+// Always 0 with KILL_FAST_PATH_ENABLED off
+// From the end of the kill frame's last byte on the wire to all outputs
+// written safe (includes interrupt entry delay; 0 = no kill seen yet)
+// input_update() logs each new worst case as ERR_KILL_LATENCY
+uint16_t crsf_uart_get_kill_latency_us();
+
+// RC channels frames dropped for a bad CRC since boot (wraps)
+uint16_t crsf_uart_get_crc_errors();
+
+#ifdef PIO_UNIT_TESTING
+// Handle one byte as the receive interrupt does: library buffer, then the
+// frame scanner (on-target tests only; call with interrupts masked)
+void crsf_uart_receive(uint8_t byte);
+#endif
+
+#endif // CRSF_UART_H
@@ -0,0 +1,72 @@
+// curves.h - Stick response curve lookup tables (PROGMEM)
+// UpVote Battlebot - Phase 8
+#ifndef CURVES_H
+#define CURVES_H
+
+#include <Arduino.h>
+#include "utilities.h"
+
+// ============================================================================
+// CURVE TABLE FORMAT
+// ============================================================================
+
+// Each curve is CURVE_POINTS Q12 outputs sampled at evenly spaced input
+// magnitudes 0, 1/16, ... 16/16 of full stick. Curves are odd-symmetric:
+// the sign of the input is applied to the looked-up magnitude.
+#define CURVE_POINTS      17
+#define CURVE_STEP_SHIFT   8   // 4096 / 16 = 256 Q12 units between points
+
+// Stick axes with their own curve per drive profile
+enum CurveAxis {
+  CURVE_AXIS_X = 0,   // Strafe (roll stick)
+  CURVE_AXIS_Y = 1,   // Forward/back (pitch stick)
+  CURVE_AXIS_R = 2    // Rotation (yaw stick)
+};
+
+// ============================================================================
+// CURVE DESCRIPTION MACROS (expanded at compile time into table initializers)
+// ============================================================================
+
+// Normalized input of table point i
+#define CURVE_U(i)  ((i) / 16.0f)
+
+// Expo curve scaled by s: s * (e*u^3 + (1-e)*u)
+#define CURVE_EXPO_PT(e, s, i) \
+  Q12_FROM_FLOAT((s) * ((e) * CURVE_U(i) * CURVE_U(i) * CURVE_U(i) + (1.0f - (e)) * CURVE_U(i)))
+
+#define CURVE_EXPO(e, s) \
+  CURVE_EXPO_PT(e, s, 0),  CURVE_EXPO_PT(e, s, 1),  CURVE_EXPO_PT(e, s, 2),  \
+  CURVE_EXPO_PT(e, s, 3),  CURVE_EXPO_PT(e, s, 4),  CURVE_EXPO_PT(e, s, 5),  \
+  CURVE_EXPO_PT(e, s, 6),  CURVE_EXPO_PT(e, s, 7),  CURVE_EXPO_PT(e, s, 8),  \
+  CURVE_EXPO_PT(e, s, 9),  CURVE_EXPO_PT(e, s, 10), CURVE_EXPO_PT(e, s, 11), \
+  CURVE_EXPO_PT(e, s, 12), CURVE_EXPO_PT(e, s, 13), CURVE_EXPO_PT(e, s, 14), \
+  CURVE_EXPO_PT(e, s, 15), CURVE_EXPO_PT(e, s, 16)
+
+// Custom 5-point curve: output percent at 0/25/50/75/100% stick,
+// linearly interpolated into the 17-point table
+#define CURVE_PCT(p)           Q12_FROM_FLOAT((p) / 100.0f)
+#define CURVE_LERP_PCT(a, b, t) CURVE_PCT((a) + ((b) - (a)) * (t))
+
+#define CURVE_POINTS5(p0, p1, p2, p3, p4) \
+  CURVE_PCT(p0), CURVE_LERP_PCT(p0, p1, 0.25f), CURVE_LERP_PCT(p0, p1, 0.5f), CURVE_LERP_PCT(p0, p1, 0.75f), \
+  CURVE_PCT(p1), CURVE_LERP_PCT(p1, p2, 0.25f), CURVE_LERP_PCT(p1, p2, 0.5f), CURVE_LERP_PCT(p1, p2, 0.75f), \
+  CURVE_PCT(p2), CURVE_LERP_PCT(p2, p3, 0.25f), CURVE_LERP_PCT(p2, p3, 0.5f), CURVE_LERP_PCT(p2, p3, 0.75f), \
+  CURVE_PCT(p3), CURVE_LERP_PCT(p3, p4, 0.25f), CURVE_LERP_PCT(p3, p4, 0.5f), CURVE_LERP_PCT(p3, p4, 0.75f), \
+  CURVE_PCT(p4)
+
+// ============================================================================
+// CURVES MODULE INTERFACE
+// ============================================================================
+
+// Get a flash-resident curve from the library (config.h CURVE_ID_*)
+// curve_id: Library index, out-of-range IDs return the linear curve
+// Returns: PROGMEM pointer to CURVE_POINTS Q12 values
+const int16_t* curves_get(uint8_t curve_id);
+
+// Evaluate a curve: one table lookup plus linear interpolation
+// curve: PROGMEM pointer from curves_get()
+// input_q12: Q12 stick input [-4096, +4096] (clamped to full scale)
+// Returns: Q12 shaped output with the sign of the input
+int16_t curve_eval(const int16_t* curve, int16_t input_q12);
+
+#endif // CURVES_H
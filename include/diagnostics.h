@@ -30,4 +30,16 @@ void diagnostics_update();
 // Get free RAM (for CRSF telemetry in Phase 2+)
 int diagnostics_get_free_ram();
 
+// Phase 8: Stack high-water mark
+// Background scan of the canary painted into free RAM at boot
+// (idle time between control loop ticks, STACK_SCAN_CHUNK bytes per call)
+void diagnostics_idle();
+
+// Worst-case free RAM: heap top to the deepest stack seen so far (bytes)
+uint16_t diagnostics_get_stack_headroom();
+
+// Worst-case RAM use: static data + heap + deepest stack (bytes)
+// Compare against RAM_BUDGET_BYTES
+uint16_t diagnostics_get_ram_peak();
+
 #endif // DIAGNOSTICS_H
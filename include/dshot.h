@@ -0,0 +1,26 @@
+// dshot.h - DShot digital weapon ESC output
+// UpVote Battlebot - Phase 8
+#ifndef DSHOT_H
+#define DSHOT_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// DSHOT MODULE INTERFACE
+// ============================================================================
+
+// Only active when WEAPON_ESC_PROTOCOL is ESC_PROTOCOL_DSHOT150/300
+// (pin 9 is then released by pulse_out and driven here)
+
+// Configure pin 9 as an output, idle low
+// Call this ONCE in actuators_init()
+void dshot_init();
+
+// Send one DShot frame for the weapon ESC
+// weapon_us: Throttle in WEAPON_ESC_MIN_US..MAX_US units (minimum = motor stop)
+// Interrupts are masked while the 16 bits go out (~54us at DShot300,
+// ~107us at DShot150). Disarmed with the link lost, periodically sends the
+// beacon command instead so the ESC beeps
+void dshot_update(uint16_t weapon_us);
+
+#endif // DSHOT_H
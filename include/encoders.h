@@ -0,0 +1,30 @@
+// encoders.h - Wheel encoder speed measurement
+// UpVote Battlebot - Phase 8
+#ifndef ENCODERS_H
+#define ENCODERS_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// ENCODERS MODULE INTERFACE
+// ============================================================================
+
+// Source selected by ENCODER_BACKEND in config.h:
+//   NONE - no encoders, speeds always 0
+//   HW   - edge-counting ISRs on the PIN_ENCODER_* pins
+//   SIM  - simulated wheels driven by the motor outputs
+
+// Initialize encoder inputs and interrupts
+// Call this ONCE in setup() before mixing_init()
+void encoders_init();
+
+// Sample edge counts and update wheel speed estimates
+// Call this every control loop iteration (100 Hz), before mixing_update()
+void encoders_update();
+
+// Get estimated wheel speed
+// motor_index: 0=RL, 1=RR, 2=FL, 3=FR
+// Returns: Edges per second, signed by the commanded direction
+int16_t encoders_get_speed(uint8_t motor_index);
+
+#endif // ENCODERS_H
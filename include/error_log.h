@@ -0,0 +1,58 @@
+// error_log.h - Timestamped error history with EEPROM persistence
+// UpVote Battlebot - Phase 8
+#ifndef ERROR_LOG_H
+#define ERROR_LOG_H
+
+#include <Arduino.h>
+#include "state.h"
+
+// ============================================================================
+// ERROR EVENT FORMAT
+// ============================================================================
+
+// One logged error (stored as-is in EEPROM, bump ERROR_LOG_RECORD_VERSION
+// in error_log.cpp when the layout changes)
+struct ErrorEvent {
+  uint32_t time_ms;    // timebase_millis() when logged
+  uint8_t code;        // SystemError
+  uint8_t stage;       // LoopStage running at the time
+  uint16_t context;    // Error-specific detail (see the call sites)
+};
+
+// ============================================================================
+// ERROR LOG MODULE INTERFACE
+// ============================================================================
+
+// Find the newest stored event and start a new boot number
+// Call this ONCE in setup() right after actuators_init(), before anything
+// can log an error
+void error_log_init();
+
+// Log an error event (O(1), no allocation, never touches EEPROM)
+// Events are buffered until error_log_idle() writes them; when the buffer
+// is full new events are counted as dropped. Control loop only (not ISRs).
+void error_log_record(SystemError code, uint16_t context);
+
+// Dump gesture (control loop, every tick)
+// While the kill switch is active, holding the yaw stick fully left starts
+// a dump of the stored events over telemetry
+void error_log_update();
+
+// Background EEPROM work (idle time between control loop ticks)
+// Writes buffered events one byte at a time into the next record of the
+// EEPROM ring (so every record wears equally), and reads ahead for a dump
+void error_log_idle();
+
+// Next dump line for the flight mode telemetry frame, if one is due
+// Lines: "L<boot> r<repeats> d<dropped>", then one per stored event, oldest
+// first, "b<boot> e<code> s<stage> t<ms> c<context>", then "L end"
+// Returns: NUL-terminated text, or NULL when no dump line is due
+const char* error_log_dump_line();
+
+// Check if a dump is in progress (the flight mode frame carries it)
+bool error_log_dumping();
+
+// Boot number of this session (stored with each event)
+uint8_t error_log_get_boot();
+
+#endif // ERROR_LOG_H
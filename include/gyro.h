@@ -0,0 +1,33 @@
+// gyro.h - Yaw-rate sensor interface
+// UpVote Battlebot - Phase 8
+#ifndef GYRO_H
+#define GYRO_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// GYRO MODULE INTERFACE
+// ============================================================================
+
+// One backend is compiled in, selected by GYRO_BACKEND in config.h:
+//   gyro_none.cpp     - no sensor, gyro_is_healthy() always false
+//   gyro_mpu6050.cpp  - MPU-6050 over I2C (A4/A5)
+//   gyro_sim.cpp      - simulated chassis driven by the motor outputs
+
+// Initialize the gyro and measure its zero-rate bias
+// The robot must be still; blocks for about GYRO_BIAS_SAMPLES ms
+// Call this ONCE in setup() before mixing_init()
+void gyro_init();
+
+// Read a new sample
+// Call this every control loop iteration (100 Hz), before mixing_update()
+void gyro_update();
+
+// Get the latest yaw rate
+// Returns: Q12 fraction of YAW_RATE_MAX_DPS, positive = clockwise from above
+int16_t gyro_get_yaw_rate();
+
+// Check if the latest reading is valid (sensor present and responding)
+bool gyro_is_healthy();
+
+#endif // GYRO_H
@@ -0,0 +1,70 @@
+// mixer_policies.h - Compile-time stick-to-chassis mixing strategies
+// UpVote Battlebot - Phase 8
+#ifndef MIXER_POLICIES_H
+#define MIXER_POLICIES_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ============================================================================
+// MIXER POLICY FORMAT
+// ============================================================================
+
+// A policy turns the sticks into the chassis command (X strafe, Y forward,
+// R rotate; Q12, before motion shaping) in a static chassis() template.
+// It reads sticks through the mixer's stick reader Sticks:
+//   Sticks::x/y/r(stick) - stick after deadband and the drive profile's
+//   curve for that chassis axis (r also applies rotation sensitivity)
+// The mixing pipeline is instantiated once per policy with the policy's
+// body inlined, so each strategy only contains its own stick reads - no
+// virtual dispatch and no per-tick branching on the strategy.
+
+// Stick indices into g_state.input.raw_channels[]
+#define MIXER_STICK_ROLL    0   // CH1: right stick X
+#define MIXER_STICK_PITCH   1   // CH2: right stick Y
+#define MIXER_STICK_YAW     3   // CH4: left stick X
+#define MIXER_STICK_LEFT_Y  8   // CH9: left stick Y (set the TX to send it for tank)
+
+// Holonomic: right stick translates, left stick rotates
+struct HolonomicMixer {
+  template <class Sticks>
+  static inline __attribute__((always_inline)) void chassis(int16_t* x, int16_t* y, int16_t* r) {
+    *x = -Sticks::x(MIXER_STICK_ROLL);   // Negated: strafe convention of the matrix
+    *y = Sticks::y(MIXER_STICK_PITCH);
+    *r = Sticks::r(MIXER_STICK_YAW);
+  }
+};
+
+// Tank with strafe: left stick Y drives the left wheels, right stick Y the
+// right wheels, left stick X strafes. The matrix runs the left side at
+// Y + R and the right side at Y - R, so Y = (left + right) / 2 and
+// R = (left - right) / 2 put each stick on its own side. Both tracks use
+// the Y curve; rotation sensitivity does not apply (the sticks are the tracks)
+struct TankStrafeMixer {
+  template <class Sticks>
+  static inline __attribute__((always_inline)) void chassis(int16_t* x, int16_t* y, int16_t* r) {
+    int16_t left = Sticks::y(MIXER_STICK_LEFT_Y);
+    int16_t right = Sticks::y(MIXER_STICK_PITCH);
+    *x = -Sticks::x(MIXER_STICK_YAW);
+    *y = (left + right) / 2;
+    *r = (left - right) / 2;
+  }
+};
+
+// Arcade: right stick drives and turns, no strafe (left stick unused)
+struct ArcadeMixer {
+  template <class Sticks>
+  static inline __attribute__((always_inline)) void chassis(int16_t* x, int16_t* y, int16_t* r) {
+    *x = 0;
+    *y = Sticks::y(MIXER_STICK_PITCH);
+    *r = Sticks::r(MIXER_STICK_ROLL);
+  }
+};
+
+// Map a MIXER_POLICY_* value from config.h to its policy type
+template <uint8_t POLICY> struct MixerPolicyFor;
+template <> struct MixerPolicyFor<MIXER_POLICY_HOLONOMIC>   { typedef HolonomicMixer type; };
+template <> struct MixerPolicyFor<MIXER_POLICY_TANK_STRAFE> { typedef TankStrafeMixer type; };
+template <> struct MixerPolicyFor<MIXER_POLICY_ARCADE>      { typedef ArcadeMixer type; };
+
+#endif // MIXER_POLICIES_H
@@ -0,0 +1,76 @@
+// mixer_presets.h - Mixer coefficient matrices for common wheel geometries
+// UpVote Battlebot - Phase 8
+#ifndef MIXER_PRESETS_H
+#define MIXER_PRESETS_H
+
+#include "config.h"
+#include "utilities.h"
+
+// ============================================================================
+// MIXER MATRIX FORMAT
+// ============================================================================
+
+// Each matrix is 4 motors x 3 axes of Q12 coefficients:
+//   wheel[m] = X*M[m][0] + Y*M[m][1] + R*M[m][2]
+// Motor rows follow actuators_set_motor() order: RL, RR, FL, FR
+// Axes: X = strafe right, Y = forward, R = rotate clockwise
+// Coefficients of exactly +1, -1 or 0 compile to add/subtract/nothing,
+// so the common layouts cost the same as the hand-written sums.
+#define MIXER_COEF(f)  Q12_FROM_FLOAT(f)
+
+// Mecanum wheels in X configuration (rollers form an X seen from above)
+#define MIXER_MATRIX_MECANUM_X { \
+  /*           X                  Y                 R          */ \
+  { MIXER_COEF(-1.0f), MIXER_COEF(1.0f), MIXER_COEF( 1.0f) },  /* RL */ \
+  { MIXER_COEF( 1.0f), MIXER_COEF(1.0f), MIXER_COEF(-1.0f) },  /* RR */ \
+  { MIXER_COEF( 1.0f), MIXER_COEF(1.0f), MIXER_COEF( 1.0f) },  /* FL */ \
+  { MIXER_COEF(-1.0f), MIXER_COEF(1.0f), MIXER_COEF(-1.0f) }   /* FR */ \
+}
+
+// Omni wheels mounted at 45 degrees on the corners (X-drive)
+// Same sign pattern as mecanum X; the 1/sqrt(2) wheel factor is absorbed
+// by output normalization
+#define MIXER_MATRIX_OMNI_X  MIXER_MATRIX_MECANUM_X
+
+// Tank / skid-steer (no strafe): left side Y+R, right side Y-R
+#define MIXER_MATRIX_TANK { \
+  /*           X                 Y                 R          */ \
+  { MIXER_COEF(0.0f), MIXER_COEF(1.0f), MIXER_COEF( 1.0f) },  /* RL */ \
+  { MIXER_COEF(0.0f), MIXER_COEF(1.0f), MIXER_COEF(-1.0f) },  /* RR */ \
+  { MIXER_COEF(0.0f), MIXER_COEF(1.0f), MIXER_COEF( 1.0f) },  /* FL */ \
+  { MIXER_COEF(0.0f), MIXER_COEF(1.0f), MIXER_COEF(-1.0f) }   /* FR */ \
+}
+
+// Three-wheel kiwi drive (omni wheels 120 degrees apart)
+// FL terminal drives the front wheel, RL/RR the rear pair, FR is unused
+#define MIXER_MATRIX_KIWI { \
+  /*           X                  Y                    R         */ \
+  { MIXER_COEF(-0.5f), MIXER_COEF( 0.866f), MIXER_COEF(1.0f) },  /* RL */ \
+  { MIXER_COEF(-0.5f), MIXER_COEF(-0.866f), MIXER_COEF(1.0f) },  /* RR */ \
+  { MIXER_COEF( 1.0f), MIXER_COEF( 0.0f),   MIXER_COEF(1.0f) },  /* FL (front) */ \
+  { MIXER_COEF( 0.0f), MIXER_COEF( 0.0f),   MIXER_COEF(0.0f) }   /* FR (unused) */ \
+}
+
+// ============================================================================
+// ACTIVE LAYOUT (selected by MIXER_LAYOUT in config.h)
+// ============================================================================
+
+#if MIXER_LAYOUT == MIXER_LAYOUT_MECANUM_X
+#define MIXER_MATRIX  MIXER_MATRIX_MECANUM_X
+#elif MIXER_LAYOUT == MIXER_LAYOUT_OMNI_X
+#define MIXER_MATRIX  MIXER_MATRIX_OMNI_X
+#elif MIXER_LAYOUT == MIXER_LAYOUT_TANK
+#define MIXER_MATRIX  MIXER_MATRIX_TANK
+#elif MIXER_LAYOUT == MIXER_LAYOUT_KIWI
+#define MIXER_MATRIX  MIXER_MATRIX_KIWI
+#else
+#error "Unknown MIXER_LAYOUT - see config.h for available layouts"
+#endif
+
+// Per-motor output scaling (RL, RR, FL, FR)
+#define MIXER_MOTOR_SCALE { \
+  MIXER_COEF(MIXER_SCALE_RL), MIXER_COEF(MIXER_SCALE_RR), \
+  MIXER_COEF(MIXER_SCALE_FL), MIXER_COEF(MIXER_SCALE_FR)  \
+}
+
+#endif // MIXER_PRESETS_H
@@ -11,9 +11,16 @@
 
 // Drive modes for different skill levels / situations
 enum DriveMode {
-  DRIVE_MODE_BEGINNER = 0,    // 50% max speed, gentle expo
-  DRIVE_MODE_NORMAL = 1,      // 80% max speed, moderate expo
-  DRIVE_MODE_AGGRESSIVE = 2   // 100% max speed, minimal expo
+  DRIVE_MODE_BEGINNER = 0,    // 50% max speed, gentle curves
+  DRIVE_MODE_NORMAL = 1,      // 80% max speed, moderate curves
+  DRIVE_MODE_AGGRESSIVE = 2   // 100% max speed, minimal curves
+};
+
+// Desaturation strategy used when a wheel command exceeds full scale
+enum DesatStrategy {
+  DESAT_UNIFORM = 0,              // Scale all wheels equally (keeps direction)
+  DESAT_YAW_PRIORITY = 1,         // Keep rotation, shed translation first
+  DESAT_TRANSLATION_PRIORITY = 2  // Keep translation, shed rotation first
 };
 
 // ============================================================================
@@ -27,7 +34,8 @@ void mixing_init();
 
 // Set active drive mode
 // mode: Drive mode (BEGINNER, NORMAL, or AGGRESSIVE)
-// Updates max duty cycle and expo curve parameters
+// Reloads max duty, curves and motion shaping from the profile mapped to
+// this switch position (also when that profile changes)
 void mixing_set_drive_mode(DriveMode mode);
 
 // Get current drive mode
@@ -36,9 +44,14 @@ DriveMode mixing_get_drive_mode();
 
 // Perform holonomic mixing
 // Reads g_state.input (roll, pitch, yaw)
-// Applies expo curves, holonomic math, and normalization
+// Applies response curves, chassis motion shaping, holonomic math, and
+// normalization
 // Outputs via actuators_set_motor() for all 4 motors
 // Call this every control loop iteration (100 Hz) when not in failsafe
 void mixing_update();
 
+// Stop all drive motors immediately (kill switch / link loss)
+// Bypasses motion shaping and resets it, so driving resumes from rest
+void mixing_stop();
+
 #endif // MIXING_H
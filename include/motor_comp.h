@@ -0,0 +1,49 @@
+// motor_comp.h - Per-motor deadzone and gain compensation
+// UpVote Battlebot - Phase 8
+#ifndef MOTOR_COMP_H
+#define MOTOR_COMP_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// MOTOR COMPENSATION MODULE INTERFACE
+// ============================================================================
+
+// Initialize motor compensation
+// Loads calibrated deadzones from EEPROM (falls back to config.h defaults
+// if the record is missing or corrupt) and precomputes per-channel scales
+// With MOTOR_COMP_CALIBRATION enabled, also starts the calibration sweep
+// Call this ONCE in setup() before mixing_init()
+void motor_comp_init();
+
+// Map a mixer command to the duty that makes this motor respond linearly
+// motor_index: 0=RL, 1=RR, 2=FL, 3=FR
+// command: Signed command [-255, +255] (positive = forward)
+// Returns: Compensated signed command [-255, +255] (0 stays 0)
+// Passes commands through unchanged while calibrating
+int16_t motor_comp_apply(uint8_t motor_index, int16_t command);
+
+// Write the calibration result to EEPROM, one byte per call
+// Call from the idle time between control loop ticks (never waits for
+// the EEPROM; the record only becomes valid with its last byte)
+void motor_comp_idle();
+
+// Check if the calibration sweep is running
+// While true, call motor_comp_calibration_update() instead of mixing_update()
+bool motor_comp_calibrating();
+
+// Run one tick of the calibration sweep (100 Hz, link OK, kill inactive)
+// Drives one motor at a time and records its breakaway duty when the
+// operator pushes the pitch stick forward; when finished, the result is
+// applied at once and saved by motor_comp_idle()
+void motor_comp_calibration_update();
+
+// Pause the calibration sweep (kill switch / link loss)
+// The current motor/direction restarts from 0 when driving resumes
+void motor_comp_calibration_hold();
+
+// Get the active deadzone of a channel (for diagnostics)
+// direction: 0 = forward, 1 = reverse
+uint8_t motor_comp_get_deadzone(uint8_t motor_index, uint8_t direction);
+
+#endif // MOTOR_COMP_H
@@ -0,0 +1,32 @@
+// motor_driver.h - Direct-port L293D shield driver
+// UpVote Battlebot - Phase 8
+#ifndef MOTOR_DRIVER_H
+#define MOTOR_DRIVER_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// MOTOR DRIVER MODULE INTERFACE
+// ============================================================================
+
+// Channel order matches actuators_set_motor(): 0=RL (M1), 1=RR (M2),
+// 2=FL (M4), 3=FR (M3)
+
+// Configure PWM timers (all channels at MOTOR_PWM_PRESCALER), shift
+// register pins and enable the outputs
+// All channels start stopped (coasting). Call this ONCE in actuators_init()
+void motor_driver_init();
+
+// Write all four channels in one batch
+// duty: PWM duty per channel [0, 255] (0 = coast, brake strength if braking)
+// reverse_mask: Bit per channel, set = run in reverse
+// brake_mask: Bit per channel, set = active brake (both inputs high)
+// Builds the direction byte for every motor at once, shifts it out with a
+// single latch and writes the compare registers - each only if it changed
+void motor_driver_write(const uint8_t duty[4], uint8_t reverse_mask, uint8_t brake_mask);
+
+// Stop all channels immediately and short every motor (full active brake)
+// Safe to call at any time, including from an error path or an ISR
+void motor_driver_brake();
+
+#endif // MOTOR_DRIVER_H
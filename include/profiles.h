@@ -0,0 +1,59 @@
+// profiles.h - EEPROM-persisted drive profiles
+// UpVote Battlebot - Phase 8
+#ifndef PROFILES_H
+#define PROFILES_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ============================================================================
+// PROFILE FORMAT
+// ============================================================================
+
+// One named parameter set, stored as-is in EEPROM (bump
+// PROFILE_RECORD_VERSION in profiles.cpp when the layout changes)
+struct DriveProfile {
+  char name[PROFILE_NAME_LEN];  // NUL-terminated display name
+  uint8_t max_duty;             // Maximum PWM duty (0-255)
+  uint8_t curve[3];             // Curve library ID per axis [X, Y, R]
+  uint8_t rotation_pct;         // Rotation sensitivity (% of full, 0-100)
+  uint8_t stop_brake;           // Stopped wheels: 0 = coast, else brake duty
+  uint16_t accel_ms[3];         // Stop -> full command per axis (0 = unlimited)
+  uint16_t decel_ms[3];         // Full command -> stop per axis (0 = unlimited)
+  uint16_t jerk_ms;             // Time to build up to full accel/decel
+  uint16_t weapon_spinup_ms;    // Weapon 0-100% S-curve ramp time (0 = none)
+  uint16_t weapon_spindown_ms;  // Weapon 100-0% S-curve ramp time (0 = none)
+};
+
+// ============================================================================
+// PROFILES MODULE INTERFACE
+// ============================================================================
+
+// Load the profile map and the three mapped profiles into RAM
+// Invalid or missing EEPROM records fall back to the compiled defaults and
+// are queued for writing. Call this ONCE in setup() before mixing_init()
+void profiles_init();
+
+// Get the RAM copy of the profile mapped to a drive mode switch position
+// mode: Switch position 0-2 (out-of-range uses position 1)
+// Never touches EEPROM - safe to call from the control loop
+const DriveProfile* profiles_get(uint8_t mode);
+
+// Incremented whenever a mapped profile in RAM changes
+// Consumers caching derived values compare it to reload
+uint8_t profiles_get_generation();
+
+// Profile selection gesture (control loop, every tick)
+// While the kill switch is active, holding the yaw stick fully right steps
+// the current switch position to the next profile. Only queues the change.
+void profiles_update();
+
+// Background EEPROM work (idle time between control loop ticks)
+// Loads newly selected profiles and writes changed records one byte at a
+// time, only when the EEPROM is ready, so it never stalls
+void profiles_idle();
+
+// Time profiles_init() took at boot (microseconds)
+uint16_t profiles_get_load_us();
+
+#endif // PROFILES_H
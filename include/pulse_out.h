@@ -0,0 +1,25 @@
+// pulse_out.h - Timer1 servo/ESC pulse generation
+// UpVote Battlebot - Phase 8
+#ifndef PULSE_OUT_H
+#define PULSE_OUT_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// PULSE OUTPUT MODULE INTERFACE
+// ============================================================================
+
+// Configure Timer1 for PULSE_OUT_HZ servo pulses on OC1A (weapon ESC,
+// pin 9) and OC1B (self-right servo, pin 10), 0.5us resolution
+// (OneShot125/Multishot: 62.5ns; DShot: servo only, see dshot.h)
+// Both outputs start at their safe pulse widths
+// Call this ONCE in actuators_init()
+void pulse_out_init();
+
+// Set both pulse widths (microseconds)
+// Values are clamped to the configured ranges and written to the compare
+// registers, which the hardware double-buffers: a new width takes effect
+// at the start of the next period, so a pulse is never cut short
+void pulse_out_write(uint16_t weapon_us, uint16_t servo_us);
+
+#endif // PULSE_OUT_H
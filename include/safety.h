@@ -37,7 +37,9 @@ inline SystemError safety_get_error() {
 }
 
 // Set error code (first-error-wins: doesn't overwrite existing errors)
-void safety_set_error(SystemError error);
+// Every call is also logged to the error history (see error_log.h)
+// context: Error-specific detail stored with the event
+void safety_set_error(SystemError error, uint16_t context = 0);
 
 // Clear error code
 inline void safety_clear_error() {
@@ -16,11 +16,16 @@ void servo_init();
 
 // Update servo control with momentary button logic
 // Handles:
-// - Momentary button control (CH7: selfright_switch)
-// - Rate limiting to prevent brownouts
+// - Self-righting sequence started by CH7 (selfright_switch), keyframes
+//   from flash played in real time (SELFRIGHT_SEQUENCE in config.h)
+// - Rate limiting on the return to neutral to prevent brownouts
 // - Endpoint clamping to safe calibrated range
-// - Failsafe behavior (returns to neutral on link loss)
-// Call this every control loop iteration (100 Hz)
+// - Failsafe behavior (aborts and returns to neutral on link loss or kill)
+// Call this every control loop iteration (100 Hz), before mixing_update()
 void servo_update();
 
+// Get the drive kick requested by the running sequence
+// Returns: Forward command added by the mixer (Q12, 0 = none)
+int16_t servo_get_drive_kick();
+
 #endif // SERVO_H
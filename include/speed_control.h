@@ -0,0 +1,30 @@
+// speed_control.h - Per-wheel closed-loop speed control
+// UpVote Battlebot - Phase 8
+#ifndef SPEED_CONTROL_H
+#define SPEED_CONTROL_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// SPEED CONTROL MODULE INTERFACE
+// ============================================================================
+
+// Initialize the per-wheel controllers (integrals and slip flags cleared)
+void speed_control_init();
+
+// Close the loop on one wheel between the mixer and actuators_set_motor()
+// motor_index: 0=RL, 1=RR, 2=FL, 3=FR
+// command: Mixer output [-255, +255], read as a speed request where
+//          255 = ENCODER_MAX_EPS
+// Returns: PWM command [-255, +255] that drives the wheel to that speed
+// Passes the command through unchanged without encoders
+int16_t speed_control_apply(uint8_t motor_index, int16_t command);
+
+// Clear all integrals (kill switch / link loss)
+void speed_control_reset();
+
+// Get wheels currently flagged as slipping
+// Returns: Bit mask, bit 0 = RL, 1 = RR, 2 = FL, 3 = FR
+uint8_t speed_control_get_slip_mask();
+
+#endif // SPEED_CONTROL_H
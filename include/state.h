@@ -5,23 +5,45 @@
 
 #include <Arduino.h>
 
+// CRSF channels the robot uses (CH1-CH9, CH9 only for tank mixing)
+#define RC_CHANNEL_COUNT  9
+
 // ============================================================================
 // ENUMS - System States and Modes
 // ============================================================================
 
 // Arming state (Phase 1.4+)
-enum ArmState {
+// (enums below are one byte, they live in RuntimeState)
+enum ArmState : uint8_t {
   DISARMED = 0,  // Weapon cannot activate
   ARMED = 1      // Weapon can activate
 };
 
 // System error codes (Phase 1.6+)
-enum SystemError {
+enum SystemError : uint8_t {
   ERR_NONE = 0,           // No error
   ERR_LOOP_OVERRUN = 1,   // Control loop took too long
   ERR_WATCHDOG_RESET = 2, // Recovered from watchdog reset
   ERR_CRSF_TIMEOUT = 3,   // CRSF link loss (Phase 2+)
-  ERR_CRSF_CRC = 4        // CRSF CRC validation failed (Phase 2+)
+  ERR_CRSF_CRC = 4,       // CRSF CRC validation failed (Phase 2+)
+  ERR_RAM_BUDGET = 5,     // Worst-case RAM use over budget (Phase 8, logged only)
+  ERR_KILL_LATENCY = 6,   // New worst kill latency (Phase 8, logged only)
+  ERR_WEAPON_RECOVERY = 7 // New slowest weapon recovery after a hit (Phase 8, logged only)
+};
+
+// Control loop stage running when an error is logged (Phase 8)
+enum LoopStage : uint8_t {
+  STAGE_BOOT = 0,         // setup()
+  STAGE_IDLE = 1,         // Between ticks (loop timing, background EEPROM)
+  STAGE_INPUT = 2,        // CRSF input
+  STAGE_PROFILES = 3,     // Profile selection gesture
+  STAGE_TELEMETRY = 4,    // Telemetry
+  STAGE_SENSORS = 5,      // Gyro, encoders, weapon RPM
+  STAGE_SERVO = 6,        // Self-right servo
+  STAGE_MIXING = 7,       // Drive mixing / calibration
+  STAGE_WEAPON = 8,       // Weapon arming and output
+  STAGE_ACTUATORS = 9,    // Hardware outputs
+  STAGE_DIAGNOSTICS = 10  // LED status
 };
 
 // ============================================================================
@@ -30,46 +52,27 @@ enum SystemError {
 
 // Central data structure holding all runtime state
 // All modules read/write to this structure
+//
+// Phase 8 layout: fixed-point values, 1-bit flags (read-modify-write, so
+// written by the control loop only - never from an ISR), and the fields
+// every tick touches (input, output, safety) first, within the 64-byte
+// displacement reach of AVR ldd/std. Size checked in state.cpp.
 struct RuntimeState {
 
-  // --- Timing ---
-  uint32_t loop_start_us;    // Loop start time (microseconds)
-  uint32_t loop_duration_us; // Last loop execution time
-
   // --- Input State (Phase 2+) ---
   struct {
-    float roll;       // Roll input [-1.0, +1.0] (right stick X)
-    float pitch;      // Pitch input [-1.0, +1.0] (right stick Y)
-    float yaw;        // Yaw input [-1.0, +1.0] (left stick X)
-    float throttle;   // Throttle input [-1.0, +1.0] (left stick Y - unused for holonomic)
-    float weapon;     // Weapon throttle [0.0, +1.0] (slider/pot)
-
-    bool arm_switch;      // Arming switch state (SA/SB/SC)
-    bool kill_switch;     // Kill switch state (SD)
-    bool selfright_switch; // Self-right trigger (SE/SF)
+    bool arm_switch : 1;       // Arming switch state (SA/SB/SC)
+    bool kill_switch : 1;      // Kill switch state (SD)
+    bool selfright_switch : 1; // Self-right trigger (SE/SF)
+    bool link_ok : 1;          // Link health status
 
-    uint32_t last_packet_ms; // Time of last valid CRSF packet
-    bool link_ok;            // Link health status
+    // Raw CRSF channel values CH1-CH9 (11-bit, 172-1811)
+    uint16_t raw_channels[RC_CHANNEL_COUNT];
 
-    // DEBUG: Raw CRSF channel values for diagnostics
-    uint16_t raw_channels[16];  // Raw 11-bit CRSF values (172-1811)
+    int16_t weapon;            // Weapon throttle, Q12 [0, Q12_ONE] (slider/pot)
+    uint32_t last_packet_ms;   // Time of last valid CRSF packet
   } input;
 
-  // --- Safety State (Phase 1.4+) ---
-  struct {
-    ArmState arm_state;      // Current arming state
-    SystemError error;       // Current error code
-
-    // Phase 5: Switch debouncing
-    bool arm_switch_debounced;      // Debounced arm switch
-    bool kill_switch_debounced;     // Debounced kill switch
-    uint32_t arm_switch_stable_ms;  // Debounce timer for arm switch
-    uint32_t kill_switch_stable_ms; // Debounce timer for kill switch
-
-    // Phase 5: Throttle hysteresis
-    float last_arm_throttle;        // Throttle value when last armed
-  } safety;
-
   // --- Output State (Phase 3+) ---
   struct {
     // Drive motors
@@ -85,17 +88,37 @@ struct RuntimeState {
     uint16_t servo_us;     // Servo pulse width (microseconds)
   } output;
 
+  // --- Safety State (Phase 1.4+) ---
+  struct {
+    ArmState arm_state;      // Current arming state
+    SystemError error;       // Current error code
+
+    // Phase 5: Switch debouncing
+    bool arm_switch_debounced : 1;  // Debounced arm switch
+    bool kill_switch_debounced : 1; // Debounced kill switch
+    uint32_t arm_switch_stable_ms;  // Debounce timer for arm switch
+    uint32_t kill_switch_stable_ms; // Debounce timer for kill switch
+
+    // Phase 5: Throttle hysteresis
+    int16_t last_arm_throttle;      // Throttle when last armed, Q12
+  } safety;
+
+  // --- Timing ---
+  uint8_t loop_stage;        // LoopStage currently running (error log)
+  uint16_t loop_duration_us; // Last loop execution time (saturated)
+  uint32_t loop_start_us;    // Loop start time (microseconds)
+
   // --- Diagnostics State (Phase 1.5+) ---
   struct {
-    uint32_t led_last_update_ms;  // Last LED update time
-    bool led_state;               // Current LED on/off state
+    bool led_state : 1;           // Current LED on/off state
     uint8_t error_blink_count;    // Error code blink counter
     uint8_t error_blink_phase;    // Error code state machine phase
+    uint32_t led_last_update_ms;  // Last LED update time
   } diagnostics;
 
   // --- Battery Telemetry State ---
   struct {
-    float voltage;                // Battery voltage in volts
+    uint16_t voltage_mv;          // Battery voltage in millivolts
     uint8_t percentage;           // Battery remaining percentage (0-100)
     uint32_t last_telemetry_ms;   // Last telemetry send time
   } battery;
@@ -0,0 +1,38 @@
+// thermal.h - L293D thermal model with dynamic duty derating
+// UpVote Battlebot - Phase 8
+#ifndef THERMAL_H
+#define THERMAL_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// THERMAL MODULE INTERFACE
+// ============================================================================
+
+// Initialize thermal model
+// Resets all channel heat estimates to cold and arms the boost window
+// Call this ONCE in setup() before mixing_init()
+void thermal_init();
+
+// Clamp a requested motor duty to the channel's current thermal limit
+// motor_index: 0=RL, 1=RR, 2=FL, 3=FR
+// requested_duty: Unsigned duty the mixer asked for [0, 255]
+// Returns: Duty allowed right now [0, 255]
+// The requested duty is also recorded so the model can open a boost
+// window when the driver asks for more than the derated limit
+uint8_t thermal_clamp_duty(uint8_t motor_index, uint8_t requested_duty);
+
+// Feed the duty actually written to a channel into the heat estimate
+// motor_index: 0=RL, 1=RR, 2=FL, 3=FR
+// applied_duty: Unsigned duty sent to the L293D [0, 255]
+// Call this once per channel every control loop iteration (100 Hz)
+void thermal_update_channel(uint8_t motor_index, uint8_t applied_duty);
+
+// Get estimated heat of a channel (for diagnostics/telemetry)
+// Returns: Heat estimate, 0 = cold, ~65000 = equilibrium at 100% duty
+uint16_t thermal_get_heat(uint8_t motor_index);
+
+// Check if a channel is currently inside its boost window
+bool thermal_is_boosting(uint8_t motor_index);
+
+#endif // THERMAL_H
@@ -0,0 +1,33 @@
+// timebase.h - millis()/micros() that follow the motor PWM timer
+// UpVote Battlebot - Phase 8
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// TIMEBASE MODULE INTERFACE
+// ============================================================================
+
+// The Arduino core counts time with Timer0 overflows and assumes prescaler
+// 64. motor_driver_init() runs Timer0 at MOTOR_PWM_PRESCALER, so firmware
+// code must use these instead of millis()/micros()/delay()
+// (libraries calling millis() internally see time run 64/MOTOR_PWM_PRESCALER
+// times fast - the CRSF link timeout is therefore taken from crsf_uart.cpp,
+// not the library)
+
+// Milliseconds since boot (wraps at 2^32 like millis(), ~49.7 days, so
+// now - then stays correct across the wrap). At prescaler 8 it is counted
+// from the core's Timer0 overflows since the previous call, which must come
+// within ~6 days (the control loop calls it every tick)
+// Safe to call from an ISR
+uint32_t timebase_millis();
+
+// Microseconds since boot (4us resolution at prescaler 64, 1us at 8)
+// Safe to call from an ISR
+uint32_t timebase_micros();
+
+// Busy-wait (setup only - the control loop must never block)
+void timebase_delay_ms(uint16_t ms);
+
+#endif // TIMEBASE_H
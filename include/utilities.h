@@ -18,12 +18,13 @@
  * specified debounce time before the debounced output changes.
  *
  * @param raw_state Current raw switch state (true/false)
- * @param debounced_state Pointer to debounced state variable (in/out)
+ * @param debounced_state Current debounced state
  * @param stable_time_ms Pointer to stability timer variable (in/out)
  * @param debounce_ms Debounce time in milliseconds (typically 10ms)
  * @param now Current time in milliseconds (from millis())
+ * @return New debounced state (returned, so the state can be a bitfield)
  *
- * @note This function modifies *debounced_state and *stable_time_ms
+ * @note This function modifies *stable_time_ms
  *
  * @example
  *   static bool button_debounced = false;
@@ -31,16 +32,102 @@
  *
  *   void update() {
  *     bool button_raw = digitalRead(PIN_BUTTON);
- *     debounce_switch(button_raw, &button_debounced, &button_stable_ms, 10, millis());
+ *     button_debounced = debounce_switch(button_raw, button_debounced, &button_stable_ms, 10, millis());
  *     if (button_debounced) {
  *       // Button is pressed (debounced)
  *     }
  *   }
  */
-void debounce_switch(bool raw_state,
-                     bool *debounced_state,
+bool debounce_switch(bool raw_state,
+                     bool debounced_state,
                      uint32_t *stable_time_ms,
                      uint8_t debounce_ms,
                      uint32_t now);
 
+// ============================================================================
+// FIXED-POINT (Q12) HELPERS
+// ============================================================================
+
+/**
+ * @brief Q12 fixed-point format used by the integer control path
+ *
+ * A Q12 value stores a real number x as round(x * 4096) in an int16_t,
+ * so [-1.0, +1.0] maps to [-4096, +4096] with headroom up to +/-7.99.
+ * Products of two Q12 values must be computed in int32_t and shifted
+ * right by Q12_SHIFT.
+ */
+#define Q12_SHIFT  12
+#define Q12_ONE    (1 << Q12_SHIFT)  // 1.0 in Q12
+
+// Convert a float constant to Q12 (intended for compile-time constants)
+#define Q12_FROM_FLOAT(f)  ((int16_t)((f) * Q12_ONE + ((f) >= 0 ? 0.5f : -0.5f)))
+
+/**
+ * @brief Multiply two Q12 values
+ *
+ * @param a Q12 operand
+ * @param b Q12 operand
+ * @return a * b in Q12 (rounded toward negative infinity)
+ */
+static inline int16_t q12_mul(int16_t a, int16_t b) {
+  return (int16_t)(((int32_t)a * b) >> Q12_SHIFT);
+}
+
+// ============================================================================
+// JERK-LIMITED (S-CURVE) FOLLOWER
+// ============================================================================
+
+/**
+ * @brief State of a jerk-limited follower
+ *
+ * value moves toward a target by rate units per step; rate itself changes
+ * by at most rate_step per step, giving S-shaped ramps instead of the
+ * sharp corners of a plain slew limiter.
+ */
+struct SCurveState {
+  int16_t value;  // Current output
+  int16_t rate;   // Current change per step (signed)
+};
+
+/**
+ * @brief Limits of a jerk-limited follower (all per step, > 0)
+ *
+ * rate_away applies while |value| grows (acceleration), rate_toward while
+ * it shrinks toward zero (deceleration), so stopping can be faster than
+ * starting. INT16_MAX for every field makes the follower a pass-through.
+ */
+struct SCurveLimits {
+  int16_t rate_away;    // Max |rate| moving away from zero
+  int16_t rate_toward;  // Max |rate| moving toward zero
+  int16_t rate_step;    // Max change of rate per step (jerk)
+};
+
+/**
+ * @brief Advance a jerk-limited follower by one step
+ *
+ * Starts braking early enough to arrive at the target, and never moves
+ * past it: if the target jumps onto or behind the output mid-ramp, the
+ * rate is dropped at once and the output holds, then ramps toward the new
+ * target (that corner is the one step that is not jerk limited).
+ * Integer only, no divides.
+ *
+ * @param state Follower state (in/out)
+ * @param target Value to move toward
+ * @param limits Rate and jerk limits
+ *
+ * @example
+ *   static SCurveState speed = {0, 0};
+ *   static const SCurveLimits limits = {40, 80, 10};
+ *   scurve_update(&speed, target, &limits);  // once per control loop
+ */
+void scurve_update(SCurveState *state, int16_t target, const SCurveLimits *limits);
+
+/**
+ * @brief Reset a follower to a value at rest
+ */
+static inline void scurve_reset(SCurveState *state, int16_t value) {
+  state->value = value;
+  state->rate = 0;
+}
+
 #endif  // UTILITIES_H
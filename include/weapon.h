@@ -5,6 +5,18 @@
 
 #include <Arduino.h>
 
+// ============================================================================
+// IMPACT LOG (Phase 8)
+// ============================================================================
+
+// Weapon speed recovery after hits (needs an RPM source, see weapon_rpm.h)
+struct WeaponImpactLog {
+  uint16_t count;              // Impacts recovered from since boot
+  uint16_t last_recovery_ms;   // Drop to back within WEAPON_IMPACT_RECOVER_PCT
+  uint16_t worst_recovery_ms;  // Longest recovery since boot (each new
+                               // worst is logged as ERR_WEAPON_RECOVERY)
+};
+
 // ============================================================================
 // WEAPON MODULE INTERFACE
 // ============================================================================
@@ -20,7 +32,15 @@ void weapon_init();
 // - Arming preconditions (throttle near zero, link OK, etc.)
 // - Disarming triggers (kill switch, link loss, etc.)
 // - Weapon output scaling and ramping when armed
-// Call this every control loop iteration (100 Hz)
+// - RPM governor (WEAPON_GOVERNOR_ENABLED) and impact log
+// Call this every control loop iteration (100 Hz), after weapon_rpm_update()
 void weapon_update();
 
+// Get the RPM the ramped weapon command stands for
+// (governor set point; nominal speed of the throttle when open loop)
+uint16_t weapon_get_target_rpm();
+
+// Get the impact recovery log
+const WeaponImpactLog* weapon_get_impact_log();
+
 #endif // WEAPON_H
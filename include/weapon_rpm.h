@@ -0,0 +1,32 @@
+// weapon_rpm.h - Weapon RPM measurement
+// UpVote Battlebot - Phase 8
+#ifndef WEAPON_RPM_H
+#define WEAPON_RPM_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// WEAPON RPM MODULE INTERFACE
+// ============================================================================
+
+// Source selected by WEAPON_RPM_BACKEND in config.h:
+//   NONE - no sensor, RPM always 0 and weapon_rpm_available() false
+//   TACH - pulse timing on PIN_WEAPON_TACH (INT0)
+//   SIM  - simulated weapon driven by the weapon output
+
+// Initialize the tach input and interrupt
+// Call this ONCE in setup() before weapon_init()
+void weapon_rpm_init();
+
+// Update the RPM estimate from the pulses since the last call
+// Call this every control loop iteration (100 Hz), before weapon_update()
+void weapon_rpm_update();
+
+// Get the latest weapon speed
+// Returns: Revolutions per minute (0 = stopped or no sensor)
+uint16_t weapon_rpm_get();
+
+// Check if an RPM source is compiled in
+bool weapon_rpm_available();
+
+#endif // WEAPON_RPM_H
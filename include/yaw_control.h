@@ -0,0 +1,27 @@
+// yaw_control.h - Closed-loop yaw-rate controller
+// UpVote Battlebot - Phase 8
+#ifndef YAW_CONTROL_H
+#define YAW_CONTROL_H
+
+#include <Arduino.h>
+
+// ============================================================================
+// YAW CONTROL MODULE INTERFACE
+// ============================================================================
+
+// Initialize the controller (integral cleared)
+void yaw_control_init();
+
+// Trim the mixer's rotation term with the gyro
+// rate_cmd_q12: Commanded yaw rate, Q12 fraction of YAW_RATE_MAX_DPS
+//               (the shaped yaw stick, positive = clockwise)
+// driving: true if any chassis axis is commanded; the loop idles (and
+//          clears its integral) while the robot is parked
+// Returns: Q12 rotation term for the mixer [-4096, +4096]
+// Falls back to the open-loop command when no healthy gyro is fitted
+int16_t yaw_control_update(int16_t rate_cmd_q12, bool driving);
+
+// Clear the integral (kill switch / link loss)
+void yaw_control_reset();
+
+#endif // YAW_CONTROL_H
@@ -1,178 +1,145 @@
 // actuators.cpp - Motor, ESC, and servo output implementation
 // UpVote Battlebot - Phase 1
-// Phase 7: AFMotor library integration for L293D V1 Motor Shield
+// Phase 8: Direct-port L293D shield driver (replaces the AFMotor library)
 #include "actuators.h"
 #include "config.h"
 #include "state.h"
+#include "thermal.h"
+#include "motor_comp.h"
+#include "motor_driver.h"
+#include "pulse_out.h"
+#include "dshot.h"
+#include "profiles.h"
+#include "mixing.h"
+#include "crsf_uart.h"
 #include <Arduino.h>
-#include <AFMotor.h>  // Adafruit Motor Shield V1 library (required for L293D shield)
+#include <util/atomic.h>
 
 // ============================================================================
-// AFMOTOR OBJECTS - L293D V1 Motor Shield Control
+// PHASE 3: MOTOR CONTROL
 // ============================================================================
 
-// Motor objects for L293D V1 Motor Shield
-// PHASE 7 FIX: Use matching PWM frequencies for all motors
 // Motor terminal mapping (verified via hardware documentation):
 //   M1 terminal = Rear-Left (RL) motor
 //   M2 terminal = Rear-Right (RR) motor
 //   M3 terminal = Front-Right (FR) motor
 //   M4 terminal = Front-Left (FL) motor
-// PWM Frequencies: Use lowest available frequencies for consistent motor response
-//   - MOTOR12_2KHZ = ~2 kHz (Timer2: for M1/M2)
-//   - MOTOR34_1KHZ = ~1 kHz (Timer0: for M3/M4, lowest available on UNO)
-static AF_DCMotor motor_rl(1, MOTOR12_2KHZ);  // M1: ~2 kHz
-static AF_DCMotor motor_rr(2, MOTOR12_2KHZ);  // M2: ~2 kHz
-static AF_DCMotor motor_fr(3, MOTOR34_1KHZ);  // M3: ~1 kHz (closer to M1/M2)
-static AF_DCMotor motor_fl(4, MOTOR34_1KHZ);  // M4: ~1 kHz (closer to M1/M2)
-
-// ============================================================================
-// PRIVATE HELPER FUNCTIONS
-// ============================================================================
-
-// Shift register state (global to avoid ISR safety issues)
-// Tracks current motor direction bits sent to 74HC595
-// TODO Phase 7: Remove after AFMotor integration complete
-static uint8_t g_shift_reg_state = 0x00;
-
-// Write 8 bits to the 74HC595 shift register (motor directions)
-static void shift_register_write(uint8_t data) {
-  digitalWrite(PIN_SR_LATCH, LOW);  // Prepare to shift data
-  shiftOut(PIN_SR_DATA, PIN_SR_CLOCK, MSBFIRST, data);
-  digitalWrite(PIN_SR_LATCH, HIGH); // Latch data to outputs
-}
-
-// Set motor direction via shift register bits
-// motor: 0=RL, 1=RR, 2=FL, 3=FR
-// forward: true=forward, false=reverse
-static void set_motor_direction(uint8_t motor, bool forward) {
-  // Bounds check motor index (QA fix: M3)
-  if (motor > 3) return;
-
-  // Calculate bit positions for this motor
-  uint8_t bit_a = motor * 2;     // Direction A bit
-  uint8_t bit_b = motor * 2 + 1; // Direction B bit
-
-  // Set direction bits
-  if (forward) {
-    g_shift_reg_state |= (1 << bit_a);   // A = HIGH
-    g_shift_reg_state &= ~(1 << bit_b);  // B = LOW
-  } else {
-    g_shift_reg_state &= ~(1 << bit_a);  // A = LOW
-    g_shift_reg_state |= (1 << bit_b);   // B = HIGH
+// Channel order in motor_driver_write(): RL, RR, FL, FR
+
+// Polarity inversion as a reverse-mask bit per channel
+#define MOTOR_INVERT_MASK \
+  ((MOTOR_RL_INVERTED ? 0x01 : 0) | (MOTOR_RR_INVERTED ? 0x02 : 0) | \
+   (MOTOR_FL_INVERTED ? 0x04 : 0) | (MOTOR_FR_INVERTED ? 0x08 : 0))
+
+// Phase 8: Emergency stop lock
+// Set by actuators_emergency_stop() (possibly from the CRSF receive
+// interrupt); holds all outputs safe until the kill is released and the
+// weapon has seen the stop
+static volatile bool g_output_lock;
+static volatile bool g_stop_event;      // Not yet taken by the weapon
+#if WEAPON_ESC_DSHOT
+static volatile bool g_dshot_stop_due;  // Stop frame owed to the ESC (sent from idle)
+#endif
+
+// Phase 8: Per-wheel direction reversal state
+#define REVERSE_BRAKE_TICKS  ((MOTOR_REVERSE_BRAKE_MS * LOOP_RATE_HZ + 999) / 1000)
+#define REVERSE_RAMP_STEP \
+  ((MOTOR_REVERSE_RAMP_MS * LOOP_RATE_HZ) / 1000 > 0 ? \
+   (MOTOR_PWM_MAX * 1000) / (MOTOR_REVERSE_RAMP_MS * LOOP_RATE_HZ) : MOTOR_PWM_MAX)
+
+static int8_t g_wheel_dir[4];          // Last driven direction (+1/-1, 0 = settled)
+static uint8_t g_wheel_duty[4];        // Last driven duty (0 once settled)
+static uint8_t g_wheel_idle_ticks[4];  // Ticks at zero command since then
+static uint8_t g_wheel_brake_ticks[4]; // Remaining reversal brake ticks
+static uint8_t g_wheel_ramp[4];        // Duty ceiling while ramping back in
+
+// Reversal handling for one wheel
+// Returns the duty to apply; sets *brake when the wheel should be braked
+// and *heat_duty to the duty the thermal model should see
+static uint8_t shape_wheel(uint8_t i, int16_t command, uint8_t stop_brake, bool* brake,
+                           uint8_t* heat_duty) {
+  int8_t dir = (command > 0) - (command < 0);
+  uint8_t duty = (uint8_t)constrain(abs(command), 0, MOTOR_PWM_MAX);
+
+  // Step 1: Detect a reversal - sign change (also across a brief zero) of
+  // a wheel that was actually turning
+  if (dir != 0) {
+    if (g_wheel_dir[i] == -dir &&
+        g_wheel_duty[i] > motor_comp_get_deadzone(i, g_wheel_dir[i] < 0) + MOTOR_REVERSE_MIN_DUTY) {
+      g_wheel_brake_ticks[i] = REVERSE_BRAKE_TICKS;
+      g_wheel_ramp[i] = 0;
+    }
+    g_wheel_dir[i] = dir;
+    g_wheel_idle_ticks[i] = 0;
+  } else if (g_wheel_idle_ticks[i] < REVERSE_BRAKE_TICKS) {
+    if (++g_wheel_idle_ticks[i] >= REVERSE_BRAKE_TICKS) {
+      g_wheel_dir[i] = 0;
+      g_wheel_duty[i] = 0;
+    }
   }
 
-  shift_register_write(g_shift_reg_state);
-}
+  // Brake current comes from the back-EMF of a wheel still turning: taken
+  // as the duty it was last driven at, scaled by the brake strength
+  uint8_t brake_heat = (uint8_t)(((uint16_t)g_wheel_duty[i] * MOTOR_REVERSE_BRAKE_DUTY) / MOTOR_PWM_MAX);
 
-// ============================================================================
-// PHASE 3: MOTOR CONTROL WITH SLEW-RATE LIMITING
-// ============================================================================
-
-// Previous motor PWM values (for slew-rate limiting)
-static int16_t g_motor_previous[4] = {0, 0, 0, 0};  // [RL, RR, FL, FR]
-
-// Apply slew-rate limiting to a motor command
-// current: Current motor value
-// target: Target motor value
-// Returns: Slewed value (gradually approaches target)
-static int16_t apply_slew_rate(int16_t current, int16_t target) {
-  int16_t delta = target - current;
-
-  if (delta > MOTOR_SLEW_RATE_MAX) {
-    return current + MOTOR_SLEW_RATE_MAX;
-  } else if (delta < -MOTOR_SLEW_RATE_MAX) {
-    return current - MOTOR_SLEW_RATE_MAX;
-  } else {
-    return target;
-  }
-}
-
-// Motor polarity inversion lookup table
-static const bool g_motor_inverted[4] = {
-  MOTOR_RL_INVERTED,  // Motor 0: Rear-Left
-  MOTOR_RR_INVERTED,  // Motor 1: Rear-Right
-  MOTOR_FL_INVERTED,  // Motor 2: Front-Left
-  MOTOR_FR_INVERTED   // Motor 3: Front-Right
-};
-
-// Initialize AFMotor objects to safe stopped state
-static void init_afmotor_motors() {
-  // Initialize all motors - set speed first, then release
-  // This matches the pattern from working test code
-  motor_rl.setSpeed(200);
-  motor_rl.run(RELEASE);
-  motor_rr.setSpeed(200);
-  motor_rr.run(RELEASE);
-  motor_fr.setSpeed(200);
-  motor_fr.run(RELEASE);
-  motor_fl.setSpeed(200);
-  motor_fl.run(RELEASE);
-}
-
-// Front motor minimum PWM boost to overcome higher inertia/friction
-// This is added to front motor speed when they're moving (non-zero command)
-#define FRONT_MOTOR_BOOST 30  // Add 30 PWM counts to front motors
-
-// Update motors using AFMotor library
-static void update_afmotor_motors() {
-  // Read motor commands from global state
-  int16_t fl = g_state.output.motor_fl_pwm;
-  int16_t fr = g_state.output.motor_fr_pwm;
-  int16_t rl = g_state.output.motor_rl_pwm;
-  int16_t rr = g_state.output.motor_rr_pwm;
-
-  // Apply inversion flags BEFORE AFMotor control
-  int16_t rl_adjusted = MOTOR_RL_INVERTED ? -rl : rl;
-  int16_t rr_adjusted = MOTOR_RR_INVERTED ? -rr : rr;
-  int16_t fr_adjusted = MOTOR_FR_INVERTED ? -fr : fr;
-  int16_t fl_adjusted = MOTOR_FL_INVERTED ? -fl : fl;
-
-  // Calculate base speeds
-  uint8_t rl_speed = (uint8_t)constrain(abs(rl_adjusted), 0, 255);
-  uint8_t rr_speed = (uint8_t)constrain(abs(rr_adjusted), 0, 255);
-  uint8_t fr_speed = (uint8_t)constrain(abs(fr_adjusted), 0, 255);
-  uint8_t fl_speed = (uint8_t)constrain(abs(fl_adjusted), 0, 255);
-
-  // BOOST FRONT MOTORS: Add fixed offset when motor is commanded to move
-  // This helps front motors overcome their higher inertia threshold
-  if (fr_speed > 0) {
-    fr_speed = (uint8_t)constrain(fr_speed + FRONT_MOTOR_BOOST, 0, 255);
-  }
-  if (fl_speed > 0) {
-    fl_speed = (uint8_t)constrain(fl_speed + FRONT_MOTOR_BOOST, 0, 255);
+  // Step 2: Dead time - brake before driving the other way
+  if (g_wheel_brake_ticks[i] > 0) {
+    if (--g_wheel_brake_ticks[i] == 0) g_wheel_duty[i] = 0;  // Taken as stopped
+    *brake = true;
+    *heat_duty = brake_heat;
+    return MOTOR_REVERSE_BRAKE_DUTY;
   }
 
-  // Update Rear-Left motor (M1 terminal)
-  motor_rl.setSpeed(rl_speed);
-  if (rl_speed == 0) {
-    motor_rl.run(RELEASE);
-  } else {
-    motor_rl.run(rl_adjusted >= 0 ? FORWARD : BACKWARD);
+  // Step 3: Stopped wheel - coast or brake per drive profile
+  if (dir == 0) {
+    *brake = (stop_brake != 0);
+    *heat_duty = (uint8_t)(((uint16_t)g_wheel_duty[i] * stop_brake) / MOTOR_PWM_MAX);
+    return stop_brake;
   }
 
-  // Update Rear-Right motor (M2 terminal)
-  motor_rr.setSpeed(rr_speed);
-  if (rr_speed == 0) {
-    motor_rr.run(RELEASE);
-  } else {
-    motor_rr.run(rr_adjusted >= 0 ? FORWARD : BACKWARD);
-  }
+  // Step 4: Ramp the new direction in from zero
+  *brake = false;
+  if (duty > g_wheel_ramp[i]) duty = g_wheel_ramp[i];
+  uint16_t ramp = g_wheel_ramp[i] + REVERSE_RAMP_STEP;
+  g_wheel_ramp[i] = (ramp > MOTOR_PWM_MAX) ? MOTOR_PWM_MAX : (uint8_t)ramp;
+  g_wheel_duty[i] = duty;
+  *heat_duty = duty;
+  return duty;
+}
 
-  // Update Front-Right motor (M3 terminal) - WITH BOOST APPLIED
-  motor_fr.setSpeed(fr_speed);
-  if (fr_speed == 0) {
-    motor_fr.run(RELEASE);
-  } else {
-    motor_fr.run(fr_adjusted >= 0 ? FORWARD : BACKWARD);
+// Write drive motor outputs in one batch
+static void update_motors() {
+  // Read motor commands from global state (channel order RL, RR, FL, FR)
+  int16_t command[4] = {
+    g_state.output.motor_rl_pwm,
+    g_state.output.motor_rr_pwm,
+    g_state.output.motor_fl_pwm,
+    g_state.output.motor_fr_pwm
+  };
+  uint8_t stop_brake = profiles_get(mixing_get_drive_mode())->stop_brake;
+
+  // Split into duty, direction and brake
+  uint8_t duty[4];
+  uint8_t reverse_mask = 0;
+  uint8_t brake_mask = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    bool brake;
+    uint8_t heat_duty;
+    duty[i] = shape_wheel(i, command[i], stop_brake, &brake, &heat_duty);
+    if (command[i] < 0) reverse_mask |= (1 << i);
+    if (brake) brake_mask |= (1 << i);
+
+    // PHASE 8: Feed the channel's load into the L293D thermal model
+    thermal_update_channel(i, heat_duty);
   }
 
-  // Update Front-Left motor (M4 terminal) - WITH BOOST APPLIED
-  motor_fl.setSpeed(fl_speed);
-  if (fl_speed == 0) {
-    motor_fl.run(RELEASE);
-  } else {
-    motor_fl.run(fl_adjusted >= 0 ? FORWARD : BACKWARD);
+  // Apply inversion flags at the hardware boundary only
+  // (skipped while an emergency stop holds the outputs; checked with
+  // interrupts masked so a kill arriving mid-write cannot be overwritten)
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (!g_output_lock) {
+      motor_driver_write(duty, reverse_mask ^ MOTOR_INVERT_MASK, brake_mask);
+    }
   }
 }
 
@@ -185,112 +152,107 @@ void actuators_set_motor(uint8_t motor_index, int16_t command) {
   if (motor_index > 3) return;
 
   // PHASE 7 FIX: Removed polarity inversion from here
-  // Inversion is now ONLY applied in update_afmotor_motors()
+  // Inversion is now ONLY applied in update_motors()
   // This prevents double-inversion bug that was breaking M2
 
-  // Step 1: Apply global duty cycle clamp (thermal protection)
-  int16_t adjusted_command = constrain(command, -MOTOR_DUTY_CLAMP_MAX, MOTOR_DUTY_CLAMP_MAX);
+  // Step 1: Per-motor deadzone/gain compensation (replaces the flat front boost)
+  command = motor_comp_apply(motor_index, command);
 
-  // Step 2: SLEW RATE DISABLED FOR TESTING - Direct response
-  // int16_t slewed_command = apply_slew_rate(g_motor_previous[motor_index], adjusted_command);
-  // g_motor_previous[motor_index] = slewed_command;
-  int16_t slewed_command = adjusted_command;  // Direct pass-through for testing
+  // Step 2: Apply dynamic duty limit from the L293D thermal model
+  // (full duty when cool/boosting, derated as the channel heats up)
+  uint8_t requested_duty = (uint8_t)constrain(abs(command), 0, MOTOR_PWM_MAX);
+  uint8_t allowed_duty = thermal_clamp_duty(motor_index, requested_duty);
+  int16_t adjusted_command = (command < 0) ? -(int16_t)allowed_duty : (int16_t)allowed_duty;
 
   // Step 3: Write to appropriate motor in g_state.output
+  // (acceleration limits are applied to the chassis command in mixing.cpp,
+  // not per wheel, so the direction of travel is preserved while ramping)
   switch (motor_index) {
-    case 0: g_state.output.motor_rl_pwm = slewed_command; break;  // Rear-Left
-    case 1: g_state.output.motor_rr_pwm = slewed_command; break;  // Rear-Right
-    case 2: g_state.output.motor_fl_pwm = slewed_command; break;  // Front-Left
-    case 3: g_state.output.motor_fr_pwm = slewed_command; break;  // Front-Right
+    case 0: g_state.output.motor_rl_pwm = adjusted_command; break;  // Rear-Left
+    case 1: g_state.output.motor_rr_pwm = adjusted_command; break;  // Rear-Right
+    case 2: g_state.output.motor_fl_pwm = adjusted_command; break;  // Front-Left
+    case 3: g_state.output.motor_fr_pwm = adjusted_command; break;  // Front-Right
   }
 }
 
 void actuators_init() {
-  // --- PHASE 7: AFMotor Library Initialization ---
-  // Initialize motors using AFMotor library (handles shift register + PWM internally)
-  // CRITICAL: Do NOT manually initialize shift register or motor PWM pins
-  // AFMotor library handles all of this internally!
-  init_afmotor_motors();
-
-  // --- Phase 5/6: Initialize weapon ESC and servo pins ---
-  // Note: These use Arduino's analogWrite() which generates PWM at ~490Hz
-  // This is acceptable for battlebot use (ESC/servo will average the signal)
-  // Production systems could use custom Timer2 PWM for proper 50Hz if needed
-  pinMode(PIN_WEAPON_ESC, OUTPUT);
-  pinMode(PIN_SELFRIGHT_SERVO, OUTPUT);
-
-  // Write safe initial values (PWM duty cycle: 0-255 maps to 0-5V)
-  // For ESC/servo: We'll map microseconds to duty cycle in actuators_update()
-  analogWrite(PIN_WEAPON_ESC, 0);
-  analogWrite(PIN_SELFRIGHT_SERVO, 0);
-
-  // Note: CRSF pins (0, 1) are initialized by Serial in Phase 2
+  // --- PHASE 8: Drive motors stopped, PWM timers configured ---
+  motor_driver_init();
+  for (uint8_t i = 0; i < 4; i++) {
+    g_wheel_dir[i] = 0;
+    g_wheel_duty[i] = 0;
+    g_wheel_idle_ticks[i] = REVERSE_BRAKE_TICKS;
+    g_wheel_brake_ticks[i] = 0;
+    g_wheel_ramp[i] = MOTOR_PWM_MAX;
+  }
+
+  // --- Phase 5/6: Weapon ESC and servo pulses (Timer1, safe widths) ---
+  pulse_out_init();
+#if WEAPON_ESC_DSHOT
+  dshot_init();
+#endif
+
+  g_output_lock = false;
+  g_stop_event = false;
+#if WEAPON_ESC_DSHOT
+  g_dshot_stop_due = false;
+#endif
+
+  // Note: CRSF pins (0, 1) are initialized by crsf_uart in input_init()
   // Note: Status LED pin is initialized by diagnostics module in Phase 1.5
 }
 
 void actuators_update() {
-  // === PHASE 7: AFMotor Integration Switch ===
-  // Set to 1 to use AFMotor library, 0 for old shift register code
-  #define USE_AFMOTOR 1
-
-  #if USE_AFMOTOR
-    // NEW CODE: Update motors using AFMotor library
-    update_afmotor_motors();
-  #else
-    // OLD CODE: Manual shift register + PWM control
-    // Read output state from global state
-    int16_t fl = g_state.output.motor_fl_pwm;
-    int16_t fr = g_state.output.motor_fr_pwm;
-    int16_t rl = g_state.output.motor_rl_pwm;
-    int16_t rr = g_state.output.motor_rr_pwm;
-
-    // --- Update Motor Directions ---
-    // HARDWARE MAPPING FIX: Actual wiring is M3=FR, M4=FL (swapped from pin names)
-    set_motor_direction(2, fr >= 0);  // M3 terminal = FR motor (hardware swapped)
-    set_motor_direction(3, fl >= 0);  // M4 terminal = FL motor (hardware swapped)
-    set_motor_direction(0, rl >= 0);  // M1 terminal = RL motor
-    set_motor_direction(1, rr >= 0);  // M2 terminal = RR motor
-
-    // --- Update Motor PWM (absolute value with bounds check) ---
-    // HARDWARE MAPPING FIX: Write FR command to M3 terminal, FL command to M4 terminal
-    analogWrite(PIN_MOTOR_FL_PWM, (uint8_t)constrain(abs(fr), MOTOR_PWM_MIN, MOTOR_PWM_MAX));  // D9=M3 has FR motor
-    analogWrite(PIN_MOTOR_FR_PWM, (uint8_t)constrain(abs(fl), MOTOR_PWM_MIN, MOTOR_PWM_MAX));  // D10=M4 has FL motor
-    analogWrite(PIN_MOTOR_RL_PWM, (uint8_t)constrain(abs(rl), MOTOR_PWM_MIN, MOTOR_PWM_MAX));  // D5=M1 has RL motor
-    analogWrite(PIN_MOTOR_RR_PWM, (uint8_t)constrain(abs(rr), MOTOR_PWM_MIN, MOTOR_PWM_MAX));  // D6=M2 has RR motor
-  #endif
-
-  // --- Update Weapon ESC (Phase 5) ---
-  // Map microseconds [1000-2000] to PWM duty cycle [0-255]
-  // Note: Arduino analogWrite() generates ~490Hz PWM, not standard 50Hz servo PWM
-  // ESCs will average the signal - works adequately for battlebot use
-  uint16_t weapon_us = g_state.output.weapon_us;
-  uint8_t weapon_pwm = map(constrain(weapon_us, WEAPON_ESC_MIN_US, WEAPON_ESC_MAX_US),
-                            WEAPON_ESC_MIN_US, WEAPON_ESC_MAX_US, 0, 255);
-  analogWrite(PIN_WEAPON_ESC, weapon_pwm);
-
-  // --- Update Servo (Phase 6) ---
-  // Map microseconds [700-2300] to PWM duty cycle [0-255]
-  uint16_t servo_us = g_state.output.servo_us;
-  uint8_t servo_pwm = map(constrain(servo_us, SERVO_ENDPOINT_RETRACT, SERVO_ENDPOINT_EXTEND),
-                           SERVO_ENDPOINT_RETRACT, SERVO_ENDPOINT_EXTEND, 0, 255);
-  analogWrite(PIN_SELFRIGHT_SERVO, servo_pwm);
+  // --- PHASE 8: Release the emergency stop lock ---
+  // Only once the receive interrupt, the decoded input and the weapon
+  // all agree the kill is over
+  if (g_output_lock && !g_stop_event && !crsf_uart_kill_active() &&
+      !g_state.input.kill_switch && g_state.input.link_ok) {
+    g_output_lock = false;
+  }
+
+  // --- Update Drive Motors ---
+  update_motors();
+
+  // --- Update Weapon ESC (Phase 5) and Servo (Phase 6) ---
+  // Pulse widths go straight to the Timer1 compare registers
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (!g_output_lock) {
+      pulse_out_write(g_state.output.weapon_us, g_state.output.servo_us);
+    }
+#if WEAPON_ESC_DSHOT
+    // One frame per tick, IRQs masked (motor stop while locked)
+    dshot_update(g_output_lock ? SAFE_WEAPON_US : g_state.output.weapon_us);
+    g_dshot_stop_due = false;
+#endif
+  }
 }
 
-void actuators_emergency_stop() {
-  // Immediately stop all motors
-  analogWrite(PIN_MOTOR_FL_PWM, SAFE_MOTOR_PWM);
-  analogWrite(PIN_MOTOR_FR_PWM, SAFE_MOTOR_PWM);
-  analogWrite(PIN_MOTOR_RL_PWM, SAFE_MOTOR_PWM);
-  analogWrite(PIN_MOTOR_RR_PWM, SAFE_MOTOR_PWM);
+void actuators_idle() {
+#if WEAPON_ESC_DSHOT
+  // Stop frame after an emergency stop, ahead of the next tick
+  // Not sent from the stop itself: a frame masks interrupts for 54-107us,
+  // too long for the CRSF receive interrupt it is called from
+  if (g_dshot_stop_due) {
+    g_dshot_stop_due = false;
+    dshot_update(SAFE_WEAPON_US);
+  }
+#endif
+}
 
-  // Brake all motors (A=HIGH, B=HIGH)
-  shift_register_write(0xFF);
+void actuators_emergency_stop() {
+  // Hold the outputs first so no control loop write can undo the stop
+  g_output_lock = true;
+  g_stop_event = true;
 
-  // Stop weapon
-  analogWrite(PIN_WEAPON_ESC, 0);
+  // Immediately stop and brake all motors (A=HIGH, B=HIGH)
+  motor_driver_brake();
 
-  // Neutral servo
-  analogWrite(PIN_SELFRIGHT_SERVO, 0);
+  // Stop weapon (minimum throttle pulse) and neutral servo
+  pulse_out_write(SAFE_WEAPON_US, SAFE_SERVO_US);
+#if WEAPON_ESC_DSHOT
+  g_dshot_stop_due = true;      // DShot stop frame goes out from actuators_idle()
+#endif
 
   // Update state to reflect emergency stop
   g_state.output.motor_fl_pwm = SAFE_MOTOR_PWM;
@@ -300,3 +262,12 @@ void actuators_emergency_stop() {
   g_state.output.weapon_us = SAFE_WEAPON_US;
   g_state.output.servo_us = SAFE_SERVO_US;
 }
+
+bool actuators_take_stop_event() {
+  bool event;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    event = g_stop_event;
+    g_stop_event = false;
+  }
+  return event;
+}
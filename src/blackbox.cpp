@@ -0,0 +1,370 @@
+// blackbox.cpp - Black-box flight recorder (delta-encoded control frames)
+// UpVote Battlebot - Phase 8
+#include "blackbox.h"
+#include "config.h"
+#include "state.h"
+#include "safety.h"
+#include "timebase.h"
+#include <util/crc16.h>
+
+#if BLACKBOX_ENABLED
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Worst-case tick: changed bit + every field as the longest Exp-Golomb code
+// (12-bit field: zigzag difference < 2^13 -> 25 bits, 27 leaves margin)
+#define FRAME_MAX_BYTES     ((1 + BLACKBOX_FIELDS * 27 + 7) / 8)
+
+// A block closes early past this size, so dropping the older blocks always
+// leaves room for the next tick
+#define BLOCK_MAX_BYTES     (BLACKBOX_BUFFER_BYTES / 4)
+#define MAX_BLOCKS          16
+
+#define POST_TRIGGER_TICKS  (BLACKBOX_POST_TRIGGER_MS / LOOP_PERIOD_MS)
+
+static_assert(BLOCK_MAX_BYTES + FRAME_MAX_BYTES < BLACKBOX_BUFFER_BYTES,
+              "BLACKBOX_BUFFER_BYTES too small for a block and a tick");
+static_assert(BLACKBOX_BLOCK_FRAMES < 256, "Block tick count is stored in one byte");
+static_assert(POST_TRIGGER_TICKS < 256, "BLACKBOX_POST_TRIGGER_MS too long");
+
+// Bit ring, written MSB first
+static uint8_t g_buf[BLACKBOX_BUFFER_BYTES];
+static uint16_t g_head;              // Byte being written
+static uint8_t g_bit;                // Bits already used in that byte
+
+// Blocks in the ring, oldest first (start offsets; the newest is being written)
+static uint16_t g_blocks[MAX_BLOCKS];
+static uint8_t g_block_first;
+static uint8_t g_block_count;
+
+// Previous tick (difference reference)
+static uint16_t g_prev[BLACKBOX_FIELDS];
+static uint32_t g_last_tick_ms;      // Time of the newest recorded tick
+
+// Trigger
+static uint8_t g_trigger;            // BlackboxTrigger
+static uint32_t g_trigger_ms;
+static uint8_t g_post_ticks;         // Ticks still recorded after the trigger
+static bool g_frozen;
+static bool g_link_was_ok;
+static bool g_error_seen;
+
+// Dump (ring frozen while active)
+static struct {
+  bool active;
+  bool header_sent;
+  uint16_t start;                    // Ring offset of the oldest block
+  uint16_t length;                   // Bytes to send
+  uint16_t pos;                      // Next byte to send
+  uint16_t crc;                      // CRC-CCITT of the bytes sent so far
+  uint32_t last_ms;
+} g_dump;
+
+// Dump gesture
+static bool g_dump_held;
+static bool g_dump_triggered;
+static uint32_t g_dump_start_ms;
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// Width of a field in a keyframe (see blackbox.h)
+static uint8_t field_bits(uint8_t field) {
+  if (field < 8) return 11 - BLACKBOX_CHANNEL_SHIFT;
+  if (field < 12) return 9;
+  if (field < 14) return 12;
+  if (field == 14) return 1;
+  return 8;
+}
+
+// This tick's fields, saturated to their keyframe widths
+static void capture(uint16_t* fields) {
+  for (uint8_t i = 0; i < 8; i++) {
+    fields[i] = g_state.input.raw_channels[i] >> BLACKBOX_CHANNEL_SHIFT;
+  }
+  fields[8] = g_state.output.motor_fl_pwm + 256;
+  fields[9] = g_state.output.motor_fr_pwm + 256;
+  fields[10] = g_state.output.motor_rl_pwm + 256;
+  fields[11] = g_state.output.motor_rr_pwm + 256;
+  fields[12] = g_state.output.weapon_us;
+  fields[13] = g_state.output.servo_us;
+  fields[14] = (g_state.safety.arm_state == ARMED) ? 1 : 0;
+  uint32_t loop = g_state.loop_duration_us >> BLACKBOX_LOOP_SHIFT;
+  fields[15] = (loop > 255) ? 255 : (uint16_t)loop;
+
+  // Out-of-range values (e.g. channels with no link) must not break the widths
+  for (uint8_t i = 0; i < BLACKBOX_FIELDS; i++) {
+    uint16_t max = (1U << field_bits(i)) - 1;
+    if (fields[i] > max) fields[i] = max;
+  }
+}
+
+static void put_bit(uint8_t bit) {
+  if (g_bit == 0) g_buf[g_head] = 0;
+  if (bit) g_buf[g_head] |= 0x80 >> g_bit;
+  if (++g_bit == 8) {
+    g_bit = 0;
+    g_head = (g_head + 1) % BLACKBOX_BUFFER_BYTES;
+  }
+}
+
+static void put_bits(uint16_t value, uint8_t count) {
+  while (count > 0) {
+    count--;
+    put_bit((value >> count) & 1);
+  }
+}
+
+// Exp-Golomb (order 0): n zeros, then value + 1 in n + 1 bits (0 -> "1")
+static uint8_t golomb_zeros(uint16_t value) {
+  uint8_t n = 0;
+  for (uint16_t t = value + 1; t > 1; t >>= 1) n++;
+  return n;
+}
+
+static void put_golomb(uint16_t value) {
+  uint8_t n = golomb_zeros(value);
+  put_bits(0, n);
+  put_bits(value + 1, n + 1);
+}
+
+// Zigzagged difference of a field from the last tick
+static inline uint16_t field_delta(const uint16_t* fields, uint8_t i) {
+  int16_t diff = (int16_t)(fields[i] - g_prev[i]);
+  return (uint16_t)((diff << 1) ^ (diff >> 15));
+}
+
+// Bytes from the oldest block start up to and including a partial byte
+static uint16_t bytes_from(uint16_t start) {
+  uint16_t used = (g_head + BLACKBOX_BUFFER_BYTES - start) % BLACKBOX_BUFFER_BYTES;
+  return used + (g_bit > 0 ? 1 : 0);
+}
+
+static uint16_t ring_used() {
+  return (g_block_count == 0) ? 0 : bytes_from(g_blocks[g_block_first]);
+}
+
+// Drop the oldest blocks until the next bits fit (keep = blocks that must
+// stay, i.e. the one being written). Only this tick's own size is made
+// room for, so the ring fills to its last byte before a block goes.
+static void make_room(uint8_t keep, uint16_t bits) {
+  uint16_t grow = (g_bit + bits + 7) / 8 - (g_bit > 0 ? 1 : 0);
+  while (g_block_count > keep &&
+         (ring_used() + grow >= BLACKBOX_BUFFER_BYTES || g_block_count == MAX_BLOCKS)) {
+    g_block_first = (g_block_first + 1) % MAX_BLOCKS;
+    g_block_count--;
+  }
+}
+
+// Start a block with this tick as its keyframe
+static void start_block(uint32_t now, const uint16_t* fields) {
+  // Step 1: Byte align (the partial byte belongs to the previous block)
+  if (g_bit > 0) {
+    g_bit = 0;
+    g_head = (g_head + 1) % BLACKBOX_BUFFER_BYTES;
+  }
+
+  // Step 2: Room, then the block table entry
+  uint16_t bits = 8 + 16;
+  for (uint8_t i = 0; i < BLACKBOX_FIELDS; i++) bits += field_bits(i);
+  make_room(0, bits);
+  g_blocks[(g_block_first + g_block_count) % MAX_BLOCKS] = g_head;
+  g_block_count++;
+
+  // Step 3: Header and keyframe
+  put_bits(1, 8);                        // Tick count (this keyframe)
+  put_bits((uint16_t)now, 16);           // Start time, low 16 bits of ms
+  for (uint8_t i = 0; i < BLACKBOX_FIELDS; i++) {
+    put_bits(fields[i], field_bits(i));
+  }
+}
+
+static void record(uint32_t now) {
+  uint16_t fields[BLACKBOX_FIELDS];
+  capture(fields);
+
+  // Step 1: New block when the current one is full (ticks or bytes)
+  uint16_t start = (g_block_count == 0) ? 0 :
+                   g_blocks[(g_block_first + g_block_count - 1) % MAX_BLOCKS];
+  if (g_block_count == 0 || g_buf[start] >= BLACKBOX_BLOCK_FRAMES ||
+      bytes_from(start) >= BLOCK_MAX_BYTES) {
+    start_block(now, fields);
+  } else {
+    // Step 2: Changed bit, then each field's difference from the last tick
+    // (sized first, so room is made for exactly this tick)
+    bool changed = memcmp(fields, g_prev, sizeof(g_prev)) != 0;
+    uint16_t bits = 1;
+    if (changed) {
+      for (uint8_t i = 0; i < BLACKBOX_FIELDS; i++) {
+        bits += 2 * golomb_zeros(field_delta(fields, i)) + 1;
+      }
+    }
+    make_room(1, bits);
+    put_bit(changed);
+    if (changed) {
+      for (uint8_t i = 0; i < BLACKBOX_FIELDS; i++) {
+        put_golomb(field_delta(fields, i));
+      }
+    }
+    g_buf[start]++;
+  }
+
+  memcpy(g_prev, fields, sizeof(g_prev));
+  g_last_tick_ms = now;
+}
+
+// Empty the ring and start recording again
+static void restart() {
+  g_head = 0;
+  g_bit = 0;
+  g_block_first = 0;
+  g_block_count = 0;
+  g_trigger = BLACKBOX_TRIGGER_NONE;
+  g_frozen = false;
+}
+
+// Start a dump after the roll stick is held fully left (kill switch active)
+static void update_dump_gesture(uint32_t now) {
+  if (!g_state.input.kill_switch || !g_state.input.link_ok ||
+      g_state.input.raw_channels[0] > BLACKBOX_DUMP_RAW) {
+    g_dump_held = false;
+    return;
+  }
+  if (!g_dump_held) {
+    g_dump_held = true;
+    g_dump_triggered = false;
+    g_dump_start_ms = now;
+    return;
+  }
+  if (g_dump_triggered || g_dump.active || now - g_dump_start_ms < BLACKBOX_DUMP_HOLD_MS) return;
+
+  g_dump_triggered = true;
+  g_dump.active = true;
+  g_dump.header_sent = false;
+  g_dump.start = (g_block_count == 0) ? 0 : g_blocks[g_block_first];
+  g_dump.length = ring_used();
+  g_dump.pos = 0;
+  g_dump.crc = 0xFFFF;
+  g_dump.last_ms = now - BLACKBOX_DUMP_FRAME_MS;
+}
+
+static inline void put_be16(uint8_t* dst, uint16_t value) {
+  dst[0] = value >> 8;
+  dst[1] = value & 0xFF;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void blackbox_init() {
+  restart();
+  g_post_ticks = 0;
+  g_link_was_ok = false;
+  g_error_seen = (safety_get_error() != ERR_NONE);  // Boot errors don't freeze
+  g_dump.active = false;
+  g_dump_held = false;
+}
+
+void blackbox_update() {
+  uint32_t now = timebase_millis();
+
+  // Step 1: Dump gesture (the ring stays frozen while it is sent)
+  update_dump_gesture(now);
+  if (g_dump.active) return;
+
+  // Step 2: First failsafe or latched error arms the freeze
+  bool link_lost = g_link_was_ok && !g_state.input.link_ok;
+  bool new_error = !g_error_seen && safety_get_error() != ERR_NONE;
+  g_link_was_ok = g_state.input.link_ok;
+  if (new_error) g_error_seen = true;
+
+  if (g_trigger == BLACKBOX_TRIGGER_NONE && (link_lost || new_error)) {
+    g_trigger = link_lost ? BLACKBOX_TRIGGER_FAILSAFE : BLACKBOX_TRIGGER_ERROR;
+    g_trigger_ms = now;
+    g_post_ticks = POST_TRIGGER_TICKS;
+  }
+
+  // Step 3: Record, freezing once the ticks after a trigger are in
+  if (g_frozen) return;
+  record(now);
+  if (g_trigger != BLACKBOX_TRIGGER_NONE) {
+    if (g_post_ticks == 0) g_frozen = true;
+    else g_post_ticks--;
+  }
+}
+
+uint8_t blackbox_dump_frame(uint8_t* payload) {
+  if (!g_dump.active) return 0;
+
+  uint32_t now = timebase_millis();
+  if (now - g_dump.last_ms < BLACKBOX_DUMP_FRAME_MS) return 0;
+  g_dump.last_ms = now;
+
+  // Header: format, trigger and its time, newest tick time, byte count,
+  // tick timing and field scaling
+  if (!g_dump.header_sent) {
+    g_dump.header_sent = true;
+    payload[0] = 'H';
+    payload[1] = BLACKBOX_FORMAT_VERSION;
+    payload[2] = g_trigger;
+    put_be16(&payload[3], g_trigger_ms >> 16);
+    put_be16(&payload[5], g_trigger_ms & 0xFFFF);
+    put_be16(&payload[7], g_last_tick_ms >> 16);
+    put_be16(&payload[9], g_last_tick_ms & 0xFFFF);
+    put_be16(&payload[11], g_dump.length);
+    payload[13] = LOOP_PERIOD_MS;
+    payload[14] = BLACKBOX_LOOP_SHIFT;
+    payload[15] = BLACKBOX_CHANNEL_SHIFT;
+    return 16;
+  }
+
+  // Data: byte offset, then the next chunk of the ring
+  if (g_dump.pos < g_dump.length) {
+    uint16_t left = g_dump.length - g_dump.pos;
+    uint8_t n = (left < BLACKBOX_DUMP_CHUNK) ? left : BLACKBOX_DUMP_CHUNK;
+    payload[0] = 'D';
+    put_be16(&payload[1], g_dump.pos);
+    for (uint8_t i = 0; i < n; i++) {
+      uint8_t byte = g_buf[(g_dump.start + g_dump.pos + i) % BLACKBOX_BUFFER_BYTES];
+      g_dump.crc = _crc_ccitt_update(g_dump.crc, byte);
+      payload[3 + i] = byte;
+    }
+    g_dump.pos += n;
+    return 3 + n;
+  }
+
+  // End: byte count and CRC, then record afresh
+  payload[0] = 'E';
+  put_be16(&payload[1], g_dump.length);
+  put_be16(&payload[3], g_dump.crc);
+  g_dump.active = false;
+  restart();
+  return 5;
+}
+
+bool blackbox_frozen() {
+  return g_frozen;
+}
+
+#else
+
+void blackbox_init() {
+}
+
+void blackbox_update() {
+}
+
+uint8_t blackbox_dump_frame(uint8_t* payload) {
+  (void)payload;
+  return 0;
+}
+
+bool blackbox_frozen() {
+  return false;
+}
+
+#endif // BLACKBOX_ENABLED
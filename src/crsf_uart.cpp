@@ -0,0 +1,259 @@
+// crsf_uart.cpp - Interrupt-driven CRSF UART with a fast kill path
+// UpVote Battlebot - Phase 8
+#include "crsf_uart.h"
+#include "config.h"
+#include "actuators.h"
+#include "timebase.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+CrsfUart CrsfSerial;
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Ring buffers (same sizes as HardwareSerial's defaults, powers of two)
+#define CRSF_RX_BUFFER_SIZE  64
+#define CRSF_TX_BUFFER_SIZE  64
+
+static volatile uint8_t g_rx_buffer[CRSF_RX_BUFFER_SIZE];
+static volatile uint8_t g_rx_head;   // Written by the ISR
+static volatile uint8_t g_rx_tail;   // Written by read()
+
+static volatile uint8_t g_tx_buffer[CRSF_TX_BUFFER_SIZE];
+static volatile uint8_t g_tx_head;   // Written by write()
+static volatile uint8_t g_tx_tail;   // Written by the ISR
+
+// RC channels frame as sent by the receiver:
+// [sync 0xC8][len 24][type 0x16][22 bytes: 16 x 11-bit channels][CRC8]
+#define CRSF_SYNC_BYTE        0xC8
+#define CRSF_RC_FRAME_LEN     24
+#define CRSF_RC_FRAME_TYPE    0x16
+#define CRSF_RC_LAST_POS      25     // Position of the CRC byte
+
+// Channel 3 (kill) is bits 22-32 of the payload: payload bytes 2-4
+#define KILL_BYTE_FIRST       2
+#define KILL_BYTE_LAST        4
+
+// Frame scanner (receive interrupt only)
+static uint8_t g_scan_pos;           // Next byte position in the frame (0 = sync)
+static uint8_t g_scan_crc;
+static uint8_t g_scan_kill[3];       // Payload bytes 2-4
+static uint32_t g_scan_start_us;     // Sync byte arrival
+
+// Results
+static volatile bool g_frame_seen;       // A valid RC frame arrived since begin()
+static volatile uint32_t g_frame_ms;     // Arrival of the newest valid RC frame
+static volatile bool g_kill_active;
+static volatile uint16_t g_kill_latency_us;
+static volatile uint16_t g_crc_errors;   // RC frames dropped for a bad CRC
+static uint16_t g_frame_tail_us;     // Wire time of the 25 bytes after sync
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// CRC8 DVB-S2 (polynomial 0xD5), as used by CRSF over type + payload
+static inline uint8_t crc8_dvb_s2(uint8_t crc, uint8_t byte) {
+  crc ^= byte;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+// Feed one received byte through the RC frame scanner
+// Other frame types and malformed frames drop back to hunting for sync
+static void scan_byte(uint8_t byte) {
+  uint8_t pos = g_scan_pos;
+
+  // Step 1: Header
+  if (pos == 0) {
+    if (byte != CRSF_SYNC_BYTE) return;
+    g_scan_start_us = timebase_micros();
+    g_scan_pos = 1;
+    return;
+  }
+  if (pos == 1) {
+    g_scan_pos = (byte == CRSF_RC_FRAME_LEN) ? 2 : 0;
+    return;
+  }
+  if (pos == 2) {
+    if (byte != CRSF_RC_FRAME_TYPE) {
+      g_scan_pos = 0;
+      return;
+    }
+    g_scan_crc = crc8_dvb_s2(0, byte);
+    g_scan_pos = 3;
+    return;
+  }
+
+  // Step 2: Payload - keep only the bytes holding channel 3
+  if (pos < CRSF_RC_LAST_POS) {
+    uint8_t index = pos - 3;
+    if (index >= KILL_BYTE_FIRST && index <= KILL_BYTE_LAST) {
+      g_scan_kill[index - KILL_BYTE_FIRST] = byte;
+    }
+    g_scan_crc = crc8_dvb_s2(g_scan_crc, byte);
+    g_scan_pos = pos + 1;
+    return;
+  }
+
+  // Step 3: CRC byte - frame complete
+  g_scan_pos = 0;
+  if (byte != g_scan_crc) {
+    g_crc_errors++;
+    return;
+  }
+  g_frame_ms = timebase_millis();
+  g_frame_seen = true;
+
+  uint16_t kill_raw = ((g_scan_kill[0] >> 6) | ((uint16_t)g_scan_kill[1] << 2) |
+                       ((uint16_t)g_scan_kill[2] << 10)) & 0x07FF;
+  bool kill = (kill_raw < KILL_RAW_THRESHOLD);
+
+#if KILL_FAST_PATH_ENABLED
+  if (kill && !g_kill_active) {
+    actuators_emergency_stop();
+
+    // Latency from the end of the frame on the wire to outputs safe
+    int32_t latency = (int32_t)(timebase_micros() - g_scan_start_us) - g_frame_tail_us;
+    if (latency < 0) latency = 0;
+    if (latency > (int32_t)g_kill_latency_us) g_kill_latency_us = (uint16_t)latency;
+  }
+#endif
+  g_kill_active = kill;
+}
+
+// ============================================================================
+// INTERRUPT SERVICE ROUTINES
+// ============================================================================
+
+// One received byte: into the library's buffer and through the scanner
+static inline void receive_byte(uint8_t byte) {
+  // Buffer for the library (dropped when full, like HardwareSerial)
+  uint8_t next = (g_rx_head + 1) & (CRSF_RX_BUFFER_SIZE - 1);
+  if (next != g_rx_tail) {
+    g_rx_buffer[g_rx_head] = byte;
+    g_rx_head = next;
+  }
+
+  // Sees every byte, even when the library has fallen behind
+  scan_byte(byte);
+}
+
+ISR(USART_RX_vect) {
+  bool parity_error = (UCSR0A & _BV(UPE0));
+  uint8_t byte = UDR0;
+  if (parity_error) return;
+  receive_byte(byte);
+}
+
+ISR(USART_UDRE_vect) {
+  if (g_tx_head == g_tx_tail) {
+    UCSR0B &= ~_BV(UDRIE0);    // Nothing left to send
+    return;
+  }
+  UDR0 = g_tx_buffer[g_tx_tail];
+  g_tx_tail = (g_tx_tail + 1) & (CRSF_TX_BUFFER_SIZE - 1);
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void CrsfUart::begin(unsigned long baud) {
+  // Step 1: Double-speed baud divisor, rounded the same way as
+  // HardwareSerial (420000 -> UBRR 4, 400 kbaud at 16 MHz)
+  uint16_t ubrr = (F_CPU / 4 / baud - 1) / 2;
+  g_frame_tail_us = (uint16_t)((25UL * 10 * 8 * (ubrr + 1)) / (F_CPU / 1000000UL));
+
+  g_rx_head = g_rx_tail = 0;
+  g_tx_head = g_tx_tail = 0;
+  g_scan_pos = 0;
+  g_frame_seen = false;
+  g_kill_active = false;
+  g_kill_latency_us = 0;
+  g_crc_errors = 0;
+
+  // Step 2: 8N1, receiver + transmitter, receive interrupt
+  UBRR0 = ubrr;
+  UCSR0A = _BV(U2X0);
+  UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+  UCSR0B = _BV(RXEN0) | _BV(TXEN0) | _BV(RXCIE0);
+}
+
+int CrsfUart::available() {
+  return (uint8_t)(g_rx_head - g_rx_tail) & (CRSF_RX_BUFFER_SIZE - 1);
+}
+
+int CrsfUart::peek() {
+  if (g_rx_head == g_rx_tail) return -1;
+  return g_rx_buffer[g_rx_tail];
+}
+
+int CrsfUart::read() {
+  if (g_rx_head == g_rx_tail) return -1;
+  uint8_t byte = g_rx_buffer[g_rx_tail];
+  g_rx_tail = (g_rx_tail + 1) & (CRSF_RX_BUFFER_SIZE - 1);
+  return byte;
+}
+
+size_t CrsfUart::write(uint8_t byte) {
+  // Wait for space (telemetry frames are far smaller than the buffer)
+  uint8_t next = (g_tx_head + 1) & (CRSF_TX_BUFFER_SIZE - 1);
+  while (next == g_tx_tail) {
+    // Busy-wait, the UDRE interrupt drains the buffer
+  }
+
+  g_tx_buffer[g_tx_head] = byte;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    g_tx_head = next;
+    UCSR0B |= _BV(UDRIE0);
+  }
+  return 1;
+}
+
+void CrsfUart::flush() {
+  while (g_tx_head != g_tx_tail) {
+    // Busy-wait until the buffer has drained
+  }
+}
+
+bool crsf_uart_link_up() {
+  uint32_t frame_ms;
+  bool seen;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    frame_ms = g_frame_ms;
+    seen = g_frame_seen;
+  }
+  return seen && (timebase_millis() - frame_ms < LINK_TIMEOUT_MS);
+}
+
+bool crsf_uart_kill_active() {
+  return g_kill_active;
+}
+
+uint16_t crsf_uart_get_kill_latency_us() {
+  uint16_t latency;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    latency = g_kill_latency_us;
+  }
+  return latency;
+}
+
+uint16_t crsf_uart_get_crc_errors() {
+  uint16_t errors;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    errors = g_crc_errors;
+  }
+  return errors;
+}
+
+#ifdef PIO_UNIT_TESTING
+void crsf_uart_receive(uint8_t byte) {
+  receive_byte(byte);
+}
+#endif
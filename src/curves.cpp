@@ -0,0 +1,52 @@
+// curves.cpp - Stick response curve lookup tables (PROGMEM)
+// UpVote Battlebot - Phase 8
+#include "curves.h"
+#include "config.h"
+#include <avr/pgmspace.h>
+
+// ============================================================================
+// CURVE LIBRARY (generated at compile time from config.h descriptions)
+// ============================================================================
+
+static const int16_t CURVE_LINEAR[CURVE_POINTS] PROGMEM = { CURVE_LIB_LINEAR };
+static const int16_t CURVE_EXPO10[CURVE_POINTS] PROGMEM = { CURVE_LIB_EXPO10 };
+static const int16_t CURVE_EXPO20[CURVE_POINTS] PROGMEM = { CURVE_LIB_EXPO20 };
+static const int16_t CURVE_EXPO30[CURVE_POINTS] PROGMEM = { CURVE_LIB_EXPO30 };
+static const int16_t CURVE_EXPO50[CURVE_POINTS] PROGMEM = { CURVE_LIB_EXPO50 };
+static const int16_t CURVE_CUSTOM[CURVE_POINTS] PROGMEM = { CURVE_LIB_CUSTOM };
+
+// Curve lookup by ID (kept in flash - AVR const data lives in RAM)
+static const int16_t* const g_curve_table[CURVE_COUNT] PROGMEM = {
+  CURVE_LINEAR, CURVE_EXPO10, CURVE_EXPO20, CURVE_EXPO30, CURVE_EXPO50, CURVE_CUSTOM
+};
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+const int16_t* curves_get(uint8_t curve_id) {
+  // Unknown IDs (e.g. from an older profile store) fall back to linear
+  if (curve_id >= CURVE_COUNT) curve_id = CURVE_ID_LINEAR;
+  return (const int16_t*)pgm_read_ptr(&g_curve_table[curve_id]);
+}
+
+int16_t curve_eval(const int16_t* curve, int16_t input_q12) {
+  // Work on magnitude, restore sign at the end (curves are odd-symmetric)
+  bool negative = input_q12 < 0;
+  uint16_t magnitude = negative ? (uint16_t)(-input_q12) : (uint16_t)input_q12;
+
+  // Full scale or beyond: return the last point
+  if (magnitude >= Q12_ONE) {
+    int16_t last = (int16_t)pgm_read_word(&curve[CURVE_POINTS - 1]);
+    return negative ? -last : last;
+  }
+
+  // Table lookup plus linear interpolation between neighbouring points
+  uint8_t index = magnitude >> CURVE_STEP_SHIFT;
+  uint8_t frac = magnitude & ((1 << CURVE_STEP_SHIFT) - 1);
+  int16_t y0 = (int16_t)pgm_read_word(&curve[index]);
+  int16_t y1 = (int16_t)pgm_read_word(&curve[index + 1]);
+  int16_t output = y0 + (int16_t)(((int32_t)(y1 - y0) * frac) >> CURVE_STEP_SHIFT);
+
+  return negative ? -output : output;
+}
@@ -4,6 +4,39 @@
 #include "config.h"
 #include "state.h"
 #include "safety.h"
+#include "timebase.h"
+#include "error_log.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Linker/allocator symbols: start of the heap and its current top
+extern uint8_t __heap_start;
+extern uint8_t* __brkval;
+
+#define RAM_SIZE_BYTES  (RAMEND + 1 - RAMSTART)
+
+// Stack high-water mark (lowest address the stack has written so far)
+static uint8_t* g_stack_mark;
+static uint8_t* g_stack_scan;        // Next byte to check in this pass
+static bool g_ram_budget_logged;
+
+// ============================================================================
+// STACK PAINT (before main)
+// ============================================================================
+
+// Fill everything from the heap start to the top of RAM with the canary.
+// Runs from .init3: the stack pointer is set and r1 cleared, nothing is on
+// the stack yet, and .bss is cleared afterwards (.init4) so the statics
+// above are unaffected. Naked, no calls: must not use the stack itself.
+static void stack_paint() __attribute__((naked, used, section(".init3")));
+static void stack_paint() {
+  uint8_t* p = &__heap_start;
+  while (p <= (uint8_t*)RAMEND) {
+    *p++ = STACK_CANARY;
+  }
+}
 
 // ============================================================================
 // PRIVATE HELPER FUNCTIONS
@@ -12,7 +45,7 @@
 // Blink error code: N blinks, pause, repeat
 static void diagnostics_blink_error_code(SystemError error) {
   static SystemError last_error = ERR_NONE;  // Track error changes (GAP-M4 fix)
-  uint32_t now = millis();
+  uint32_t now = timebase_millis();
   uint8_t blink_count = (uint8_t)error;  // Error enum value = blink count
 
   // Reset state if error changed mid-sequence (GAP-M4 fix)
@@ -77,10 +110,15 @@ void diagnostics_init() {
   g_state.diagnostics.led_state = false;
   g_state.diagnostics.error_blink_count = 0;
   g_state.diagnostics.error_blink_phase = 0;
+
+  // Everything above the current stack pointer is already in use
+  g_stack_mark = (uint8_t*)SP + 1;
+  g_stack_scan = &__heap_start;
+  g_ram_budget_logged = false;
 }
 
 void diagnostics_update() {
-  uint32_t now = millis();
+  uint32_t now = timebase_millis();
 
   // Determine current system status
   SystemError error = safety_get_error();
@@ -132,7 +170,41 @@ void diagnostics_update() {
 
 int diagnostics_get_free_ram() {
   // AVR-specific: Calculate free RAM between stack and heap
-  extern int __heap_start, *__brkval;
-  int v;
+  uint8_t v;
   return (int) &v - (__brkval == 0 ? (int) &__heap_start : (int) __brkval);
 }
+
+void diagnostics_idle() {
+  // Step 1: Passes start at the heap top (a growing heap covers the paint too)
+  uint8_t* heap_end = (__brkval == 0) ? &__heap_start : __brkval;
+  if (g_stack_scan < heap_end) g_stack_scan = heap_end;
+
+  // Step 2: Check a chunk upward; the first overwritten byte is the deepest
+  // the stack has reached (only bytes below the mark need checking)
+  for (uint8_t n = 0; n < STACK_SCAN_CHUNK && g_stack_scan < g_stack_mark; n++) {
+    if (*g_stack_scan != STACK_CANARY) {
+      g_stack_mark = g_stack_scan;
+      break;
+    }
+    g_stack_scan++;
+  }
+
+  // Step 3: Pass complete - log a new worst case over budget once, start over
+  if (g_stack_scan >= g_stack_mark) {
+    g_stack_scan = heap_end;
+    uint16_t peak = diagnostics_get_ram_peak();
+    if (peak > RAM_BUDGET_BYTES && !g_ram_budget_logged) {
+      g_ram_budget_logged = true;
+      error_log_record(ERR_RAM_BUDGET, peak);
+    }
+  }
+}
+
+uint16_t diagnostics_get_stack_headroom() {
+  uint8_t* heap_end = (__brkval == 0) ? &__heap_start : __brkval;
+  return (g_stack_mark > heap_end) ? (uint16_t)(g_stack_mark - heap_end) : 0;
+}
+
+uint16_t diagnostics_get_ram_peak() {
+  return RAM_SIZE_BYTES - diagnostics_get_stack_headroom();
+}
@@ -0,0 +1,141 @@
+// dshot.cpp - DShot digital weapon ESC output
+// UpVote Battlebot - Phase 8
+#include "dshot.h"
+#include "config.h"
+#include "state.h"
+#include "timebase.h"
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#if WEAPON_ESC_DSHOT
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Bit timing in CPU cycles (DShot150: 107/40/80, DShot300: 53/20/40 at 16 MHz)
+// A 0 bit is high for 3/8 of the period, a 1 bit for 3/4
+#if WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_DSHOT150
+#define DSHOT_BIT_RATE    150000UL
+#warning "DShot150 masks interrupts ~107us per tick - CRSF bytes (24us) can overrun; prefer DShot300"
+#else
+#define DSHOT_BIT_RATE    300000UL
+#endif
+#define DSHOT_BIT_CYCLES  ((F_CPU + DSHOT_BIT_RATE / 2) / DSHOT_BIT_RATE)
+#define DSHOT_T0H_CYCLES  ((DSHOT_BIT_CYCLES * 3 + 4) / 8)
+#define DSHOT_T1H_CYCLES  ((DSHOT_BIT_CYCLES * 3 + 2) / 4)
+
+// NOP padding between the edges of send_frame()'s bit loop
+//   rising edge -> 0-bit fall: D1 + 2 (nops, sbrs)
+//   rising edge -> 1-bit fall: D1 + D2 + 3 (nops, sbrs skipping the out)
+//   full bit: D1 + D2 + D3 + 9 (3x out, sbrs, lsl, rol, dec, brne taken)
+#define DSHOT_D1  (DSHOT_T0H_CYCLES - 2)
+#define DSHOT_D2  (DSHOT_T1H_CYCLES - DSHOT_T0H_CYCLES - 1)
+#define DSHOT_D3  (DSHOT_BIT_CYCLES - DSHOT_T1H_CYCLES - 6)
+
+static_assert(DSHOT_D3 >= 0, "DShot bit rate too fast for F_CPU");
+
+// Frame values below 48 are commands
+#define DSHOT_CMD_MOTOR_STOP   0
+#define DSHOT_THROTTLE_MIN     48
+#define DSHOT_THROTTLE_MAX     2047
+
+// Throttle step per microsecond above the first (Q16): MIN_US + 1 -> 48,
+// MAX_US -> 2047
+#define DSHOT_THROTTLE_SCALE \
+  (((uint32_t)(DSHOT_THROTTLE_MAX - DSHOT_THROTTLE_MIN) << 16) / (WEAPON_ESC_MAX_US - WEAPON_ESC_MIN_US - 1))
+
+static uint32_t g_beacon_last_ms;
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// 11-bit value + telemetry request bit + 4-bit CRC (XOR of the nibbles)
+static uint16_t build_frame(uint16_t value, bool telemetry) {
+  uint16_t packet = (value << 1) | (telemetry ? 1 : 0);
+  uint8_t crc = (packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F;
+  return (packet << 4) | crc;
+}
+
+// Bit-bang 16 bits MSB first on PB1 (D9), cycle-counted
+// Interrupts stay masked for the whole frame: an ISR in the middle would
+// stretch a bit and the ESC would drop the frame
+static void send_frame(uint16_t frame) {
+  uint8_t bits = 16;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    // Port values read with interrupts masked so no other PORTB pin changes
+    uint8_t hi = PORTB | _BV(PB1);
+    uint8_t lo = PORTB & ~_BV(PB1);
+
+    asm volatile(
+      "1:                   \n\t"
+      "out  %[port], %[hi]  \n\t"   // Rising edge
+      ".rept %[d1]          \n\t"
+      "nop                  \n\t"
+      ".endr                \n\t"
+      "sbrs %B[frame], 7    \n\t"   // 0 bit: fall at T0H
+      "out  %[port], %[lo]  \n\t"
+      ".rept %[d2]          \n\t"
+      "nop                  \n\t"
+      ".endr                \n\t"
+      "out  %[port], %[lo]  \n\t"   // 1 bit: fall at T1H
+      ".rept %[d3]          \n\t"
+      "nop                  \n\t"
+      ".endr                \n\t"
+      "lsl  %A[frame]       \n\t"
+      "rol  %B[frame]       \n\t"
+      "dec  %[bits]         \n\t"
+      "brne 1b              \n\t"
+      : [frame] "+r" (frame), [bits] "+r" (bits)
+      : [port] "I" (_SFR_IO_ADDR(PORTB)), [hi] "r" (hi), [lo] "r" (lo),
+        [d1] "n" (DSHOT_D1), [d2] "n" (DSHOT_D2), [d3] "n" (DSHOT_D3)
+    );
+  }
+}
+
+// Beacon due: weapon disarmed, no CRSF packet for DSHOT_BEACON_DELAY_MS,
+// and DSHOT_BEACON_INTERVAL_MS since the last beep
+static bool beacon_due() {
+  if (g_state.safety.arm_state != DISARMED) return false;
+
+  uint32_t now = timebase_millis();
+  if (now - g_state.input.last_packet_ms < DSHOT_BEACON_DELAY_MS) return false;
+  if (now - g_beacon_last_ms < DSHOT_BEACON_INTERVAL_MS) return false;
+
+  g_beacon_last_ms = now;
+  return true;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void dshot_init() {
+  PORTB &= ~_BV(PB1);
+  DDRB |= _BV(PB1);            // D9: weapon ESC signal, idle low
+  g_beacon_last_ms = 0;
+}
+
+void dshot_update(uint16_t weapon_us) {
+  uint16_t value;
+  bool telemetry = false;
+
+  // Step 1: Throttle -> 48..2047, minimum -> motor stop
+  if (weapon_us <= WEAPON_ESC_MIN_US) {
+    value = DSHOT_CMD_MOTOR_STOP;
+    if (beacon_due()) {
+      value = DSHOT_BEACON_TONE;
+      telemetry = true;         // Commands require the telemetry bit set
+    }
+  } else {
+    if (weapon_us > WEAPON_ESC_MAX_US) weapon_us = WEAPON_ESC_MAX_US;
+    uint16_t t = weapon_us - WEAPON_ESC_MIN_US;
+    value = DSHOT_THROTTLE_MIN + (uint16_t)(((uint32_t)(t - 1) * DSHOT_THROTTLE_SCALE + 0x8000) >> 16);
+  }
+
+  // Step 2: Build and send
+  send_frame(build_frame(value, telemetry));
+}
+
+#endif // WEAPON_ESC_DSHOT
@@ -0,0 +1,206 @@
+// encoders.cpp - Wheel encoder speed measurement
+// UpVote Battlebot - Phase 8
+#include "encoders.h"
+#include "config.h"
+#include "state.h"
+#include "timebase.h"
+#include <util/atomic.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+#define ENCODER_TIMEOUT_US  ((uint32_t)ENCODER_TIMEOUT_MS * 1000UL)
+
+// Edge capture, written by the ISRs (or the simulation) [RL, RR, FL, FR]
+static volatile uint16_t g_edge_count[4];    // Free-running edge counters
+static volatile uint32_t g_edge_us[4];       // Time of the latest edge
+static volatile uint32_t g_period_us[4];     // Time between the last two edges
+
+// Per-tick estimator state
+static uint16_t g_last_count[4];             // Counter value at previous tick
+static int16_t g_speed[4];                   // Signed edges per second
+
+// ============================================================================
+// EDGE CAPTURE
+// ============================================================================
+
+#if ENCODER_BACKEND == ENCODER_BACKEND_HW
+// Record one edge on a channel (ISR context)
+static inline void record_edge(uint8_t motor, uint32_t now) {
+  g_period_us[motor] = now - g_edge_us[motor];
+  g_edge_us[motor] = now;
+  g_edge_count[motor]++;
+}
+
+// Previous state of the PORTC encoder pins (for rising-edge detection)
+static volatile uint8_t g_pinc_last;
+
+// A1-A3 (PC1-PC3): RL, RR, FL on pin-change interrupt 1
+ISR(PCINT1_vect) {
+  uint8_t pins = PINC;
+  uint8_t rising = pins & ~g_pinc_last;
+  g_pinc_last = pins;
+
+  uint32_t now = timebase_micros();
+  if (rising & _BV(PC1)) record_edge(0, now);
+  if (rising & _BV(PC2)) record_edge(1, now);
+  if (rising & _BV(PC3)) record_edge(2, now);
+}
+
+// Pin 2 (PD2): FR on external interrupt 0 (rising edge)
+ISR(INT0_vect) {
+  record_edge(3, timebase_micros());
+}
+
+static void capture_init() {
+  pinMode(PIN_ENCODER_RL, INPUT_PULLUP);
+  pinMode(PIN_ENCODER_RR, INPUT_PULLUP);
+  pinMode(PIN_ENCODER_FL, INPUT_PULLUP);
+  pinMode(PIN_ENCODER_FR, INPUT_PULLUP);
+
+  g_pinc_last = PINC;
+  PCMSK1 |= _BV(PCINT9) | _BV(PCINT10) | _BV(PCINT11);
+  PCICR |= _BV(PCIE1);
+
+  EICRA = (EICRA & ~(_BV(ISC01) | _BV(ISC00))) | _BV(ISC01) | _BV(ISC00);
+  EIMSK |= _BV(INT0);
+}
+
+static void capture_update() {
+  // Edges arrive from the ISRs
+}
+
+#elif ENCODER_BACKEND == ENCODER_BACKEND_SIM
+// Simulated wheel: first-order speed response to the applied duty above a
+// breakaway deadzone, with one wheel at a time periodically losing traction
+#define SIM_SLIP_PERIOD_TICKS  (ENCODER_SIM_SLIP_PERIOD_MS / LOOP_PERIOD_MS)
+#define SIM_SLIP_TICKS         (ENCODER_SIM_SLIP_MS / LOOP_PERIOD_MS)
+
+static const uint8_t g_sim_deadzone[4] = {
+  ENCODER_SIM_DEADZONE_REAR, ENCODER_SIM_DEADZONE_REAR,
+  ENCODER_SIM_DEADZONE_FRONT, ENCODER_SIM_DEADZONE_FRONT
+};
+
+static int16_t g_sim_speed[4];      // Wheel speed magnitude (edges/s)
+static uint16_t g_sim_edge_acc[4];  // Fractional edges (1/LOOP_RATE_HZ units)
+static uint16_t g_sim_ticks;        // Slip schedule
+static uint8_t g_sim_slip_wheel;
+
+static void capture_init() {
+  for (uint8_t i = 0; i < 4; i++) {
+    g_sim_speed[i] = 0;
+    g_sim_edge_acc[i] = 0;
+  }
+  g_sim_ticks = 0;
+  g_sim_slip_wheel = 0;
+}
+
+static void capture_update() {
+  const int16_t out[4] = {
+    g_state.output.motor_rl_pwm, g_state.output.motor_rr_pwm,
+    g_state.output.motor_fl_pwm, g_state.output.motor_fr_pwm
+  };
+
+  // Rotate the slipping wheel each period
+  if (++g_sim_ticks >= SIM_SLIP_PERIOD_TICKS) {
+    g_sim_ticks = 0;
+    g_sim_slip_wheel = (g_sim_slip_wheel + 1) & 3;
+  }
+  bool slipping = g_sim_ticks < SIM_SLIP_TICKS;
+
+  uint32_t now = timebase_micros();
+  for (uint8_t i = 0; i < 4; i++) {
+    // Step 1: Steady-state speed for the applied duty
+    int16_t duty = abs(out[i]) - g_sim_deadzone[i];
+    int32_t target = (duty > 0)
+        ? ((int32_t)duty * ENCODER_MAX_EPS) / (MOTOR_PWM_MAX - g_sim_deadzone[i])
+        : 0;
+    if (slipping && i == g_sim_slip_wheel) target += target;
+
+    // Step 2: First-order response
+    g_sim_speed[i] += (int16_t)((target - g_sim_speed[i]) >> ENCODER_SIM_TAU_SHIFT);
+
+    // Step 3: Emit whole edges for this tick
+    g_sim_edge_acc[i] += g_sim_speed[i];
+    uint8_t edges = g_sim_edge_acc[i] / LOOP_RATE_HZ;
+    g_sim_edge_acc[i] -= (uint16_t)edges * LOOP_RATE_HZ;
+    if (edges > 0) {
+      g_edge_count[i] += edges;
+      g_period_us[i] = 1000000UL / g_sim_speed[i];
+      g_edge_us[i] = now;
+    }
+  }
+}
+
+#else
+static void capture_init() {
+}
+
+static void capture_update() {
+}
+#endif
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void encoders_init() {
+  for (uint8_t i = 0; i < 4; i++) {
+    g_edge_count[i] = 0;
+    g_edge_us[i] = 0;
+    g_period_us[i] = 0;
+    g_last_count[i] = 0;
+    g_speed[i] = 0;
+  }
+  capture_init();
+}
+
+void encoders_update() {
+  capture_update();
+
+  // Step 1: Snapshot capture state (32-bit values are not atomic on AVR)
+  uint16_t count[4];
+  uint32_t edge_us[4];
+  uint32_t period_us[4];
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    for (uint8_t i = 0; i < 4; i++) {
+      count[i] = g_edge_count[i];
+      edge_us[i] = g_edge_us[i];
+      period_us[i] = g_period_us[i];
+    }
+  }
+
+  // Direction from last tick's commands (single-channel encoders)
+  const int16_t out[4] = {
+    g_state.output.motor_rl_pwm, g_state.output.motor_rr_pwm,
+    g_state.output.motor_fl_pwm, g_state.output.motor_fr_pwm
+  };
+
+  uint32_t now = timebase_micros();
+  for (uint8_t i = 0; i < 4; i++) {
+    uint16_t edges = count[i] - g_last_count[i];
+    g_last_count[i] = count[i];
+
+    // Step 2: Count method at speed (cheap, good resolution), period method
+    // when slow (one divide); an overdue edge bounds the speed from above
+    uint16_t eps;
+    uint32_t age = now - edge_us[i];
+    if (edges >= ENCODER_COUNT_MIN) {
+      eps = edges * LOOP_RATE_HZ;
+    } else if (period_us[i] == 0 || age > ENCODER_TIMEOUT_US) {
+      eps = 0;
+    } else {
+      uint32_t period = (age > period_us[i]) ? age : period_us[i];
+      eps = (uint16_t)(1000000UL / period);
+    }
+
+    if (eps > INT16_MAX) eps = INT16_MAX;
+    g_speed[i] = (out[i] < 0) ? -(int16_t)eps : (int16_t)eps;
+  }
+}
+
+int16_t encoders_get_speed(uint8_t motor_index) {
+  if (motor_index > 3) return 0;
+  return g_speed[motor_index];
+}
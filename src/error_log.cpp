@@ -0,0 +1,274 @@
+// error_log.cpp - Timestamped error history with EEPROM persistence
+// UpVote Battlebot - Phase 8
+#include "error_log.h"
+#include "config.h"
+#include "timebase.h"
+#include "profiles.h"
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// EEPROM record (bump version when the layout changes)
+// The log area is a ring of records written in turn, so every record
+// wears equally; the newest valid sequence number marks the ring head.
+// Packed so a host build (native tests) has the AVR's 13-byte layout.
+#define ERROR_LOG_RECORD_VERSION  1
+#define ERROR_LOG_SLOT_NONE       0xFF
+
+struct __attribute__((packed)) ErrorLogRecord {
+  uint8_t version;          // ERROR_LOG_RECORD_VERSION
+  uint8_t seq;              // Write order (newest wins, wraps)
+  uint8_t boot;             // Boot number the event was logged in
+  ErrorEvent event;
+  uint16_t crc;             // CRC-CCITT of the bytes above
+};
+
+#define ERROR_LOG_SLOTS      (EEPROM_SIZE_ERROR_LOG / sizeof(ErrorLogRecord))
+#define ERROR_LOG_ADDR(slot) (EEPROM_ADDR_ERROR_LOG + (slot) * sizeof(ErrorLogRecord))
+
+// Sequence numbers are compared by signed 8-bit difference
+static_assert(ERROR_LOG_SLOTS < 128, "Too many error log records for an 8-bit sequence");
+static_assert((ERROR_LOG_RAM_EVENTS & (ERROR_LOG_RAM_EVENTS - 1)) == 0,
+              "ERROR_LOG_RAM_EVENTS must be a power of two");
+
+// Events waiting for idle time (ring, one entry kept free)
+static ErrorEvent g_pending[ERROR_LOG_RAM_EVENTS];
+static uint8_t g_pending_head;       // Next free entry
+static uint8_t g_pending_tail;       // Oldest unwritten entry
+static uint16_t g_dropped;           // Events lost to a full buffer
+static uint16_t g_repeats;           // Repeats counted instead of logged
+static uint8_t g_last_code = ERR_NONE;
+static uint32_t g_last_ms;
+
+// EEPROM ring position
+static uint8_t g_boot;
+static uint8_t g_seq;                // Sequence of the newest record
+static uint8_t g_next_slot;          // Record the next event goes to
+
+// In-progress write (one byte per error_log_idle() call)
+static ErrorLogRecord g_record;
+static uint8_t g_write_pos = sizeof(ErrorLogRecord);  // = size: idle
+static uint8_t* g_write_addr;
+
+// Telemetry dump
+#define ERROR_LOG_LINE_LEN  32
+static struct {
+  bool active;
+  bool ready;                        // line holds the next text to send
+  bool finished;                     // line is the closing line
+  uint8_t slot;                      // Next record to read
+  uint8_t left;                      // Records still to read
+  uint32_t last_ms;                  // Time the previous line was sent
+  char line[ERROR_LOG_LINE_LEN];
+} g_dump;
+
+// Dump gesture
+static bool g_dump_held;
+static bool g_dump_triggered;
+static uint32_t g_dump_start_ms;
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// CRC-CCITT over the bytes of a record before its crc field
+static uint16_t record_crc(const ErrorLogRecord* record) {
+  const uint8_t* bytes = (const uint8_t*)record;
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < offsetof(ErrorLogRecord, crc); i++) {
+    crc = _crc_ccitt_update(crc, bytes[i]);
+  }
+  return crc;
+}
+
+// Read one record, false if blank, corrupt or an older layout
+static bool read_record(uint8_t slot, ErrorLogRecord* record) {
+  eeprom_read_block(record, (const void*)ERROR_LOG_ADDR(slot), sizeof(ErrorLogRecord));
+  return record->version == ERROR_LOG_RECORD_VERSION && record->crc == record_crc(record);
+}
+
+// Append " <tag><decimal value>" (tag first on the line skips the space)
+static char* append_field(char* out, char tag, uint32_t value) {
+  char digits[10];
+  uint8_t n = 0;
+  do {
+    digits[n++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+
+  if (out != g_dump.line) *out++ = ' ';
+  *out++ = tag;
+  while (n > 0) *out++ = digits[--n];
+  *out = '\0';
+  return out;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void error_log_init() {
+  // Step 1: Find the ring head (newest valid record)
+  ErrorLogRecord record;
+  uint8_t newest = ERROR_LOG_SLOT_NONE;
+  uint8_t newest_boot = 0;
+
+  for (uint8_t slot = 0; slot < ERROR_LOG_SLOTS; slot++) {
+    if (!read_record(slot, &record)) continue;
+    if (newest == ERROR_LOG_SLOT_NONE || (int8_t)(record.seq - g_seq) > 0) {
+      newest = slot;
+      g_seq = record.seq;
+      newest_boot = record.boot;
+    }
+  }
+
+  // Step 2: Continue after it, as the next boot
+  if (newest == ERROR_LOG_SLOT_NONE) {
+    g_seq = 0;
+    g_next_slot = 0;
+    g_boot = 0;
+  } else {
+    g_next_slot = (newest + 1) % ERROR_LOG_SLOTS;
+    g_boot = newest_boot + 1;
+  }
+
+  g_write_pos = sizeof(ErrorLogRecord);
+  g_dump.active = false;
+  g_dump_held = false;
+}
+
+void error_log_record(SystemError code, uint16_t context) {
+  uint32_t now = timebase_millis();
+
+  // Step 1: The same error again soon after is only counted
+  // (a loop overrun repeats every late tick)
+  if (code == g_last_code && now - g_last_ms < ERROR_LOG_REPEAT_MS) {
+    g_last_ms = now;
+    if (g_repeats < UINT16_MAX) g_repeats++;
+    return;
+  }
+  g_last_code = code;
+  g_last_ms = now;
+
+  // Step 2: Append; when full keep the earlier events (they explain more)
+  uint8_t next = (g_pending_head + 1) & (ERROR_LOG_RAM_EVENTS - 1);
+  if (next == g_pending_tail) {
+    if (g_dropped < UINT16_MAX) g_dropped++;
+    return;
+  }
+
+  ErrorEvent* event = &g_pending[g_pending_head];
+  event->time_ms = now;
+  event->code = (uint8_t)code;
+  event->stage = g_state.loop_stage;
+  event->context = context;
+  g_pending_head = next;
+}
+
+void error_log_update() {
+  // Only with motors stopped by the kill switch and live stick values
+  if (!g_state.input.kill_switch || !g_state.input.link_ok ||
+      g_state.input.raw_channels[3] > ERROR_LOG_DUMP_RAW) {
+    g_dump_held = false;
+    return;
+  }
+
+  uint32_t now = timebase_millis();
+  if (!g_dump_held) {
+    g_dump_held = true;
+    g_dump_triggered = false;
+    g_dump_start_ms = now;
+    return;
+  }
+  if (g_dump_triggered || now - g_dump_start_ms < ERROR_LOG_DUMP_HOLD_MS) return;
+
+  // Start a dump (once per hold): header now, records read in idle time,
+  // oldest first
+  g_dump_triggered = true;
+  g_dump.active = true;
+  g_dump.finished = false;
+  g_dump.slot = g_next_slot;
+  g_dump.left = ERROR_LOG_SLOTS;
+  g_dump.last_ms = now - ERROR_LOG_DUMP_MS;
+
+  // "L<boot> r<repeats> d<dropped> p<profile load us>"
+  char* out = g_dump.line;
+  out = append_field(out, 'L', g_boot);
+  out = append_field(out, 'r', g_repeats);
+  out = append_field(out, 'd', g_dropped);
+  append_field(out, 'p', profiles_get_load_us());
+  g_dump.ready = true;
+}
+
+void error_log_idle() {
+  // Step 1: Continue the current write (never wait for the EEPROM)
+  if (g_write_pos < sizeof(ErrorLogRecord)) {
+    if (!eeprom_is_ready()) return;
+    eeprom_update_byte(g_write_addr + g_write_pos, ((const uint8_t*)&g_record)[g_write_pos]);
+    g_write_pos++;
+    return;
+  }
+  if (!eeprom_is_ready()) return;
+
+  // Step 2: Start writing the oldest buffered event to the next record
+  if (g_pending_tail != g_pending_head) {
+    g_record.version = ERROR_LOG_RECORD_VERSION;
+    g_record.seq = ++g_seq;
+    g_record.boot = g_boot;
+    g_record.event = g_pending[g_pending_tail];
+    g_record.crc = record_crc(&g_record);
+    g_pending_tail = (g_pending_tail + 1) & (ERROR_LOG_RAM_EVENTS - 1);
+
+    g_write_addr = (uint8_t*)ERROR_LOG_ADDR(g_next_slot);
+    g_write_pos = 0;
+    g_next_slot = (g_next_slot + 1) % ERROR_LOG_SLOTS;
+    return;
+  }
+
+  // Step 3: Read ahead the next dump line (one record per call)
+  if (!g_dump.active || g_dump.ready) return;
+  if (g_dump.left == 0) {
+    strcpy(g_dump.line, "L end");
+    g_dump.finished = true;
+    g_dump.ready = true;
+    return;
+  }
+
+  ErrorLogRecord record;
+  bool valid = read_record(g_dump.slot, &record);
+  g_dump.slot = (g_dump.slot + 1) % ERROR_LOG_SLOTS;
+  g_dump.left--;
+  if (!valid) return;
+
+  // "b<boot> e<code> s<stage> t<ms> c<context>"
+  char* out = g_dump.line;
+  out = append_field(out, 'b', record.boot);
+  out = append_field(out, 'e', record.event.code);
+  out = append_field(out, 's', record.event.stage);
+  out = append_field(out, 't', record.event.time_ms);
+  append_field(out, 'c', record.event.context);
+  g_dump.ready = true;
+}
+
+const char* error_log_dump_line() {
+  if (!g_dump.active || !g_dump.ready) return NULL;
+
+  uint32_t now = timebase_millis();
+  if (now - g_dump.last_ms < ERROR_LOG_DUMP_MS) return NULL;
+
+  g_dump.last_ms = now;
+  g_dump.ready = false;
+  if (g_dump.finished) g_dump.active = false;
+  return g_dump.line;
+}
+
+bool error_log_dumping() {
+  return g_dump.active;
+}
+
+uint8_t error_log_get_boot() {
+  return g_boot;
+}
@@ -0,0 +1,121 @@
+// gyro_mpu6050.cpp - MPU-6050 yaw-rate backend (I2C)
+// UpVote Battlebot - Phase 8
+#include "gyro.h"
+#include "config.h"
+#include "utilities.h"
+#include "timebase.h"
+
+#if GYRO_BACKEND == GYRO_BACKEND_MPU6050
+#include <Wire.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// MPU-6050 registers
+#define MPU_REG_CONFIG        0x1A  // DLPF_CFG
+#define MPU_REG_GYRO_CONFIG   0x1B  // FS_SEL
+#define MPU_REG_GYRO_ZOUT_H   0x47  // Z rate, big endian
+#define MPU_REG_PWR_MGMT_1    0x6B  // Sleep / clock select
+
+#define MPU_DLPF_44HZ         0x03  // Gyro bandwidth 42 Hz (~5ms delay)
+#define MPU_FS_2000DPS        0x18  // FS_SEL = 3
+#define MPU_CLOCK_PLL_X       0x01  // Wake up, clock from X gyro PLL
+#define MPU_LSB_PER_DPS       16.4f // At +/-2000 deg/s full scale
+
+// Raw LSB -> Q12 of YAW_RATE_MAX_DPS, as a Q16 multiplier
+#define GYRO_SCALE_Q16 \
+  ((int32_t)((float)Q12_ONE * 65536.0f / (MPU_LSB_PER_DPS * YAW_RATE_MAX_DPS) + 0.5f))
+
+// Reads that may fail in a row before the sensor is reported unhealthy
+#define GYRO_MAX_FAILURES     3
+
+// Longest wait for the bus before a transfer is abandoned (real time).
+// twi.c times it with the core's micros(), which runs
+// 64 / MOTOR_PWM_PRESCALER times fast once motor_driver_init() has retimed
+// Timer0 (see timebase.h), so it is handed over in core microseconds
+#define GYRO_WIRE_TIMEOUT_US  1000
+#define GYRO_WIRE_TIMEOUT_CORE_US  (GYRO_WIRE_TIMEOUT_US * (64 / MOTOR_PWM_PRESCALER))
+
+static int16_t g_bias;          // Zero-rate offset (raw LSB)
+static int16_t g_rate_q12;      // Latest yaw rate (Q12)
+static uint8_t g_failures;      // Consecutive failed reads
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// Write one register
+static void mpu_write(uint8_t reg, uint8_t value) {
+  Wire.beginTransmission(GYRO_I2C_ADDRESS);
+  Wire.write(reg);
+  Wire.write(value);
+  Wire.endTransmission();
+}
+
+// Read the raw Z rate, returns false on a bus error or missing device
+static bool mpu_read_z(int16_t* raw) {
+  Wire.beginTransmission(GYRO_I2C_ADDRESS);
+  Wire.write(MPU_REG_GYRO_ZOUT_H);
+  if (Wire.endTransmission(false) != 0) return false;
+
+  if (Wire.requestFrom((uint8_t)GYRO_I2C_ADDRESS, (uint8_t)2) != 2) return false;
+  uint8_t hi = Wire.read();
+  uint8_t lo = Wire.read();
+  *raw = (int16_t)((hi << 8) | lo);
+  return true;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void gyro_init() {
+  Wire.begin();
+  Wire.setClock(400000);           // Fast mode: 2-byte read takes ~100us
+  Wire.setWireTimeout(GYRO_WIRE_TIMEOUT_CORE_US, true);   // Never hang the control loop on a stuck bus
+
+  mpu_write(MPU_REG_PWR_MGMT_1, MPU_CLOCK_PLL_X);
+  mpu_write(MPU_REG_CONFIG, MPU_DLPF_44HZ);
+  mpu_write(MPU_REG_GYRO_CONFIG, MPU_FS_2000DPS);
+  timebase_delay_ms(50);  // Gyro start-up time
+
+  // Average the zero-rate output while the robot is still
+  int32_t sum = 0;
+  uint8_t good = 0;
+  for (uint8_t i = 0; i < GYRO_BIAS_SAMPLES; i++) {
+    int16_t raw;
+    if (mpu_read_z(&raw)) {
+      sum += raw;
+      good++;
+    }
+    timebase_delay_ms(1);
+  }
+
+  g_bias = (good > 0) ? (int16_t)(sum / good) : 0;
+  g_rate_q12 = 0;
+  g_failures = (good == GYRO_BIAS_SAMPLES) ? 0 : GYRO_MAX_FAILURES;
+}
+
+void gyro_update() {
+  int16_t raw;
+  if (!mpu_read_z(&raw)) {
+    if (g_failures < GYRO_MAX_FAILURES) g_failures++;
+    return;  // Keep last rate; controller drops to open loop once unhealthy
+  }
+  g_failures = 0;
+
+  int32_t rate = (((int32_t)raw - g_bias) * GYRO_SCALE_Q16) >> 16;
+  if (GYRO_YAW_INVERTED) rate = -rate;
+  g_rate_q12 = (int16_t)constrain(rate, -INT16_MAX, INT16_MAX);
+}
+
+int16_t gyro_get_yaw_rate() {
+  return g_rate_q12;
+}
+
+bool gyro_is_healthy() {
+  return g_failures < GYRO_MAX_FAILURES;
+}
+
+#endif // GYRO_BACKEND_MPU6050
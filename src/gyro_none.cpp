@@ -0,0 +1,26 @@
+// gyro_none.cpp - Gyro interface stub (no sensor fitted)
+// UpVote Battlebot - Phase 8
+#include "gyro.h"
+#include "config.h"
+
+#if GYRO_BACKEND == GYRO_BACKEND_NONE
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void gyro_init() {
+}
+
+void gyro_update() {
+}
+
+int16_t gyro_get_yaw_rate() {
+  return 0;
+}
+
+bool gyro_is_healthy() {
+  return false;
+}
+
+#endif // GYRO_BACKEND_NONE
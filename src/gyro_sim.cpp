@@ -0,0 +1,80 @@
+// gyro_sim.cpp - Simulated yaw-rate backend (chassis model with disturbances)
+// UpVote Battlebot - Phase 8
+#include "gyro.h"
+#include "config.h"
+#include "state.h"
+#include "utilities.h"
+#include "mixer_presets.h"
+
+#if GYRO_BACKEND == GYRO_BACKEND_SIM
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Rotation column of the mixer matrix: how much each wheel turns the chassis
+static const int16_t g_mixer_matrix[4][3] = MIXER_MATRIX;
+
+// Disturbances in Q12
+#define GYRO_SIM_DRIFT_Q12  Q12_FROM_FLOAT(GYRO_SIM_DRIFT)
+#define GYRO_SIM_HIT_Q12    Q12_FROM_FLOAT(GYRO_SIM_HIT)
+#define GYRO_SIM_HIT_TICKS  (GYRO_SIM_HIT_PERIOD_MS / LOOP_PERIOD_MS)
+
+static int16_t g_rate_q12;      // Simulated chassis yaw rate (Q12)
+static uint16_t g_hit_ticks;    // Ticks until the next hit
+static int16_t g_full_drive;    // Rotation drive at full duty on every wheel
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void gyro_init() {
+  g_rate_q12 = 0;
+  g_hit_ticks = GYRO_SIM_HIT_TICKS;
+
+  // Sum of |rotation coefficient| * full duty, in PWM counts
+  int32_t full = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    full += (int32_t)abs(g_mixer_matrix[i][2]) * MOTOR_PWM_MAX;
+  }
+  g_full_drive = (int16_t)(full >> Q12_SHIFT);
+}
+
+void gyro_update() {
+  // Step 1: Rotation the wheels are asking for (last tick's outputs, wheel frame)
+  const int16_t out[4] = {
+    g_state.output.motor_rl_pwm, g_state.output.motor_rr_pwm,
+    g_state.output.motor_fl_pwm, g_state.output.motor_fr_pwm
+  };
+  int32_t drive = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    drive += (int32_t)g_mixer_matrix[i][2] * out[i];
+  }
+  // Full duty on every wheel = full rate (drive is Q12 * PWM counts)
+  int32_t target = (g_full_drive > 0) ? drive / g_full_drive : 0;
+
+  // Step 2: Constant drift (one side slipping / dragging)
+  target += GYRO_SIM_DRIFT_Q12;
+
+  // Step 3: First-order chassis response
+  int32_t rate = g_rate_q12;
+  rate += (target - rate) >> GYRO_SIM_TAU_SHIFT;
+
+  // Step 4: Periodic hit spins the chassis
+  if (--g_hit_ticks == 0) {
+    g_hit_ticks = GYRO_SIM_HIT_TICKS;
+    rate += GYRO_SIM_HIT_Q12;
+  }
+
+  g_rate_q12 = (int16_t)constrain(rate, -INT16_MAX, INT16_MAX);
+}
+
+int16_t gyro_get_yaw_rate() {
+  return g_rate_q12;
+}
+
+bool gyro_is_healthy() {
+  return true;
+}
+
+#endif // GYRO_BACKEND_SIM
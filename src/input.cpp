@@ -5,6 +5,15 @@
 #include "state.h"
 #include "safety.h"
 #include "mixing.h"
+#include "profiles.h"
+#include "crsf_uart.h"
+#include "weapon.h"
+#include "weapon_rpm.h"
+#include "error_log.h"
+#include "diagnostics.h"
+#include "blackbox.h"
+#include "utilities.h"
+#include "timebase.h"
 
 // ============================================================================
 // ALFREDO CRSF LIBRARY INSTANCE
@@ -13,10 +22,27 @@
 // Global CRSF instance
 AlfredoCRSF crsf;
 
+// Link events for the error log
+static bool g_link_was_ok;
+static uint16_t g_link_losses;
+static uint16_t g_crc_errors_logged;
+static uint16_t g_kill_latency_logged;
+
+// RPM sensor frame (not in the library's frame type list)
+// Payload: [source id] then one 24-bit signed RPM per motor, big endian
+#define CRSF_FRAMETYPE_RPM  0x0C
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
 
+// Store a 24-bit value big endian (CRSF byte order)
+static inline void put_be24(uint8_t* dst, uint32_t value) {
+  dst[0] = (value >> 16) & 0xFF;
+  dst[1] = (value >> 8) & 0xFF;
+  dst[2] = value & 0xFF;
+}
+
 // Decode 3-position switch from microseconds
 // us < 1200 = position 0 (low)
 // 1200 <= us < 1800 = position 1 (mid)
@@ -32,20 +58,43 @@ static uint8_t decode_3pos_switch_us(uint16_t us) {
 // ============================================================================
 
 void input_init() {
-  // Initialize AlfredoCRSF library on Hardware Serial
+  // Initialize AlfredoCRSF library on the interrupt-driven UART
+  // (crsf_uart.cpp also runs the fast kill path in its receive interrupt)
   // CRSF uses 420000 baud (defined in library as CRSF_BAUDRATE)
-  Serial.begin(CRSF_BAUDRATE);
-  crsf.begin(Serial);
+  CrsfSerial.begin(CRSF_BAUDRATE);
+  crsf.begin(CrsfSerial);
 }
 
 void input_update() {
   // Update CRSF library (reads serial, parses packets)
   crsf.update();
 
-  // Check link status
-  g_state.input.link_ok = crsf.isLinkUp();
+  // Check link status (newest valid RC frame seen by the receive interrupt,
+  // timed on the rescaled timebase - not crsf.isLinkUp(), whose timeout
+  // runs on the core's millis())
+  g_state.input.link_ok = crsf_uart_link_up();
   if (g_state.input.link_ok) {
-    g_state.input.last_packet_ms = millis();
+    g_state.input.last_packet_ms = timebase_millis();
+  }
+
+  // Phase 8: Log link losses (context: losses this boot), bad RC frame
+  // CRCs (context: count since boot) and each new worst kill latency
+  // (context: us); none of them latch an error
+  if (g_link_was_ok && !g_state.input.link_ok) {
+    error_log_record(ERR_CRSF_TIMEOUT, ++g_link_losses);
+  }
+  g_link_was_ok = g_state.input.link_ok;
+
+  uint16_t crc_errors = crsf_uart_get_crc_errors();
+  if (crc_errors != g_crc_errors_logged) {
+    g_crc_errors_logged = crc_errors;
+    error_log_record(ERR_CRSF_CRC, crc_errors);
+  }
+
+  uint16_t kill_latency = crsf_uart_get_kill_latency_us();
+  if (kill_latency > g_kill_latency_logged) {
+    g_kill_latency_logged = kill_latency;
+    error_log_record(ERR_KILL_LATENCY, kill_latency);
   }
 
   // Read RC channels (getChannel returns microseconds, 1-based indexing)
@@ -58,6 +107,7 @@ void input_update() {
   uint16_t ch6_us = crsf.getChannel(6);   // Arm switch (SA)
   uint16_t ch7_us = crsf.getChannel(7);   // Self-right switch (SH)
   uint16_t ch8_us = crsf.getChannel(8);   // Drive mode switch (SB)
+  uint16_t ch9_us = crsf.getChannel(9);   // Left stick Y (tank mixing only)
 
   // Convert microseconds to 11-bit CRSF values for integer mixing
   // Library returns ~988-2012µs, CRSF 11-bit is 172-1811
@@ -69,6 +119,7 @@ void input_update() {
   g_state.input.raw_channels[6] = map(ch7_us, 988, 2012, 172, 1811);  // CH7: Self-right
   g_state.input.raw_channels[7] = map(ch8_us, 988, 2012, 172, 1811);  // CH8: Drive mode
   g_state.input.raw_channels[2] = map(ch3_us, 988, 2012, 172, 1811);  // CH3: Kill (SF)
+  g_state.input.raw_channels[8] = map(ch9_us, 988, 2012, 172, 1811);  // CH9: Left stick Y
 
   // Decode switches (3-position)
   uint8_t arm_switch_pos = decode_3pos_switch_us(ch6_us);       // CH6: Arm Switch (SA)
@@ -91,14 +142,31 @@ void input_update() {
   // Drive mode: 0=Beginner, 1=Normal, 2=Aggressive
   mixing_set_drive_mode((DriveMode)drive_mode_pos);
 
-  // Weapon throttle: map from microseconds to 0.0-1.0 range
+  // Weapon throttle: map from microseconds to Q12 [0, Q12_ONE] (no float)
   // Weapon uses unipolar control (0-100%), not bipolar (-100 to +100%)
-  g_state.input.weapon = constrain(map(ch5_us, 988, 2012, 0, 100), 0, 100) / 100.0f;
+  g_state.input.weapon = constrain(map(ch5_us, 988, 2012, 0, Q12_ONE), 0, Q12_ONE);
 }
 
 void input_update_telemetry() {
+#if CRSF_TELEMETRY_ENABLED
+  // Phase 8: Error log dump - one stored event per flight mode frame
+  const char* dump_line = error_log_dump_line();
+  if (dump_line != NULL) {
+    crsf.queuePacket(CRSF_ADDRESS_FLIGHT_CONTROLLER, CRSF_FRAMETYPE_FLIGHT_MODE,
+                     dump_line, strlen(dump_line) + 1);
+  }
+
+  // Phase 8: Black-box dump - raw frames on the UART for the host decoder
+  uint8_t blackbox_payload[BLACKBOX_DUMP_PAYLOAD_MAX];
+  uint8_t blackbox_len = blackbox_dump_frame(blackbox_payload);
+  if (blackbox_len > 0) {
+    crsf.queuePacket(CRSF_ADDRESS_FLIGHT_CONTROLLER, CRSF_FRAMETYPE_BLACKBOX,
+                     blackbox_payload, blackbox_len);
+  }
+#endif
+
   // Rate limit telemetry updates (1 Hz by default)
-  uint32_t now = millis();
+  uint32_t now = timebase_millis();
   if (now - g_state.battery.last_telemetry_ms < TELEMETRY_UPDATE_MS) {
     return;
   }
@@ -116,7 +184,7 @@ void input_update_telemetry() {
   float v_battery = v_adc * BATTERY_DIVIDER_RATIO;
 
   // Store in state for other modules to access
-  g_state.battery.voltage = v_battery;
+  g_state.battery.voltage_mv = (uint16_t)(v_battery * 1000.0f);
 
   // ========================================================================
   // STEP 2: Calculate battery percentage
@@ -132,7 +200,8 @@ void input_update_telemetry() {
   // CRSF battery sensor payload (8 bytes):
   // - voltage: uint16_t, V * 10, big endian
   // - current: uint16_t, A * 10, big endian
-  // - capacity: uint24_t (3 bytes), mAh, big endian
+  // - capacity: uint24_t (3 bytes), mAh, big endian - carries the worst-case
+  //   free RAM in bytes instead (Phase 8, shown as "Capa" on the TX16S)
   // - remaining: uint8_t, percentage
 
   // Convert voltage to CRSF format (V * 10)
@@ -147,9 +216,7 @@ void input_update_telemetry() {
   payload[1] = voltage_raw & 0xFF;           // voltage low byte
   payload[2] = 0;                            // current high byte (not measured)
   payload[3] = 0;                            // current low byte
-  payload[4] = 0;                            // capacity high byte
-  payload[5] = 0;                            // capacity mid byte
-  payload[6] = 0;                            // capacity low byte
+  put_be24(&payload[4], diagnostics_get_stack_headroom());  // capacity: stack headroom
   payload[7] = g_state.battery.percentage;   // remaining percentage
 
   // ========================================================================
@@ -162,5 +229,36 @@ void input_update_telemetry() {
     payload,                          // Payload data
     sizeof(payload)                   // Payload length (8 bytes)
   );
+
+  // ========================================================================
+  // STEP 5: Send active drive profile name as the flight mode
+  // ========================================================================
+  // Shown on the TX16S telemetry screen - confirms profile selection
+  // (left to the error log while it is dumping)
+  if (!error_log_dumping()) {
+    const DriveProfile* profile = profiles_get(mixing_get_drive_mode());
+    crsf.queuePacket(
+      CRSF_ADDRESS_FLIGHT_CONTROLLER,  // Source address (we are the FC)
+      CRSF_FRAMETYPE_FLIGHT_MODE,      // Frame type 0x21
+      profile->name,                    // NUL-terminated string
+      strlen(profile->name) + 1         // Payload length including NUL
+    );
+  }
+
+  // ========================================================================
+  // STEP 6: Send weapon RPM (measured, then target) when there is a sensor
+  // ========================================================================
+  if (weapon_rpm_available()) {
+    uint8_t rpm_payload[7];
+    rpm_payload[0] = 0;                                  // Source id
+    put_be24(&rpm_payload[1], weapon_rpm_get());         // RPM1: measured
+    put_be24(&rpm_payload[4], weapon_get_target_rpm());  // RPM2: target
+    crsf.queuePacket(
+      CRSF_ADDRESS_FLIGHT_CONTROLLER,  // Source address (we are the FC)
+      CRSF_FRAMETYPE_RPM,              // Frame type 0x0C
+      rpm_payload,                      // Payload data
+      sizeof(rpm_payload)               // Payload length (7 bytes)
+    );
+  }
 #endif // CRSF_TELEMETRY_ENABLED
 }
@@ -4,6 +4,8 @@
 // Phase 4: Holonomic Mixing
 // Phase 5: Weapon Control
 // Phase 6: Servo Control
+// Phase 8: Motor Performance (thermal model, motor compensation, yaw-rate and wheel speed control,
+//          weapon RPM governor)
 #include <Arduino.h>
 #include "config.h"
 #include "state.h"
@@ -14,6 +16,15 @@
 #include "mixing.h"
 #include "weapon.h"
 #include "servo.h"
+#include "thermal.h"
+#include "motor_comp.h"
+#include "gyro.h"
+#include "encoders.h"
+#include "weapon_rpm.h"
+#include "profiles.h"
+#include "timebase.h"
+#include "error_log.h"
+#include "blackbox.h"
 
 // ============================================================================
 // CONTROL LOOP TIMING
@@ -30,6 +41,9 @@ void setup() {
   // before any other code runs
   actuators_init();
 
+  // Phase 8: Find the error history in EEPROM (before anything logs)
+  error_log_init();
+
   // Initialize safety system
   safety_init();
 
@@ -39,17 +53,38 @@ void setup() {
   // Phase 2: Initialize CRSF receiver input
   input_init();
 
+  // Phase 8: Initialize L293D thermal model (before mixing uses duty limits)
+  thermal_init();
+
+  // Phase 8: Load per-motor compensation (calibrated values from EEPROM)
+  motor_comp_init();
+
+  // Phase 8: Load drive profiles into RAM (EEPROM, or compiled defaults)
+  profiles_init();
+
+  // Phase 8: Initialize gyro and measure its bias (robot must be still)
+  gyro_init();
+
+  // Phase 8: Initialize wheel encoders
+  encoders_init();
+
   // Phase 4: Initialize holonomic mixing
   mixing_init();
 
+  // Phase 8: Initialize weapon RPM measurement
+  weapon_rpm_init();
+
   // Phase 5: Initialize weapon control
   weapon_init();
 
   // Phase 6: Initialize servo control
   servo_init();
 
+  // Phase 8: Start the black-box recording (after safety_init: boot errors known)
+  blackbox_init();
+
   // Initialize loop timing
-  next_loop_us = micros() + LOOP_PERIOD_US;
+  next_loop_us = timebase_micros() + LOOP_PERIOD_US;
 }
 
 // ============================================================================
@@ -57,12 +92,21 @@ void setup() {
 // ============================================================================
 void loop() {
   // Wait for next loop iteration (maintains 100 Hz rate)
-  uint32_t now_us = micros();
+  uint32_t now_us = timebase_micros();
   if (now_us < next_loop_us) {
     // Still have time before next iteration
     // QA fix H3: Add power management here in future
     // For now, early return is acceptable for battlebot (always-on requirement)
     // TODO Phase 2+: Consider SLEEP_MODE_IDLE for power savings if needed
+
+    // Phase 8: DShot stop frame owed by a kill from the receive interrupt
+    actuators_idle();
+
+    // Phase 8: Background EEPROM work (never blocks, keeps it out of the loop body)
+    profiles_idle();
+    error_log_idle();
+    motor_comp_idle();
+    diagnostics_idle();
     return;
   }
 
@@ -74,7 +118,9 @@ void loop() {
   // Recovery: Next loop will try to catch up (acceptable for Phase 1)
   // Future phases may add reduced functionality mode if needed
   if (now_us > next_loop_us + LOOP_PERIOD_US) {
-    safety_set_error(ERR_LOOP_OVERRUN);
+    // Context: how late this tick started (microseconds, saturated)
+    uint32_t late_us = now_us - next_loop_us;
+    safety_set_error(ERR_LOOP_OVERRUN, (late_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)late_us);
   }
 
   // Schedule next loop iteration
@@ -88,39 +134,68 @@ void loop() {
   safety_watchdog_reset();
 
   // Phase 2: Process CRSF receiver input
+  g_state.loop_stage = STAGE_INPUT;
   input_update();
 
+  // Phase 8: Drive profile selection and error log dump gestures (kill switch active)
+  g_state.loop_stage = STAGE_PROFILES;
+  profiles_update();
+  error_log_update();
+
   // Phase 2.5: Send telemetry to TX16S (1 Hz)
+  g_state.loop_stage = STAGE_TELEMETRY;
   input_update_telemetry();
 
+  // Phase 8: Read yaw rate and wheel speeds for the closed loops
+  g_state.loop_stage = STAGE_SENSORS;
+  gyro_update();
+  encoders_update();
+
+  // Phase 6: Servo control (self-righting mechanism)
+  // Before mixing - a self-right sequence can kick the drive motors
+  g_state.loop_stage = STAGE_SERVO;
+  servo_update();
+
   // Phase 4: Holonomic drive mixing
+  g_state.loop_stage = STAGE_MIXING;
   // Only update mixing if link is OK and kill switch is not active
   if (g_state.input.link_ok && !g_state.input.kill_switch) {
-    mixing_update();
+    if (motor_comp_calibrating()) {
+      // Phase 8: Motor compensation sweep replaces driving until finished
+      motor_comp_calibration_update();
+    } else {
+      mixing_update();
+    }
   } else {
     // Kill switch active or link lost - stop all motors immediately
-    actuators_set_motor(0, 0);
-    actuators_set_motor(1, 0);
-    actuators_set_motor(2, 0);
-    actuators_set_motor(3, 0);
+    mixing_stop();
+    motor_comp_calibration_hold();
   }
 
+  // Phase 8: Weapon speed for the RPM governor
+  g_state.loop_stage = STAGE_WEAPON;
+  weapon_rpm_update();
+
   // Phase 5: Weapon control (arming state machine + output scaling)
   weapon_update();
 
-  // Phase 6: Servo control (self-righting mechanism)
-  servo_update();
-
   // Update all actuator outputs
+  g_state.loop_stage = STAGE_ACTUATORS;
   actuators_update();
 
   // Phase 1.5: Update LED diagnostics
+  g_state.loop_stage = STAGE_DIAGNOSTICS;
   diagnostics_update();
 
+  // Phase 8: Record this tick's inputs and outputs in the black box
+  blackbox_update();
+  g_state.loop_stage = STAGE_IDLE;
+
   // ========================================================================
   // END OF CONTROL LOOP
   // ========================================================================
 
-  // Record loop execution time for profiling
-  g_state.loop_duration_us = micros() - g_state.loop_start_us;
+  // Record loop execution time for profiling (saturated)
+  uint32_t duration_us = timebase_micros() - g_state.loop_start_us;
+  g_state.loop_duration_us = (duration_us > UINT16_MAX) ? UINT16_MAX : (uint16_t)duration_us;
 }
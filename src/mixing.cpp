@@ -4,6 +4,14 @@
 #include "config.h"
 #include "state.h"
 #include "actuators.h"
+#include "utilities.h"
+#include "curves.h"
+#include "profiles.h"
+#include "mixer_presets.h"
+#include "mixer_policies.h"
+#include "yaw_control.h"
+#include "speed_control.h"
+#include "servo.h"
 
 // ============================================================================
 // PRIVATE STATE
@@ -12,25 +20,314 @@
 // Current drive mode
 static DriveMode g_drive_mode = DRIVE_MODE_NORMAL;
 
+// Profile generation the cached parameters were built from
+static uint8_t g_profile_generation;
+
+// Mixing strategy: one compiled pipeline when every mode shares a policy,
+// otherwise a pipeline per policy selected on mode change
+#if BEGINNER_MIXER == NORMAL_MIXER && NORMAL_MIXER == AGGRESSIVE_MIXER
+#define MIXER_SINGLE_POLICY 1
+typedef MixerPolicyFor<NORMAL_MIXER>::type BuildMixer;
+#else
+#define MIXER_SINGLE_POLICY 0
+typedef void (*MixerPipeline)();
+static MixerPipeline g_mixer_pipeline;
+static MixerPipeline pipeline_for(uint8_t policy);
+#endif
+
 // Current mode parameters (cached for performance)
 static struct {
-  uint8_t max_duty;  // Maximum PWM duty cycle for this mode
-  float expo;        // Exponential curve factor
+  uint8_t max_duty;         // Maximum PWM duty cycle for this mode
+  DesatStrategy desat;      // Saturation handling for this mode
+  const int16_t* curve_x;   // Strafe response curve (PROGMEM)
+  const int16_t* curve_y;   // Forward response curve (PROGMEM)
+  const int16_t* curve_r;   // Rotation response curve (PROGMEM)
+  int16_t rotation_scale;   // Rotation sensitivity (Q12)
+  SCurveLimits shape[3];    // Motion shaping limits [X, Y, R]
 } g_mode_params;
 
+// Shaped chassis command [X, Y, R] (Q12)
+static SCurveState g_shaper[3];
+
+// CRSF 11-bit stick range: 172 (min) - 992 (center) - 1811 (max)
+// Deadband: ~5% around center = ~41 counts each side (950-1033)
+#define STICK_CENTER    992
+#define STICK_DEADBAND   41   // ~5% of full range
+#define STICK_MIN       172
+#define STICK_MAX      1811
+
+// Q12 reciprocal of each half-range span (x * RECIP >> 16 == x * 4096 / span)
+#define STICK_SPAN_POS  (STICK_MAX - STICK_CENTER - STICK_DEADBAND)  // 778
+#define STICK_SPAN_NEG  (STICK_CENTER - STICK_DEADBAND - STICK_MIN)  // 779
+#define STICK_RECIP_POS ((((uint32_t)Q12_ONE << 16) + STICK_SPAN_POS / 2) / STICK_SPAN_POS)
+#define STICK_RECIP_NEG ((((uint32_t)Q12_ONE << 16) + STICK_SPAN_NEG / 2) / STICK_SPAN_NEG)
+
+// Mixer matrix [motor][axis] in Q12 (motor order RL, RR, FL, FR; axes X, Y, R)
+static const int16_t g_mixer_matrix[4][3] = MIXER_MATRIX;
+
+// Per-motor output scaling in Q12
+static const int16_t g_mixer_scale[4] = MIXER_MOTOR_SCALE;
+
 // ============================================================================
 // PRIVATE HELPER FUNCTIONS
 // ============================================================================
 
-// Apply exponential curve to input
-// input: Normalized input [-1.0, +1.0]
-// expo: Expo factor [0.0, 1.0] (0 = linear, 1 = full exponential)
-// Returns: Expo-curved output [-1.0, +1.0]
-static float apply_expo(float input, float expo) {
-  // Expo formula: output = expo*input^3 + (1-expo)*input
-  // This preserves sign and creates a smooth curve
-  float input_cubed = input * input * input;
-  return expo * input_cubed + (1.0f - expo) * input;
+// Normalize a raw stick channel with deadband (integer pipeline)
+// raw: CRSF 11-bit value (172-1811)
+// Returns: Q12 value [-4096, +4096] (0 inside deadband)
+static int16_t normalize_axis_q12(int16_t raw) {
+  int16_t offset = raw - STICK_CENTER;
+
+  if (abs(offset) < STICK_DEADBAND) {
+    return 0;
+  } else if (offset > 0) {
+    return (int16_t)(((uint32_t)(offset - STICK_DEADBAND) * STICK_RECIP_POS) >> 16);
+  } else {
+    return -(int16_t)(((uint32_t)(-offset - STICK_DEADBAND) * STICK_RECIP_NEG) >> 16);
+  }
+}
+
+// Convert a profile ramp time (ms) to a Q12 rate per tick
+// Rounds up so a non-zero time never becomes a zero rate; 0 ms = unlimited
+static int16_t shape_rate(uint16_t ms) {
+  if (ms == 0) return INT16_MAX;
+  uint32_t rate = ((uint32_t)Q12_ONE * LOOP_PERIOD_MS + ms - 1) / ms;
+  return (rate > INT16_MAX) ? INT16_MAX : (int16_t)rate;
+}
+
+// Jerk limit: build up to the (faster) decel rate within jerk_ms
+static int16_t shape_step(uint16_t decel_ms, uint16_t jerk_ms) {
+  if (decel_ms == 0 || jerk_ms == 0) return INT16_MAX;
+  uint32_t step = ((uint32_t)shape_rate(decel_ms) * LOOP_PERIOD_MS + jerk_ms - 1) / jerk_ms;
+  return (step > INT16_MAX) ? INT16_MAX : (int16_t)step;
+}
+
+// Update mode parameters cache from current drive mode and its profile
+// Runs only on a mode or profile change, so the divides stay out of the
+// per-tick path
+static void update_mode_params() {
+  switch (g_drive_mode) {
+    case DRIVE_MODE_BEGINNER:
+      g_mode_params.desat = BEGINNER_DESAT;
+      break;
+
+    case DRIVE_MODE_AGGRESSIVE:
+      g_mode_params.desat = AGGRESSIVE_DESAT;
+      break;
+
+    case DRIVE_MODE_NORMAL:
+    default:
+      g_mode_params.desat = NORMAL_DESAT;
+      break;
+  }
+
+  // Profile mapped to this switch position (RAM copy, same NORMAL fallback)
+  uint8_t mode_index = (g_drive_mode <= DRIVE_MODE_AGGRESSIVE) ? g_drive_mode : DRIVE_MODE_NORMAL;
+  const DriveProfile* profile = profiles_get(mode_index);
+  g_profile_generation = profiles_get_generation();
+
+  g_mode_params.max_duty = profile->max_duty;
+  g_mode_params.curve_x = curves_get(profile->curve[CURVE_AXIS_X]);
+  g_mode_params.curve_y = curves_get(profile->curve[CURVE_AXIS_Y]);
+  g_mode_params.curve_r = curves_get(profile->curve[CURVE_AXIS_R]);
+  g_mode_params.rotation_scale = (int16_t)(((uint32_t)profile->rotation_pct * Q12_ONE + 50) / 100);
+
+  // Motion shaping limits [X, Y, R]
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    g_mode_params.shape[axis].rate_away = shape_rate(profile->accel_ms[axis]);
+    g_mode_params.shape[axis].rate_toward = shape_rate(profile->decel_ms[axis]);
+    g_mode_params.shape[axis].rate_step = shape_step(profile->decel_ms[axis], profile->jerk_ms);
+  }
+
+#if !MIXER_SINGLE_POLICY
+  // Mixing strategy (same NORMAL fallback)
+  static const uint8_t mode_policy[3] = { BEGINNER_MIXER, NORMAL_MIXER, AGGRESSIVE_MIXER };
+  g_mixer_pipeline = pipeline_for(mode_policy[mode_index]);
+#endif
+}
+
+// Stick reader for the mixer policies (see mixer_policies.h)
+// Deadband, then the profile's response curve for the chassis axis the
+// stick feeds (table lookup + interpolation)
+struct ProfileSticks {
+  static inline __attribute__((always_inline)) int16_t x(uint8_t stick) {
+    return curve_eval(g_mode_params.curve_x, normalize_axis_q12(g_state.input.raw_channels[stick]));
+  }
+  static inline __attribute__((always_inline)) int16_t y(uint8_t stick) {
+    return curve_eval(g_mode_params.curve_y, normalize_axis_q12(g_state.input.raw_channels[stick]));
+  }
+  // Rotation also applies the profile's rotation sensitivity
+  static inline __attribute__((always_inline)) int16_t r(uint8_t stick) {
+    return q12_mul(curve_eval(g_mode_params.curve_r, normalize_axis_q12(g_state.input.raw_channels[stick])),
+                   g_mode_params.rotation_scale);
+  }
+};
+
+// Read the sticks and produce the shaped chassis command (Q12)
+// Policy maps the sticks to chassis axes, then jerk-limited motion shaping
+// per axis. Shaping acts on chassis velocity rather than individual wheels,
+// so all wheels ramp in proportion and the direction of travel follows the
+// stick. A policy without strafe commands X = 0, which also ramps out any
+// strafe left over from a mode that had it.
+template <class Policy>
+static inline __attribute__((always_inline)) void read_chassis_command(int16_t* x_q12, int16_t* y_q12, int16_t* r_q12) {
+  int16_t x, y, r;
+  Policy::template chassis<ProfileSticks>(&x, &y, &r);
+
+  // Apply per-axis accel/decel/jerk limits
+  scurve_update(&g_shaper[0], x, &g_mode_params.shape[0]);
+  scurve_update(&g_shaper[1], y, &g_mode_params.shape[1]);
+  scurve_update(&g_shaper[2], r, &g_mode_params.shape[2]);
+
+  // Self-right drive kick on top, not shaped (it is meant to be sharp)
+  *x_q12 = g_shaper[0].value;
+  *y_q12 = constrain(g_shaper[1].value + servo_get_drive_kick(), -Q12_ONE, Q12_ONE);
+  *r_q12 = g_shaper[2].value;
+
+#if GYRO_BACKEND != GYRO_BACKEND_NONE
+  // Closed-loop yaw: shaped yaw is a rate command, the gyro trims it
+  bool driving = (*x_q12 != 0) || (*y_q12 != 0) || (*r_q12 != 0);
+  *r_q12 = yaw_control_update(*r_q12, driving);
+#endif
+}
+
+// Multiply an axis value by a compile-time mixer coefficient
+// Unit and zero coefficients fold to add/subtract/nothing once inlined
+static inline __attribute__((always_inline)) int16_t mixer_term(int16_t coef, int16_t value) {
+  if (coef == 0) return 0;
+  if (coef == Q12_ONE) return value;
+  if (coef == -Q12_ONE) return -value;
+  return q12_mul(coef, value);
+}
+
+// Evaluate one matrix row (multiply-accumulate plus per-motor scale)
+// motor must be a constant at the call site so coefficients fold
+static inline __attribute__((always_inline)) int16_t mixer_row(uint8_t motor, int16_t x, int16_t y, int16_t r) {
+  int16_t sum = mixer_term(g_mixer_matrix[motor][0], x) +
+                mixer_term(g_mixer_matrix[motor][1], y) +
+                mixer_term(g_mixer_matrix[motor][2], r);
+  return mixer_term(g_mixer_scale[motor], sum);
+}
+
+#if MIXING_FIXED_POINT
+// Scale a Q12 wheel value to a PWM command, truncating toward zero
+// gain: PWM counts per Q12 unit in Q16 (max_duty * 65536 / full_scale)
+static int16_t scale_to_pwm(int16_t value, uint16_t gain) {
+  if (value >= 0) {
+    return (int16_t)(((uint32_t)value * gain) >> 16);
+  }
+  return -(int16_t)(((uint32_t)(-value) * gain) >> 16);
+}
+
+// Find the largest |value| across the four wheels (Q12)
+static uint16_t max_abs4(const int16_t* values) {
+  uint16_t max_abs = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    if ((uint16_t)abs(values[i]) > max_abs) max_abs = abs(values[i]);
+  }
+  return max_abs;
+}
+
+// Priority desaturation: preserve one component, shed the other
+// keep: Wheel contributions that must be preserved (Q12)
+// shed: Wheel contributions that are scaled back first (Q12)
+// wheel: Output wheel commands, |wheel| <= 1.0 (Q12)
+// If keep alone saturates it is scaled uniformly and shed is dropped;
+// otherwise shed is scaled by the largest s in [0, 1] that fits every wheel
+static void desaturate_priority(const int16_t* keep, const int16_t* shed, int16_t* wheel) {
+  // Step 1: Preserved component saturates on its own - fit it, drop the rest
+  uint16_t keep_max = max_abs4(keep);
+  if (keep_max > Q12_ONE) {
+    int16_t scale = (int16_t)(((uint32_t)Q12_ONE << Q12_SHIFT) / keep_max);
+    for (uint8_t i = 0; i < 4; i++) {
+      wheel[i] = q12_mul(keep[i], scale);
+    }
+    return;
+  }
+
+  // Step 2: s = min over wheels of headroom / |shed| (kept as a fraction,
+  // compared by cross-multiplication so only one divide is needed)
+  uint16_t best_num = 1;
+  uint16_t best_den = 1;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (shed[i] == 0) continue;
+    uint16_t den = abs(shed[i]);
+    uint16_t headroom = Q12_ONE - (shed[i] > 0 ? keep[i] : -keep[i]);
+    if ((uint32_t)headroom * best_den < (uint32_t)best_num * den) {
+      best_num = headroom;
+      best_den = den;
+    }
+  }
+
+  int16_t scale = Q12_ONE;
+  if (best_num < best_den) {
+    scale = (int16_t)(((uint32_t)best_num << Q12_SHIFT) / best_den);
+  }
+
+  for (uint8_t i = 0; i < 4; i++) {
+    wheel[i] = keep[i] + q12_mul(shed[i], scale);
+  }
+}
+
+// Perform mixing using the Q12 integer pipeline
+// One 32-bit divide per tick (normalization), no floating point
+template <class Policy>
+static void mixing_update_fixed() {
+  int16_t max_duty = g_mode_params.max_duty;
+
+  // Shaped chassis command (deadband, curves, motion limits)
+  int16_t x_q12, y_q12, r_q12;
+  read_chassis_command<Policy>(&x_q12, &y_q12, &r_q12);
+
+  // Matrix mixing (max |sum| = 3 * 4096 for unit coefficients, fits int16_t)
+  int16_t wheel[4];
+  if (g_mode_params.desat == DESAT_UNIFORM) {
+    wheel[0] = mixer_row(0, x_q12, y_q12, r_q12);  // Rear-Left
+    wheel[1] = mixer_row(1, x_q12, y_q12, r_q12);  // Rear-Right
+    wheel[2] = mixer_row(2, x_q12, y_q12, r_q12);  // Front-Left
+    wheel[3] = mixer_row(3, x_q12, y_q12, r_q12);  // Front-Right
+  } else {
+    // Split into translation and rotation contributions per wheel
+    int16_t translation[4];
+    int16_t rotation[4];
+    translation[0] = mixer_row(0, x_q12, y_q12, 0);
+    translation[1] = mixer_row(1, x_q12, y_q12, 0);
+    translation[2] = mixer_row(2, x_q12, y_q12, 0);
+    translation[3] = mixer_row(3, x_q12, y_q12, 0);
+    rotation[0] = mixer_row(0, 0, 0, r_q12);
+    rotation[1] = mixer_row(1, 0, 0, r_q12);
+    rotation[2] = mixer_row(2, 0, 0, r_q12);
+    rotation[3] = mixer_row(3, 0, 0, r_q12);
+
+    if (g_mode_params.desat == DESAT_YAW_PRIORITY) {
+      desaturate_priority(rotation, translation, wheel);
+    } else {
+      desaturate_priority(translation, rotation, wheel);
+    }
+  }
+
+  // Find saturation: full scale is max(1.0, max |wheel|)
+  // (priority strategies already fit, this only absorbs rounding)
+  uint16_t max_abs = max_abs4(wheel);
+  if (max_abs < Q12_ONE) max_abs = Q12_ONE;
+
+  // Fold normalization and max_duty scaling into a single Q16 gain
+  uint16_t gain = (uint16_t)(((uint32_t)max_duty << 16) / max_abs);
+
+  // Send to motors (M1: RL, M2: RR, M4: FL, M3: FR), through the
+  // per-wheel speed loop when encoders are fitted
+  for (uint8_t i = 0; i < 4; i++) {
+    actuators_set_motor(i, speed_control_apply(i, scale_to_pwm(wheel[i], gain)));
+  }
+}
+#else
+// Evaluate one matrix row in float (Q12 coefficients converted per term)
+static float mixer_row_float(uint8_t motor, float x, float y, float r) {
+  const float k = 1.0f / (float)Q12_ONE;
+  float sum = g_mixer_matrix[motor][0] * k * x +
+              g_mixer_matrix[motor][1] * k * y +
+              g_mixer_matrix[motor][2] * k * r;
+  return sum * (g_mixer_scale[motor] * k);
 }
 
 // Normalize motor outputs to prevent saturation
@@ -54,31 +351,111 @@ static void normalize_outputs(float* fl, float* fr, float* rl, float* rr) {
   }
 }
 
-// Update mode parameters cache from current drive mode
-static void update_mode_params() {
-  switch (g_drive_mode) {
-    case DRIVE_MODE_BEGINNER:
-      g_mode_params.max_duty = BEGINNER_MAX_DUTY;
-      g_mode_params.expo = BEGINNER_EXPO;
-      break;
+// Priority desaturation, float reference of desaturate_priority()
+// Wheel order RL, RR, FL, FR as in the matrix
+static void desaturate_priority_float(const float* keep, const float* shed, float* wheel) {
+  // Step 1: Preserved component saturates on its own - fit it, drop the rest
+  float keep_max = 0.0f;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (fabs(keep[i]) > keep_max) keep_max = fabs(keep[i]);
+  }
+  if (keep_max > 1.0f) {
+    for (uint8_t i = 0; i < 4; i++) {
+      wheel[i] = keep[i] / keep_max;
+    }
+    return;
+  }
 
-    case DRIVE_MODE_NORMAL:
-      g_mode_params.max_duty = NORMAL_MAX_DUTY;
-      g_mode_params.expo = NORMAL_EXPO;
-      break;
+  // Step 2: Largest share of shed in [0, 1] that fits every wheel
+  float scale = 1.0f;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (shed[i] == 0.0f) continue;
+    float headroom = 1.0f - (shed[i] > 0.0f ? keep[i] : -keep[i]);
+    if (headroom < scale * fabs(shed[i])) scale = headroom / fabs(shed[i]);
+  }
 
-    case DRIVE_MODE_AGGRESSIVE:
-      g_mode_params.max_duty = AGGRESSIVE_MAX_DUTY;
-      g_mode_params.expo = AGGRESSIVE_EXPO;
-      break;
+  for (uint8_t i = 0; i < 4; i++) {
+    wheel[i] = keep[i] + shed[i] * scale;
+  }
+}
 
-    default:
-      // Fallback to NORMAL if invalid mode
-      g_mode_params.max_duty = NORMAL_MAX_DUTY;
-      g_mode_params.expo = NORMAL_EXPO;
-      break;
+// Perform mixing using the float reference pipeline
+template <class Policy>
+static void mixing_update_float() {
+  // Get max duty from current drive mode
+  int16_t max_duty = g_mode_params.max_duty;
+
+  // Shaped chassis command (shared integer front end) -> [-1.0, +1.0]
+  int16_t x_q12, y_q12, r_q12;
+  read_chassis_command<Policy>(&x_q12, &y_q12, &r_q12);
+
+  const float k = 1.0f / (float)Q12_ONE;
+  float x_norm = x_q12 * k;
+  float y_norm = y_q12 * k;
+  float r_norm = r_q12 * k;
+
+  // Matrix mixing with normalized values (RL, RR, FL, FR)
+  float wheel[4];
+  if (g_mode_params.desat == DESAT_UNIFORM) {
+    for (uint8_t i = 0; i < 4; i++) {
+      wheel[i] = mixer_row_float(i, x_norm, y_norm, r_norm);
+    }
+  } else {
+    float translation[4];
+    float rotation[4];
+    for (uint8_t i = 0; i < 4; i++) {
+      translation[i] = mixer_row_float(i, x_norm, y_norm, 0.0f);
+      rotation[i] = mixer_row_float(i, 0.0f, 0.0f, r_norm);
+    }
+    if (g_mode_params.desat == DESAT_YAW_PRIORITY) {
+      desaturate_priority_float(rotation, translation, wheel);
+    } else {
+      desaturate_priority_float(translation, rotation, wheel);
+    }
+  }
+  float rl_norm = wheel[0];
+  float rr_norm = wheel[1];
+  float fl_norm = wheel[2];
+  float fr_norm = wheel[3];
+
+  // Normalize to prevent saturation (keep ratios, limit max to 1.0)
+  normalize_outputs(&fl_norm, &fr_norm, &rl_norm, &rr_norm);
+
+  // Scale to PWM range based on drive mode max_duty
+  int16_t fl_pwm = (int16_t)(fl_norm * max_duty);
+  int16_t fr_pwm = (int16_t)(fr_norm * max_duty);
+  int16_t rl_pwm = (int16_t)(rl_norm * max_duty);
+  int16_t rr_pwm = (int16_t)(rr_norm * max_duty);
+
+  // Send to motors (through the per-wheel speed loop)
+  actuators_set_motor(0, speed_control_apply(0, rl_pwm));  // M1: Rear-Left
+  actuators_set_motor(1, speed_control_apply(1, rr_pwm));  // M2: Rear-Right
+  actuators_set_motor(2, speed_control_apply(2, fl_pwm));  // M4: Front-Left
+  actuators_set_motor(3, speed_control_apply(3, fr_pwm));  // M3: Front-Right
+}
+#endif // MIXING_FIXED_POINT
+
+// Complete pipeline for one policy (instantiated per policy in use)
+template <class Policy>
+static void mixing_pipeline() {
+#if MIXING_FIXED_POINT
+  mixing_update_fixed<Policy>();
+#else
+  mixing_update_float<Policy>();
+#endif
+}
+
+#if !MIXER_SINGLE_POLICY
+// Select the pipeline for a MIXER_POLICY_* value
+static MixerPipeline pipeline_for(uint8_t policy) {
+  switch (policy) {
+    case MIXER_POLICY_TANK_STRAFE: return &mixing_pipeline<TankStrafeMixer>;
+    case MIXER_POLICY_ARCADE:      return &mixing_pipeline<ArcadeMixer>;
+    case MIXER_POLICY_HOLONOMIC:
+    default:                       return &mixing_pipeline<HolonomicMixer>;
   }
 }
+#endif
 
 // ============================================================================
 // PUBLIC INTERFACE
@@ -88,6 +465,13 @@ void mixing_init() {
   // Set default drive mode
   g_drive_mode = DRIVE_MODE_NORMAL;
   update_mode_params();
+
+  // Start at rest
+  for (uint8_t i = 0; i < 3; i++) {
+    scurve_reset(&g_shaper[i], 0);
+  }
+  yaw_control_init();
+  speed_control_init();
 }
 
 void mixing_set_drive_mode(DriveMode mode) {
@@ -96,6 +480,11 @@ void mixing_set_drive_mode(DriveMode mode) {
     mode = DRIVE_MODE_NORMAL;  // Fallback to safe default
   }
 
+  // Called every tick by input_update() - only reload on an actual change
+  // of mode or profile (shaper state carries over so switching modes does
+  // not cause a jump)
+  if (mode == g_drive_mode && g_profile_generation == profiles_get_generation()) return;
+
   g_drive_mode = mode;
   update_mode_params();
 }
@@ -105,73 +494,23 @@ DriveMode mixing_get_drive_mode() {
 }
 
 void mixing_update() {
-  // CRSF 11-bit: 172 (min) - 991/992 (center) - 1811 (max)
-  // Deadband: ~5% around center = ~41 counts each side (950-1033)
-  const int16_t CENTER = 992;
-  const int16_t DEADBAND = 41;  // ~5% of full range
-
-  // Get max duty from current drive mode
-  int16_t max_duty = g_mode_params.max_duty;
-  float expo = g_mode_params.expo;
-
-  // Read raw channels
-  int16_t ch0_raw = g_state.input.raw_channels[0];  // Roll
-  int16_t ch1_raw = g_state.input.raw_channels[1];  // Pitch
-  int16_t ch3_raw = g_state.input.raw_channels[3];  // Yaw
-
-  // Apply deadband and get normalized input [-1.0, +1.0]
-  float x_norm, y_norm, r_norm;
-
-  // Roll (X axis) - inverted for correct strafe direction
-  if (abs(ch0_raw - CENTER) < DEADBAND) {
-    x_norm = 0.0f;
-  } else if (ch0_raw > CENTER) {
-    x_norm = -(float)(ch0_raw - CENTER - DEADBAND) / (float)(1811 - CENTER - DEADBAND);
-  } else {
-    x_norm = -(float)(ch0_raw - CENTER + DEADBAND) / (float)(CENTER - DEADBAND - 172);
-  }
+#if MIXER_SINGLE_POLICY
+  mixing_pipeline<BuildMixer>();
+#else
+  g_mixer_pipeline();
+#endif
+}
 
-  // Pitch (Y axis)
-  if (abs(ch1_raw - CENTER) < DEADBAND) {
-    y_norm = 0.0f;
-  } else if (ch1_raw > CENTER) {
-    y_norm = (float)(ch1_raw - CENTER - DEADBAND) / (float)(1811 - CENTER - DEADBAND);
-  } else {
-    y_norm = (float)(ch1_raw - CENTER + DEADBAND) / (float)(CENTER - DEADBAND - 172);
+void mixing_stop() {
+  // No ramp-down on kill/failsafe - drop the shaped command to rest
+  for (uint8_t i = 0; i < 3; i++) {
+    scurve_reset(&g_shaper[i], 0);
   }
+  yaw_control_reset();
+  speed_control_reset();
 
-  // Yaw (R axis)
-  if (abs(ch3_raw - CENTER) < DEADBAND) {
-    r_norm = 0.0f;
-  } else if (ch3_raw > CENTER) {
-    r_norm = (float)(ch3_raw - CENTER - DEADBAND) / (float)(1811 - CENTER - DEADBAND);
-  } else {
-    r_norm = (float)(ch3_raw - CENTER + DEADBAND) / (float)(CENTER - DEADBAND - 172);
-  }
-
-  // Apply exponential curve for smoother control
-  x_norm = apply_expo(x_norm, expo);
-  y_norm = apply_expo(y_norm, expo);
-  r_norm = apply_expo(r_norm, expo);
-
-  // Holonomic mixing with normalized values
-  float fl_norm = y_norm + x_norm + r_norm;  // Front-Left
-  float fr_norm = y_norm - x_norm - r_norm;  // Front-Right
-  float rl_norm = y_norm - x_norm + r_norm;  // Rear-Left
-  float rr_norm = y_norm + x_norm - r_norm;  // Rear-Right
-
-  // Normalize to prevent saturation (keep ratios, limit max to 1.0)
-  normalize_outputs(&fl_norm, &fr_norm, &rl_norm, &rr_norm);
-
-  // Scale to PWM range based on drive mode max_duty
-  int16_t fl_pwm = (int16_t)(fl_norm * max_duty);
-  int16_t fr_pwm = (int16_t)(fr_norm * max_duty);
-  int16_t rl_pwm = (int16_t)(rl_norm * max_duty);
-  int16_t rr_pwm = (int16_t)(rr_norm * max_duty);
-
-  // Send to motors
-  actuators_set_motor(0, rl_pwm);  // M1: Rear-Left
-  actuators_set_motor(1, rr_pwm);  // M2: Rear-Right
-  actuators_set_motor(2, fl_pwm);  // M4: Front-Left
-  actuators_set_motor(3, fr_pwm);  // M3: Front-Right
+  actuators_set_motor(0, 0);
+  actuators_set_motor(1, 0);
+  actuators_set_motor(2, 0);
+  actuators_set_motor(3, 0);
 }
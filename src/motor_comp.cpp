@@ -0,0 +1,294 @@
+// motor_comp.cpp - Per-motor deadzone and gain compensation
+// UpVote Battlebot - Phase 8
+#include "motor_comp.h"
+#include "config.h"
+#include "state.h"
+#include "actuators.h"
+#include "utilities.h"
+#include "curves.h"
+#include <avr/eeprom.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Direction index into the per-channel tables
+#define DIR_FWD  0
+#define DIR_REV  1
+
+// EEPROM record layout (bump version when the layout changes)
+#define MOTOR_COMP_RECORD_VERSION  1
+
+struct MotorCompRecord {
+  uint8_t version;          // MOTOR_COMP_RECORD_VERSION
+  uint8_t deadzone[4][2];   // Breakaway duty [motor][direction]
+  uint8_t checksum;         // ~(sum of the bytes above)
+};
+
+// Compile-time defaults [motor][direction] (motor order RL, RR, FL, FR)
+static const uint8_t g_default_deadzone[4][2] PROGMEM = {
+  { MOTOR_COMP_DEADZONE_RL_FWD, MOTOR_COMP_DEADZONE_RL_REV },
+  { MOTOR_COMP_DEADZONE_RR_FWD, MOTOR_COMP_DEADZONE_RR_REV },
+  { MOTOR_COMP_DEADZONE_FL_FWD, MOTOR_COMP_DEADZONE_FL_REV },
+  { MOTOR_COMP_DEADZONE_FR_FWD, MOTOR_COMP_DEADZONE_FR_REV }
+};
+
+static const int16_t g_gain[4][2] PROGMEM = {
+  { Q12_FROM_FLOAT(MOTOR_COMP_GAIN_RL_FWD), Q12_FROM_FLOAT(MOTOR_COMP_GAIN_RL_REV) },
+  { Q12_FROM_FLOAT(MOTOR_COMP_GAIN_RR_FWD), Q12_FROM_FLOAT(MOTOR_COMP_GAIN_RR_REV) },
+  { Q12_FROM_FLOAT(MOTOR_COMP_GAIN_FL_FWD), Q12_FROM_FLOAT(MOTOR_COMP_GAIN_FL_REV) },
+  { Q12_FROM_FLOAT(MOTOR_COMP_GAIN_FR_FWD), Q12_FROM_FLOAT(MOTOR_COMP_GAIN_FR_REV) }
+};
+
+#if MOTOR_COMP_CURVES_ENABLED
+// Optional per-motor nonlinearity tables (shared by both directions)
+static const int16_t g_curve_rl[CURVE_POINTS] PROGMEM = { MOTOR_COMP_CURVE_RL };
+static const int16_t g_curve_rr[CURVE_POINTS] PROGMEM = { MOTOR_COMP_CURVE_RR };
+static const int16_t g_curve_fl[CURVE_POINTS] PROGMEM = { MOTOR_COMP_CURVE_FL };
+static const int16_t g_curve_fr[CURVE_POINTS] PROGMEM = { MOTOR_COMP_CURVE_FR };
+
+static const int16_t* const g_curves[4] PROGMEM = {
+  g_curve_rl, g_curve_rr, g_curve_fl, g_curve_fr
+};
+#endif
+
+// Active per-channel map: duty = deadzone + (|command| * scale) >> 14
+static struct {
+  uint8_t deadzone;   // Breakaway duty (PWM counts)
+  uint16_t scale;     // gain * (255 - deadzone) / 255 in Q14
+} g_channel[4][2];
+
+// Calibration sweep phases
+enum CalPhase {
+  CAL_IDLE = 0,   // Not calibrating
+  CAL_ARM,        // Waiting for the pitch stick to be released
+  CAL_RAMP,       // Ramping the current channel up, waiting for the mark
+  CAL_REST        // Motor stopped between sweeps
+};
+
+static struct {
+  CalPhase phase;
+  uint8_t channel;      // 0-7: motor = channel >> 1, direction = channel & 1
+  uint8_t duty;         // Current sweep duty
+  uint8_t ticks;        // Ticks since last duty step / rest start
+  uint8_t deadzone[4][2];  // Results collected so far
+} g_cal;
+
+// Record being written by motor_comp_idle(): step 0 clears the version
+// byte, steps 1..sizeof-1 write the rest, the last step writes the version,
+// so the record only reads as valid once every byte is in place
+#define SAVE_STEPS  (sizeof(MotorCompRecord) + 1)
+
+static struct {
+  MotorCompRecord record;
+  uint8_t step;         // Next write step, SAVE_STEPS = nothing to write
+} g_save;
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// Checksum over a record (everything except the checksum byte)
+static uint8_t record_checksum(const MotorCompRecord* record) {
+  const uint8_t* bytes = (const uint8_t*)record;
+  uint8_t sum = 0;
+  for (uint8_t i = 0; i < offsetof(MotorCompRecord, checksum); i++) {
+    sum += bytes[i];
+  }
+  return ~sum;
+}
+
+// Load deadzones from EEPROM, returns false if the record is not valid
+static bool load_record(uint8_t deadzone[4][2]) {
+  MotorCompRecord record;
+  eeprom_read_block(&record, (const void*)EEPROM_ADDR_MOTOR_COMP, sizeof(record));
+
+  if (record.version != MOTOR_COMP_RECORD_VERSION) return false;
+  if (record.checksum != record_checksum(&record)) return false;
+
+  memcpy(deadzone, record.deadzone, sizeof(record.deadzone));
+  return true;
+}
+
+// Stage deadzones for saving; motor_comp_idle() writes them a byte at a
+// time (a blocking write is ~3.4ms per changed byte, too long for a tick)
+static void save_record(const uint8_t deadzone[4][2]) {
+  g_save.record.version = MOTOR_COMP_RECORD_VERSION;
+  memcpy(g_save.record.deadzone, deadzone, sizeof(g_save.record.deadzone));
+  g_save.record.checksum = record_checksum(&g_save.record);
+  g_save.step = 0;
+}
+
+// Precompute the per-channel map from a deadzone table and compiled gains
+static void apply_deadzones(const uint8_t deadzone[4][2]) {
+  for (uint8_t m = 0; m < 4; m++) {
+    for (uint8_t d = 0; d < 2; d++) {
+      uint8_t dz = deadzone[m][d];
+      int16_t gain = (int16_t)pgm_read_word(&g_gain[m][d]);
+      if (gain < 0) gain = 0;
+
+      // Q12 gain -> Q14 scale over the remaining (255 - dz) span
+      uint32_t scale = ((uint32_t)gain * (MOTOR_PWM_MAX - dz) * 4 + MOTOR_PWM_MAX / 2) / MOTOR_PWM_MAX;
+      g_channel[m][d].deadzone = dz;
+      g_channel[m][d].scale = (scale > 0xFFFF) ? 0xFFFF : (uint16_t)scale;
+    }
+  }
+}
+
+// True while the pitch stick is held in the "mark" position
+static bool mark_pressed() {
+  return g_state.input.raw_channels[1] > MOTOR_COMP_CAL_MARK_RAW;
+}
+
+// Drive only the channel under test, all others stopped
+static void cal_drive(uint8_t channel, uint8_t duty) {
+  for (uint8_t m = 0; m < 4; m++) {
+    actuators_set_motor(m, 0);
+  }
+  int16_t command = (channel & 1) ? -(int16_t)duty : (int16_t)duty;
+  actuators_set_motor(channel >> 1, command);
+}
+
+// Advance to the next channel, or finish and save
+static void cal_next_channel() {
+  g_cal.channel++;
+  g_cal.duty = 0;
+  g_cal.ticks = 0;
+
+  if (g_cal.channel >= 8) {
+    cal_drive(0, 0);
+    save_record(g_cal.deadzone);
+    apply_deadzones(g_cal.deadzone);
+    g_cal.phase = CAL_IDLE;
+  } else {
+    g_cal.phase = CAL_REST;
+  }
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void motor_comp_init() {
+  uint8_t deadzone[4][2];
+
+  // Calibrated values if present, otherwise compiled defaults
+  if (!load_record(deadzone)) {
+    memcpy_P(deadzone, g_default_deadzone, sizeof(deadzone));
+  }
+  apply_deadzones(deadzone);
+
+  g_cal.phase = CAL_IDLE;
+  g_save.step = SAVE_STEPS;
+#if MOTOR_COMP_CALIBRATION
+  // Start from the active values so skipped channels keep them
+  memcpy(g_cal.deadzone, deadzone, sizeof(deadzone));
+  g_cal.channel = 0;
+  g_cal.duty = 0;
+  g_cal.ticks = 0;
+  g_cal.phase = CAL_ARM;
+#endif
+}
+
+int16_t motor_comp_apply(uint8_t motor_index, int16_t command) {
+  // Bounds check motor index; raw output while the sweep is running
+  if (motor_index > 3) return 0;
+  if (command == 0 || g_cal.phase != CAL_IDLE) return command;
+
+  uint8_t dir = (command < 0) ? DIR_REV : DIR_FWD;
+  uint16_t magnitude = (uint16_t)constrain(abs(command), 0, MOTOR_PWM_MAX);
+
+#if MOTOR_COMP_CURVES_ENABLED
+  // Optional nonlinearity: PWM counts -> Q12 -> curve -> PWM counts
+  const int16_t* curve = (const int16_t*)pgm_read_ptr(&g_curves[motor_index]);
+  int16_t shaped = curve_eval(curve, (int16_t)(((uint32_t)magnitude << Q12_SHIFT) / MOTOR_PWM_MAX));
+  magnitude = (uint16_t)(((uint32_t)shaped * MOTOR_PWM_MAX) >> Q12_SHIFT);
+#endif
+
+  // Deadzone offset plus gain over the remaining span
+  uint16_t duty = g_channel[motor_index][dir].deadzone +
+                  (uint16_t)(((uint32_t)magnitude * g_channel[motor_index][dir].scale + (1 << 13)) >> 14);
+  if (duty > MOTOR_PWM_MAX) duty = MOTOR_PWM_MAX;
+
+  return (dir == DIR_REV) ? -(int16_t)duty : (int16_t)duty;
+}
+
+void motor_comp_idle() {
+  if (g_save.step >= SAVE_STEPS) return;
+  if (!eeprom_is_ready()) return;   // Never wait for the EEPROM
+
+  uint8_t* addr = (uint8_t*)EEPROM_ADDR_MOTOR_COMP;
+  const uint8_t* bytes = (const uint8_t*)&g_save.record;
+  if (g_save.step == 0) {
+    eeprom_update_byte(addr, (uint8_t)~MOTOR_COMP_RECORD_VERSION);
+  } else if (g_save.step < sizeof(MotorCompRecord)) {
+    eeprom_update_byte(addr + g_save.step, bytes[g_save.step]);
+  } else {
+    eeprom_update_byte(addr, bytes[0]);
+  }
+  g_save.step++;
+}
+
+bool motor_comp_calibrating() {
+  return g_cal.phase != CAL_IDLE;
+}
+
+void motor_comp_calibration_update() {
+  switch (g_cal.phase) {
+    case CAL_ARM:
+      // Require the stick released first so a held stick cannot mark
+      cal_drive(g_cal.channel, 0);
+      if (!mark_pressed()) {
+        g_cal.duty = 0;
+        g_cal.ticks = 0;
+        g_cal.phase = CAL_RAMP;
+      }
+      break;
+
+    case CAL_RAMP:
+      if (mark_pressed()) {
+        // Wheel started turning - back off by the operator's reaction time
+        uint8_t dz = (g_cal.duty > MOTOR_COMP_CAL_REACTION) ? g_cal.duty - MOTOR_COMP_CAL_REACTION : 0;
+        g_cal.deadzone[g_cal.channel >> 1][g_cal.channel & 1] = dz;
+        cal_next_channel();
+        break;
+      }
+
+      if (++g_cal.ticks >= MOTOR_COMP_CAL_RAMP_TICKS) {
+        g_cal.ticks = 0;
+        if (g_cal.duty >= MOTOR_COMP_CAL_MAX_DUTY) {
+          // No mark - keep the previous value for this channel
+          cal_next_channel();
+          break;
+        }
+        g_cal.duty++;
+      }
+      cal_drive(g_cal.channel, g_cal.duty);
+      break;
+
+    case CAL_REST:
+      cal_drive(g_cal.channel, 0);
+      if (++g_cal.ticks >= MOTOR_COMP_CAL_REST_MS / LOOP_PERIOD_MS) {
+        g_cal.phase = CAL_ARM;
+      }
+      break;
+
+    case CAL_IDLE:
+    default:
+      break;
+  }
+}
+
+void motor_comp_calibration_hold() {
+  if (g_cal.phase == CAL_IDLE) return;
+
+  // Restart the current channel from zero once driving resumes
+  g_cal.duty = 0;
+  g_cal.ticks = 0;
+  g_cal.phase = CAL_ARM;
+}
+
+uint8_t motor_comp_get_deadzone(uint8_t motor_index, uint8_t direction) {
+  if (motor_index > 3 || direction > 1) return 0;
+  return g_channel[motor_index][direction].deadzone;
+}
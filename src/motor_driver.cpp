@@ -0,0 +1,142 @@
+// motor_driver.cpp - Direct-port L293D shield driver
+// UpVote Battlebot - Phase 8
+#include "motor_driver.h"
+#include "config.h"
+#include <avr/io.h>
+#include <util/atomic.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Shift register port bits (pins in config.h; fixed by the shield wiring)
+#define SR_LATCH_BIT   PB4   // PIN_SR_LATCH  (D12)
+#define SR_DATA_BIT    PB0   // PIN_SR_DATA   (D8)
+#define SR_CLOCK_BIT   PD4   // PIN_SR_CLOCK  (D4)
+#define SR_ENABLE_BIT  PD7   // PIN_SR_ENABLE (D7)
+
+// Clock select for MOTOR_PWM_PRESCALER (Timer0 and Timer2 encode it
+// differently); 16 MHz / prescaler / 256 = PWM frequency
+#if MOTOR_PWM_PRESCALER == 8
+#define MOTOR_PWM_CS0  _BV(CS01)                 // 7.8 kHz
+#define MOTOR_PWM_CS2  _BV(CS21)
+#else
+#define MOTOR_PWM_CS0  (_BV(CS01) | _BV(CS00))   // 976 Hz
+#define MOTOR_PWM_CS2  _BV(CS22)
+#endif
+
+// Direction bits per channel (RL=M1, RR=M2, FL=M4, FR=M3)
+static const uint8_t g_bit_forward[4] = {
+  _BV(SR_M1_A), _BV(SR_M2_A), _BV(SR_M4_A), _BV(SR_M3_A)
+};
+static const uint8_t g_bit_reverse[4] = {
+  _BV(SR_M1_B), _BV(SR_M2_B), _BV(SR_M4_B), _BV(SR_M3_B)
+};
+
+// Last values sent to the hardware (writes are skipped when unchanged)
+static uint8_t g_latched;
+static uint8_t g_duty[4];
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// Shift a direction byte into the 74HC595 and latch it (MSB first)
+// Single-bit port updates compile to sbi/cbi, so ISRs touching other
+// PORTB/PORTD pins are not disturbed. ~5us versus ~100us for shiftOut()
+static void latch_write(uint8_t bits) {
+  PORTB &= ~_BV(SR_LATCH_BIT);
+  for (uint8_t mask = 0x80; mask != 0; mask >>= 1) {
+    PORTD &= ~_BV(SR_CLOCK_BIT);
+    if (bits & mask) {
+      PORTB |= _BV(SR_DATA_BIT);
+    } else {
+      PORTB &= ~_BV(SR_DATA_BIT);
+    }
+    PORTD |= _BV(SR_CLOCK_BIT);    // Data sampled on the rising edge
+  }
+  PORTB |= _BV(SR_LATCH_BIT);      // All eight outputs change together
+  g_latched = bits;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void motor_driver_init() {
+  // Step 1: Shift register pins, outputs held disabled until all bridges
+  // are latched to coast
+  DDRB |= _BV(SR_LATCH_BIT) | _BV(SR_DATA_BIT);
+  DDRD |= _BV(SR_CLOCK_BIT) | _BV(SR_ENABLE_BIT);
+  PORTD |= _BV(SR_ENABLE_BIT);
+  latch_write(0x00);
+  PORTD &= ~_BV(SR_ENABLE_BIT);
+
+  // Step 2: PWM at zero duty before the pins become outputs
+  OCR2A = 0;
+  OCR2B = 0;
+  OCR0A = 0;
+  OCR0B = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    g_duty[i] = 0;
+  }
+
+  // Step 3: Timer2 (M1/M2) and Timer0 (M3/M4) in fast PWM at the same
+  // prescaler, so all four channels switch at the same frequency
+  // Timer0 keeps its overflow interrupt for the core's time count; timebase
+  // rescales it for the new prescaler
+  TCCR2A = _BV(COM2A1) | _BV(COM2B1) | _BV(WGM21) | _BV(WGM20);
+  TCCR2B = MOTOR_PWM_CS2;
+  TCCR0A = _BV(COM0A1) | _BV(COM0B1) | _BV(WGM01) | _BV(WGM00);
+  TCCR0B = MOTOR_PWM_CS0;
+
+  DDRB |= _BV(PB3);                          // D11: M1
+  DDRD |= _BV(PD3) | _BV(PD5) | _BV(PD6);    // D3: M2, D5: M4, D6: M3
+}
+
+void motor_driver_write(const uint8_t duty[4], uint8_t reverse_mask, uint8_t brake_mask) {
+  // Step 1: Direction byte for all four motors (zero duty = coast)
+  uint8_t bits = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (duty[i] == 0) continue;
+    if (brake_mask & (1 << i)) {
+      bits |= g_bit_forward[i] | g_bit_reverse[i];   // A = B = HIGH
+    } else {
+      bits |= (reverse_mask & (1 << i)) ? g_bit_reverse[i] : g_bit_forward[i];
+    }
+  }
+
+  // Step 2: One latch, only when a direction changed
+  if (bits != g_latched) {
+    latch_write(bits);
+  }
+
+  // Step 3: Compare registers (RL=OC2A, RR=OC2B, FL=OC0B, FR=OC0A)
+  if (duty[0] != g_duty[0]) { OCR2A = duty[0]; g_duty[0] = duty[0]; }
+  if (duty[1] != g_duty[1]) { OCR2B = duty[1]; g_duty[1] = duty[1]; }
+  if (duty[2] != g_duty[2]) { OCR0B = duty[2]; g_duty[2] = duty[2]; }
+  if (duty[3] != g_duty[3]) { OCR0A = duty[3]; g_duty[3] = duty[3]; }
+}
+
+void motor_driver_brake() {
+  // Masked so it can run from an ISR without splitting a latch_write()
+  // in progress in the control loop
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    // Duty first so no bridge is driven while the direction bits change
+    OCR2A = 0;
+    OCR2B = 0;
+    OCR0A = 0;
+    OCR0B = 0;
+
+    // A = B = HIGH on every motor, then enable all bridges: the L293D only
+    // shorts the motor terminals while its enable (PWM) input is high
+    latch_write(0xFF);
+    OCR2A = 255;
+    OCR2B = 255;
+    OCR0A = 255;
+    OCR0B = 255;
+    for (uint8_t i = 0; i < 4; i++) {
+      g_duty[i] = 255;
+    }
+  }
+}
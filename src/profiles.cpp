@@ -0,0 +1,269 @@
+// profiles.cpp - EEPROM-persisted drive profiles
+// UpVote Battlebot - Phase 8
+#include "profiles.h"
+#include "config.h"
+#include "state.h"
+#include "mixing.h"
+#include "timebase.h"
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// EEPROM record layouts (bump version when either layout changes)
+// Every record starts with version + sequence and ends with a CRC, and
+// lives in two wear slots: writes go to the older slot, loads take the
+// newest slot whose CRC checks out, so a torn write keeps the old copy.
+#define PROFILE_RECORD_VERSION  3
+#define PROFILE_SLOT_NONE       0xFF
+
+struct ProfileRecord {
+  uint8_t version;          // PROFILE_RECORD_VERSION
+  uint8_t seq;              // Wear-level sequence (newest wins, wraps)
+  DriveProfile profile;
+  uint16_t crc;             // CRC-CCITT of the bytes above
+};
+
+struct ProfileMapRecord {
+  uint8_t version;          // PROFILE_RECORD_VERSION
+  uint8_t seq;              // Wear-level sequence (newest wins, wraps)
+  uint8_t map[3];           // Profile index per drive mode switch position
+  uint16_t crc;             // CRC-CCITT of the bytes above
+};
+
+// First wear slot of a profile (the second follows it)
+#define PROFILE_ADDR(index)  (EEPROM_ADDR_PROFILES + (index) * 2 * sizeof(ProfileRecord))
+
+static_assert(2 * sizeof(ProfileMapRecord) <= EEPROM_SIZE_PROFILE_MAP,
+              "Profile map does not fit EEPROM_SIZE_PROFILE_MAP");
+static_assert(PROFILE_COUNT * 2 * sizeof(ProfileRecord) <= EEPROM_SIZE_PROFILES,
+              "PROFILE_COUNT profiles do not fit EEPROM_SIZE_PROFILES");
+
+// Compiled defaults, one per profile index
+#define PROFILE_DEFAULT(mode) { \
+  mode##_PROFILE_NAME, mode##_MAX_DUTY, \
+  { mode##_CURVE_X, mode##_CURVE_Y, mode##_CURVE_R }, \
+  mode##_ROTATION_PCT, mode##_STOP_BRAKE, \
+  { mode##_ACCEL_MS_X, mode##_ACCEL_MS_Y, mode##_ACCEL_MS_R }, \
+  { mode##_DECEL_MS_X, mode##_DECEL_MS_Y, mode##_DECEL_MS_R }, \
+  mode##_JERK_MS, mode##_WEAPON_SPINUP_MS, mode##_WEAPON_SPINDOWN_MS }
+
+static const DriveProfile g_default_profiles[] PROGMEM = {
+  PROFILE_DEFAULT(BEGINNER),
+  PROFILE_DEFAULT(NORMAL),
+  PROFILE_DEFAULT(AGGRESSIVE),
+  PROFILE_DEFAULT(PUSHER)
+};
+
+static_assert(sizeof(g_default_profiles) / sizeof(g_default_profiles[0]) == PROFILE_COUNT,
+              "Add a compiled default for every profile");
+
+// Active profiles per switch position (RAM copies, read by the control loop)
+static ProfileRecord g_active[3];
+static uint8_t g_active_slot[3];     // EEPROM slot g_active[k] came from
+
+// Switch position -> profile index (live), and the staged EEPROM record
+static uint8_t g_profile_map[3];
+static ProfileMapRecord g_map_record;
+static uint8_t g_map_slot;
+
+// Pending background work
+#define DIRTY_MAP  0x08              // Bits 0-2: g_active[k] needs writing
+static uint8_t g_dirty;
+static uint8_t g_reload;             // Bits 0-2: g_active[k] needs loading
+
+// In-progress write (one byte per profiles_idle() call)
+static struct {
+  const uint8_t* src;
+  uint16_t addr;
+  uint8_t len;                       // 0 = idle
+  uint8_t pos;
+} g_write;
+
+static uint8_t g_generation;
+static uint16_t g_load_us;
+
+// Selection gesture
+static bool g_select_held;
+static uint32_t g_select_start_ms;
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// CRC-CCITT over the bytes of a record before its crc field
+static uint16_t record_crc(const void* record, uint8_t len) {
+  const uint8_t* bytes = (const uint8_t*)record;
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < len; i++) {
+    crc = _crc_ccitt_update(crc, bytes[i]);
+  }
+  return crc;
+}
+
+// Read both wear slots and keep the newest valid record
+// Returns: Slot the record came from, or PROFILE_SLOT_NONE
+template <class Record>
+static uint8_t load_newest(uint16_t addr, Record* out) {
+  Record candidate;
+  uint8_t best = PROFILE_SLOT_NONE;
+
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    eeprom_read_block(&candidate, (const void*)(addr + slot * sizeof(Record)), sizeof(Record));
+    if (candidate.version != PROFILE_RECORD_VERSION) continue;
+    if (candidate.crc != record_crc(&candidate, offsetof(Record, crc))) continue;
+
+    // Sequence numbers wrap - compare by signed difference
+    if (best == PROFILE_SLOT_NONE || (int8_t)(candidate.seq - out->seq) > 0) {
+      *out = candidate;
+      best = slot;
+    }
+  }
+  return best;
+}
+
+// Load the profile mapped to switch position k into RAM
+static void load_position(uint8_t k) {
+  uint8_t index = g_profile_map[k];
+  ProfileRecord* record = &g_active[k];
+
+  g_dirty &= ~(1 << k);  // Any queued write was for the previous profile
+  g_active_slot[k] = load_newest(PROFILE_ADDR(index), record);
+  if (g_active_slot[k] == PROFILE_SLOT_NONE) {
+    // Blank or corrupt - use the compiled default and seed EEPROM with it
+    memcpy_P(&record->profile, &g_default_profiles[index], sizeof(DriveProfile));
+    record->version = PROFILE_RECORD_VERSION;
+    record->seq = 0;
+    g_dirty |= (1 << k);
+  }
+
+  // Values the CRC cannot vouch for (written by an older build)
+  record->profile.name[PROFILE_NAME_LEN - 1] = '\0';
+  if (record->profile.rotation_pct > 100) record->profile.rotation_pct = 100;
+}
+
+// Start writing a record to the older of its two wear slots
+template <class Record>
+static void start_write(uint16_t addr, Record* record, uint8_t* slot) {
+  *slot = (*slot == 0) ? 1 : 0;
+  record->seq++;
+  record->crc = record_crc(record, offsetof(Record, crc));
+
+  g_write.src = (const uint8_t*)record;
+  g_write.addr = addr + *slot * sizeof(Record);
+  g_write.len = sizeof(Record);
+  g_write.pos = 0;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void profiles_init() {
+  uint32_t start_us = timebase_micros();
+
+  g_dirty = 0;
+  g_reload = 0;
+  g_write.len = 0;
+  g_select_held = false;
+
+  // Step 1: Switch position -> profile map (default: identity)
+  g_map_slot = load_newest(EEPROM_ADDR_PROFILE_MAP, &g_map_record);
+  bool map_ok = (g_map_slot != PROFILE_SLOT_NONE);
+  for (uint8_t k = 0; k < 3 && map_ok; k++) {
+    if (g_map_record.map[k] >= PROFILE_COUNT) map_ok = false;
+  }
+  if (!map_ok) {
+    g_map_record.version = PROFILE_RECORD_VERSION;
+    g_map_record.seq = 0;
+    for (uint8_t k = 0; k < 3; k++) {
+      g_map_record.map[k] = k;
+    }
+    g_dirty |= DIRTY_MAP;
+  }
+  memcpy(g_profile_map, g_map_record.map, sizeof(g_profile_map));
+
+  // Step 2: The three mapped profiles
+  for (uint8_t k = 0; k < 3; k++) {
+    load_position(k);
+  }
+
+  g_generation++;
+  g_load_us = (uint16_t)(timebase_micros() - start_us);
+}
+
+const DriveProfile* profiles_get(uint8_t mode) {
+  if (mode > 2) mode = DRIVE_MODE_NORMAL;
+  return &g_active[mode].profile;
+}
+
+uint8_t profiles_get_generation() {
+  return g_generation;
+}
+
+void profiles_update() {
+  // Only with motors stopped by the kill switch and live stick values
+  if (!g_state.input.kill_switch || !g_state.input.link_ok ||
+      g_state.input.raw_channels[3] < PROFILE_SELECT_RAW) {
+    g_select_held = false;
+    return;
+  }
+
+  uint32_t now = timebase_millis();
+  if (!g_select_held) {
+    g_select_held = true;
+    g_select_start_ms = now;
+    return;
+  }
+  if (now - g_select_start_ms < PROFILE_SELECT_HOLD_MS) return;
+
+  // Step the current switch position to the next profile; the load and
+  // the map write happen in profiles_idle()
+  g_select_start_ms = now;
+  uint8_t k = mixing_get_drive_mode();
+  g_profile_map[k] = (g_profile_map[k] + 1) % PROFILE_COUNT;
+  g_reload |= (1 << k);
+  g_dirty |= DIRTY_MAP;
+}
+
+void profiles_idle() {
+  // Step 1: Continue the current write (never wait for the EEPROM)
+  if (g_write.len > 0) {
+    if (!eeprom_is_ready()) return;
+    eeprom_update_byte((uint8_t*)(g_write.addr + g_write.pos), g_write.src[g_write.pos]);
+    if (++g_write.pos >= g_write.len) g_write.len = 0;
+    return;
+  }
+  if (!eeprom_is_ready()) return;
+
+  // Step 2: Load a newly selected profile (one per call)
+  for (uint8_t k = 0; k < 3; k++) {
+    if (g_reload & (1 << k)) {
+      g_reload &= ~(1 << k);
+      load_position(k);
+      g_generation++;
+      return;
+    }
+  }
+
+  // Step 3: Start the next queued write
+  if (g_dirty & DIRTY_MAP) {
+    g_dirty &= ~DIRTY_MAP;
+    memcpy(g_map_record.map, g_profile_map, sizeof(g_map_record.map));
+    start_write(EEPROM_ADDR_PROFILE_MAP, &g_map_record, &g_map_slot);
+    return;
+  }
+  for (uint8_t k = 0; k < 3; k++) {
+    if (g_dirty & (1 << k)) {
+      g_dirty &= ~(1 << k);
+      start_write(PROFILE_ADDR(g_profile_map[k]), &g_active[k], &g_active_slot[k]);
+      return;
+    }
+  }
+}
+
+uint16_t profiles_get_load_us() {
+  return g_load_us;
+}
@@ -0,0 +1,158 @@
+// pulse_out.cpp - Timer1 servo/ESC pulse generation
+// UpVote Battlebot - Phase 8
+#include "pulse_out.h"
+#include "config.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// OneShot125 / Multishot share Timer1 with the servo at a faster frame rate
+// PWM and DShot run Timer1 at PULSE_OUT_HZ (DShot leaves OC1A to dshot.cpp)
+#define PULSE_FAST_MODE  (WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_ONESHOT125 || \
+                          WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_MULTISHOT)
+
+#if !PULSE_FAST_MODE
+// Timer1 at prescaler 8: 2 ticks per microsecond at 16 MHz, both channels
+// pulse every frame
+#define PULSE_PRESCALER_BITS  _BV(CS11)
+#define PULSE_TICKS_PER_US    (F_CPU / 8 / 1000000UL)
+#define PULSE_PERIOD_TICKS    (F_CPU / 8 / PULSE_OUT_HZ)
+#else
+// Timer1 at prescaler 1: 16 ticks per microsecond. The weapon pulses every
+// frame (non-inverting OC1A, starts at BOTTOM); the servo pulses once every
+// PULSE_SERVO_FRAMES frames (inverting OC1B, ends at TOP - OCR1B = TOP
+// keeps it low)
+#define PULSE_PRESCALER_BITS  _BV(CS10)
+#define PULSE_TICKS_PER_US    (F_CPU / 1000000UL)
+#define PULSE_PERIOD_TICKS    (F_CPU / PULSE_FAST_HZ)
+#define PULSE_TOP             (PULSE_PERIOD_TICKS - 1)
+#define PULSE_SERVO_FRAMES    (PULSE_FAST_HZ / PULSE_OUT_HZ)
+
+// Weapon pulse width from throttle microseconds (no divide)
+#if WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_ONESHOT125
+// OneShot125: width = us / 8 -> 125-250us, ticks = us * 16 / 8
+#define WEAPON_TICKS(us)      ((uint16_t)(us) * 2)
+#else
+// Multishot: width = 5 + (us - 1000) / 50 -> 5-25us, ticks = (us - 750) * 0.32
+#define WEAPON_TICKS(us)      ((uint16_t)(((uint32_t)((us) - 750) * 328) >> 10))
+#endif
+#define WEAPON_MAX_TICKS      WEAPON_TICKS(WEAPON_ESC_MAX_US)
+
+// Frame restart window guard (ticks): covers the read-compare-write of TCNT1
+#define PULSE_RESTART_MARGIN  64
+
+#if SERVO_ENDPOINT_EXTEND * PULSE_TICKS_PER_US >= PULSE_PERIOD_TICKS
+#error "Servo pulse does not fit a PULSE_FAST_HZ frame"
+#endif
+
+static volatile uint16_t g_servo_ticks;   // Latest servo width
+static volatile uint8_t g_servo_frame;    // Frame counter for the servo
+static volatile uint8_t g_servo_pipe;     // Bit 0: servo pulse in the current
+                                          // frame, bit 1: in the next frame
+#endif
+
+#if PULSE_PERIOD_TICKS > 65536
+#error "Timer1 period does not fit 16 bits at this pulse rate"
+#endif
+
+// ============================================================================
+// INTERRUPT SERVICE ROUTINE (fast protocols only)
+// ============================================================================
+
+#if PULSE_FAST_MODE
+// End of a frame (TOP). The BOTTOM buffer load has already happened by the
+// time this runs, so OCR1B written here applies to the frame after next.
+ISR(TIMER1_OVF_vect) {
+  g_servo_pipe >>= 1;
+  if (++g_servo_frame >= PULSE_SERVO_FRAMES) {
+    g_servo_frame = 0;
+    OCR1B = PULSE_TOP + 1 - g_servo_ticks;
+    g_servo_pipe |= 0x02;
+  } else {
+    OCR1B = PULSE_TOP;
+  }
+}
+#endif
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void pulse_out_init() {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    // Step 1: Stop the timer (the Arduino core set it up for analogWrite)
+    // and load the safe pulse widths before the pins are connected
+    TCCR1B = 0;
+    TCCR1A = 0;
+    TCNT1 = 0;
+    ICR1 = PULSE_PERIOD_TICKS - 1;
+
+#if WEAPON_ESC_DSHOT
+    OCR1B = SAFE_SERVO_US * PULSE_TICKS_PER_US;
+
+    // Step 2: Fast PWM mode 14 (TOP = ICR1), servo only on OC1B
+    TCCR1A = _BV(COM1B1) | _BV(WGM11);
+#elif !PULSE_FAST_MODE
+    OCR1A = SAFE_WEAPON_US * PULSE_TICKS_PER_US;
+    OCR1B = SAFE_SERVO_US * PULSE_TICKS_PER_US;
+
+    // Step 2: Fast PWM mode 14 (TOP = ICR1), non-inverting on OC1A/OC1B.
+    // OCR1A/B are double-buffered and load at BOTTOM.
+    TCCR1A = _BV(COM1A1) | _BV(COM1B1) | _BV(WGM11);
+#else
+    OCR1A = WEAPON_TICKS(SAFE_WEAPON_US);
+    OCR1B = PULSE_TOP;
+    g_servo_ticks = SAFE_SERVO_US * PULSE_TICKS_PER_US;
+    g_servo_frame = 0;
+    g_servo_pipe = 0;
+
+    // Step 2: Fast PWM mode 14, OC1A non-inverting (weapon), OC1B inverting
+    // (servo), frame-end interrupt schedules the servo pulses
+    TCCR1A = _BV(COM1A1) | _BV(COM1B1) | _BV(COM1B0) | _BV(WGM11);
+    TIMSK1 |= _BV(TOIE1);
+#endif
+    TCCR1B = _BV(WGM13) | _BV(WGM12) | PULSE_PRESCALER_BITS;
+  }
+
+#if WEAPON_ESC_DSHOT
+  DDRB |= _BV(PB2);              // D10: OC1B (servo), D9 belongs to dshot.cpp
+#else
+  DDRB |= _BV(PB1) | _BV(PB2);   // D9: OC1A (weapon), D10: OC1B (servo)
+#endif
+}
+
+void pulse_out_write(uint16_t weapon_us, uint16_t servo_us) {
+  // Range clamps (compares only - microseconds to ticks is a shift)
+  if (weapon_us < WEAPON_ESC_MIN_US) weapon_us = WEAPON_ESC_MIN_US;
+  if (weapon_us > WEAPON_ESC_MAX_US) weapon_us = WEAPON_ESC_MAX_US;
+  if (servo_us < SERVO_ENDPOINT_RETRACT) servo_us = SERVO_ENDPOINT_RETRACT;
+  if (servo_us > SERVO_ENDPOINT_EXTEND) servo_us = SERVO_ENDPOINT_EXTEND;
+
+  // 16-bit register writes share the TEMP byte - keep them atomic
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+#if WEAPON_ESC_DSHOT
+    OCR1B = servo_us * PULSE_TICKS_PER_US;   // Weapon goes out via dshot_update()
+#elif !PULSE_FAST_MODE
+    OCR1A = weapon_us * PULSE_TICKS_PER_US;
+    OCR1B = servo_us * PULSE_TICKS_PER_US;
+#else
+    OCR1A = WEAPON_TICKS(weapon_us);
+    g_servo_ticks = servo_us * PULSE_TICKS_PER_US;
+
+    // Sync to the control tick: end the current frame now so the new
+    // width goes out immediately. Only once the live weapon pulse is over
+    // (restarting inside it would stretch it) and never in a servo frame;
+    // otherwise the width goes out at the next frame (<= 2.5ms).
+    uint16_t now = TCNT1;
+    if (!(g_servo_pipe & 0x01) &&
+        now > WEAPON_MAX_TICKS + PULSE_RESTART_MARGIN &&
+        now < PULSE_TOP - PULSE_RESTART_MARGIN) {
+      TCNT1 = PULSE_TOP - 1;
+    }
+#endif
+  }
+}
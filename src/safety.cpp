@@ -3,6 +3,7 @@
 #include "safety.h"
 #include "config.h"
 #include "state.h"
+#include "error_log.h"
 #include <avr/wdt.h>
 
 // ============================================================================
@@ -21,7 +22,7 @@ void safety_init() {
 
   // If watchdog caused the reset, record it
   if (mcusr & (1 << WDRF)) {
-    safety_set_error(ERR_WATCHDOG_RESET);
+    safety_set_error(ERR_WATCHDOG_RESET, mcusr);
   }
 
   // Enable hardware watchdog timer
@@ -37,7 +38,7 @@ bool safety_is_safe() {
   // Phase 5+ will add arming logic
 
   // Validate state integrity (QA fix: H2)
-  if (g_state.safety.error > ERR_CRSF_CRC) {
+  if (g_state.safety.error > ERR_WEAPON_RECOVERY) {
     // Invalid error code detected
     return false;
   }
@@ -45,7 +46,10 @@ bool safety_is_safe() {
   return (g_state.safety.error == ERR_NONE);
 }
 
-void safety_set_error(SystemError error) {
+void safety_set_error(SystemError error, uint16_t context) {
+  // Phase 8: Log every occurrence, later errors included
+  error_log_record(error, context);
+
   // First-error-wins: don't overwrite existing errors
   if (g_state.safety.error == ERR_NONE) {
     g_state.safety.error = error;
@@ -3,6 +3,9 @@
 #include "servo.h"
 #include "config.h"
 #include "state.h"
+#include "utilities.h"
+#include "timebase.h"
+#include <avr/pgmspace.h>
 
 // ============================================================================
 // PRIVATE STATE
@@ -11,41 +14,123 @@
 // Previous servo command (for slew-rate limiting)
 static uint16_t g_servo_previous_us = SERVO_NEUTRAL_US;
 
+// Phase 8: Self-righting sequence keyframe (see SELFRIGHT_*_FRAMES in config.h)
+struct ServoKeyframe {
+  uint16_t servo_us;   // Position to move to
+  uint16_t move_ms;    // Travel time from the previous keyframe
+  uint16_t hold_ms;    // Time to stay there
+  int8_t kick_pct;     // Drive kick during this keyframe (% forward)
+};
+
+// Selected sequence: SELFRIGHT_<name>_FRAMES / SELFRIGHT_<name>_REPEAT
+#define SEQ_FRAMES_(name)  SELFRIGHT_##name##_FRAMES
+#define SEQ_FRAMES(name)   SEQ_FRAMES_(name)
+#define SEQ_REPEAT_(name)  SELFRIGHT_##name##_REPEAT
+#define SEQ_REPEAT(name)   SEQ_REPEAT_(name)
+
+static const ServoKeyframe g_sequence[] PROGMEM = SEQ_FRAMES(SELFRIGHT_SEQUENCE);
+
+#define SEQ_LENGTH       (sizeof(g_sequence) / sizeof(g_sequence[0]))
+#define SEQ_REPEAT_FROM  SEQ_REPEAT(SELFRIGHT_SEQUENCE)
+
+static_assert(SEQ_REPEAT_FROM < SEQ_LENGTH, "Self-right repeat keyframe out of range");
+
+// Sequencer state
+static bool g_seq_active;
+static uint8_t g_seq_index;          // Current keyframe
+static ServoKeyframe g_seq_frame;    // RAM copy of the current keyframe
+static uint16_t g_seq_from_us;       // Position the current move started from
+static uint32_t g_seq_frame_ms;      // Current keyframe start time
+static uint32_t g_seq_start_ms;      // Sequence start time
+static int16_t g_seq_kick_q12;       // Current keyframe's drive kick (Q12)
+static bool g_trigger_last;          // CH7 at the previous tick (edge detection)
+
 // ============================================================================
 // PRIVATE HELPER FUNCTIONS
 // ============================================================================
 
+// Load a keyframe from flash, starting at start_ms from position from_us
+static void seq_load(uint8_t index, uint32_t start_ms, uint16_t from_us) {
+  memcpy_P(&g_seq_frame, &g_sequence[index], sizeof(g_seq_frame));
+  g_seq_index = index;
+  g_seq_frame_ms = start_ms;
+  g_seq_from_us = from_us;
+  g_seq_kick_q12 = (int16_t)(((int32_t)g_seq_frame.kick_pct * Q12_ONE) / 100);
+}
+
+// Stop the sequence (servo returns to neutral, drive kick off)
+static void seq_stop() {
+  g_seq_active = false;
+  g_seq_kick_q12 = 0;
+}
+
+// Advance the sequence to now and return the servo position
+// held: CH7 still high (replays from the repeat keyframe at the end)
+static uint16_t seq_update(uint32_t now, bool held) {
+  // Step 1: Step over every keyframe that has finished; start times add
+  // up exactly, so a late tick does not stretch the sequence
+  // (bounded, in case the repeat section has no duration)
+  for (uint8_t i = 0; i <= SEQ_LENGTH; i++) {
+    uint32_t duration = (uint32_t)g_seq_frame.move_ms + g_seq_frame.hold_ms;
+    if (now - g_seq_frame_ms < duration) break;
+
+    uint32_t next_ms = g_seq_frame_ms + duration;
+    uint8_t next = g_seq_index + 1;
+    if (next >= SEQ_LENGTH) {
+      if (!held || next_ms - g_seq_start_ms >= SELFRIGHT_MAX_MS) {
+        seq_stop();
+        return g_seq_frame.servo_us;
+      }
+      next = SEQ_REPEAT_FROM;
+    }
+    seq_load(next, next_ms, g_seq_frame.servo_us);
+  }
+
+  // Step 2: Straight line from the previous keyframe, then hold
+  uint32_t elapsed = now - g_seq_frame_ms;
+  if (elapsed >= g_seq_frame.move_ms) return g_seq_frame.servo_us;
+
+  int32_t travel = (int32_t)g_seq_frame.servo_us - g_seq_from_us;
+  return (uint16_t)(g_seq_from_us + travel * (int32_t)elapsed / g_seq_frame.move_ms);
+}
+
 // Calculate servo output with rate limiting and endpoint clamping
 // Returns pulse width in microseconds [SERVO_ENDPOINT_RETRACT, SERVO_ENDPOINT_EXTEND]
 static uint16_t servo_calculate_output() {
-  uint16_t target_us = SERVO_NEUTRAL_US;
-
   // Check if self-right button is pressed AND link is healthy
   // Failsafe: If link lost or kill switch active, return to neutral
   bool button_active = g_state.input.selfright_switch;
   bool link_ok = g_state.input.link_ok;
   bool kill_active = g_state.input.kill_switch;
+  uint32_t now = timebase_millis();
 
-  if (button_active && link_ok && !kill_active) {
-    // Button pressed - move to extended position
-    target_us = SERVO_ENDPOINT_EXTEND;
-  } else {
-    // Button released, link lost, or kill switch active - return to neutral
-    target_us = SERVO_NEUTRAL_US;
+  if (!link_ok || kill_active) {
+    // Link lost or kill switch active - abort any sequence at once
+    // (a button held through it has to be released before the next start)
+    seq_stop();
+  } else if (button_active && !g_trigger_last && !g_seq_active) {
+    // Button pressed - start the sequence from the current position
+    g_seq_active = true;
+    g_seq_start_ms = now;
+    seq_load(0, now, g_servo_previous_us);
   }
+  g_trigger_last = button_active;
 
-  // Apply slew-rate limiting (slow movement to prevent brownouts)
-  int16_t delta = (int16_t)target_us - (int16_t)g_servo_previous_us;
-
-  if (delta > SERVO_SLEW_RATE_MAX) {
-    // Moving toward extended position (slow ramp up)
-    g_servo_previous_us += SERVO_SLEW_RATE_MAX;
-  } else if (delta < -SERVO_SLEW_RATE_MAX) {
-    // Moving toward neutral (slow ramp down)
-    g_servo_previous_us -= SERVO_SLEW_RATE_MAX;
+  if (g_seq_active) {
+    g_servo_previous_us = seq_update(now, button_active);
   } else {
-    // Within slew rate limit - jump directly to target
-    g_servo_previous_us = target_us;
+    // Sequence finished or aborted - return to neutral
+    // Apply slew-rate limiting (slow movement to prevent brownouts)
+    int16_t delta = (int16_t)SERVO_NEUTRAL_US - (int16_t)g_servo_previous_us;
+
+    if (delta > SERVO_SLEW_RATE_MAX) {
+      g_servo_previous_us += SERVO_SLEW_RATE_MAX;
+    } else if (delta < -SERVO_SLEW_RATE_MAX) {
+      g_servo_previous_us -= SERVO_SLEW_RATE_MAX;
+    } else {
+      // Within slew rate limit - jump directly to target
+      g_servo_previous_us = SERVO_NEUTRAL_US;
+    }
   }
 
   // Clamp to safe endpoints (prevent mechanical binding)
@@ -66,9 +151,17 @@ void servo_init() {
   // Initialize servo output to neutral position (safe default)
   g_servo_previous_us = SERVO_NEUTRAL_US;
   g_state.output.servo_us = SERVO_NEUTRAL_US;
+
+  // No sequence running; the button must be seen released before a start
+  seq_stop();
+  g_trigger_last = true;
 }
 
 void servo_update() {
   // Calculate and apply servo output
   g_state.output.servo_us = servo_calculate_output();
 }
+
+int16_t servo_get_drive_kick() {
+  return g_seq_active ? g_seq_kick_q12 : 0;
+}
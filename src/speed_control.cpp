@@ -0,0 +1,89 @@
+// speed_control.cpp - Per-wheel closed-loop speed control (integer PI)
+// UpVote Battlebot - Phase 8
+#include "speed_control.h"
+#include "config.h"
+#include "encoders.h"
+#include "utilities.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Gains in Q12
+#define SPEED_KP_Q12  Q12_FROM_FLOAT(SPEED_KP)
+#define SPEED_KI_Q12  Q12_FROM_FLOAT(SPEED_KI)
+#define SPEED_SLIP_RATIO_Q12  Q12_FROM_FLOAT(SPEED_SLIP_RATIO)
+
+// Edges/s <-> PWM counts, as Q16 multipliers (no divide per tick)
+#define SPEED_PWM_TO_EPS_Q16  (((uint32_t)ENCODER_MAX_EPS << 16) / MOTOR_PWM_MAX)
+#define SPEED_EPS_TO_PWM_Q16  (((uint32_t)MOTOR_PWM_MAX << 16) / ENCODER_MAX_EPS)
+
+static int32_t g_integral[4];  // Accumulated Ki * error (PWM counts, Q12)
+static uint8_t g_slip_mask;    // Wheels currently slipping
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void speed_control_init() {
+  speed_control_reset();
+}
+
+int16_t speed_control_apply(uint8_t motor_index, int16_t command) {
+#if ENCODER_BACKEND == ENCODER_BACKEND_NONE
+  (void)motor_index;
+  return command;
+#else
+  if (motor_index > 3) return 0;
+  uint8_t bit = 1 << motor_index;
+
+  // Stopped wheel: no correction, nothing to integrate
+  if (command == 0) {
+    g_integral[motor_index] = 0;
+    g_slip_mask &= ~bit;
+    return 0;
+  }
+
+  // Step 1: Speed error, converted to PWM counts
+  int32_t target = ((int32_t)command * (int32_t)SPEED_PWM_TO_EPS_Q16) >> 16;
+  int32_t measured = encoders_get_speed(motor_index);
+  int32_t error_eps = target - measured;
+  int16_t error = (int16_t)constrain((error_eps * (int32_t)SPEED_EPS_TO_PWM_Q16) >> 16,
+                                     -2 * MOTOR_PWM_MAX, 2 * MOTOR_PWM_MAX);
+
+  // Step 2: Slip - wheel well over its target speed in the commanded direction
+  int32_t target_abs = (target < 0) ? -target : target;
+  int32_t overspeed = (target < 0) ? -error_eps : error_eps;  // < 0 when too fast
+  int32_t margin = (target_abs * SPEED_SLIP_RATIO_Q12) >> Q12_SHIFT;
+  if (margin < SPEED_SLIP_MIN_EPS) margin = SPEED_SLIP_MIN_EPS;
+
+  if (-overspeed > margin) {
+    // Freeze the integral and fall back to feed-forward so the wheel can
+    // regain grip instead of the loop chasing a free-spinning wheel
+    g_slip_mask |= bit;
+    return command;
+  }
+  g_slip_mask &= ~bit;
+
+  // Step 3: Integral with clamp (anti-windup), kept in Q12 PWM counts
+  const int32_t limit = (int32_t)SPEED_I_LIMIT << Q12_SHIFT;
+  int32_t integral = g_integral[motor_index] + (int32_t)SPEED_KI_Q12 * error;
+  integral = constrain(integral, -limit, limit);
+  g_integral[motor_index] = integral;
+
+  // Step 4: Feed-forward command plus PI correction
+  int32_t output = command + (((int32_t)SPEED_KP_Q12 * error) >> Q12_SHIFT) + (integral >> Q12_SHIFT);
+  return (int16_t)constrain(output, -MOTOR_PWM_MAX, MOTOR_PWM_MAX);
+#endif
+}
+
+void speed_control_reset() {
+  for (uint8_t i = 0; i < 4; i++) {
+    g_integral[i] = 0;
+  }
+  g_slip_mask = 0;
+}
+
+uint8_t speed_control_get_slip_mask() {
+  return g_slip_mask;
+}
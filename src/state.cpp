@@ -2,6 +2,21 @@
 // UpVote Battlebot - Phase 1
 #include "state.h"
 #include "config.h"
+#include <stddef.h>
+
+// ============================================================================
+// LAYOUT CHECKS (Phase 8)
+// ============================================================================
+
+// AVR packs structs without padding; these catch a layout regression
+// (a float or a full-width bool creeping back in, or the hot fields
+// pushed past the ldd/std displacement range)
+#ifdef __AVR__
+static_assert(sizeof(RuntimeState) <= 72, "RuntimeState grew - keep it compact (was 115 bytes)");
+static_assert(offsetof(RuntimeState, loop_stage) <= 64,
+              "Input, output and safety state must stay in the first 64 bytes");
+#endif
+static_assert(sizeof(ArmState) == 1 && sizeof(SystemError) == 1, "State enums must be one byte");
 
 // ============================================================================
 // GLOBAL STATE VARIABLE
@@ -9,23 +24,25 @@
 
 // Initialize all fields to safe defaults
 RuntimeState g_state = {
-  // Timing
-  .loop_start_us = 0,
-  .loop_duration_us = 0,
-
   // Input state
   .input = {
-    .roll = 0.0f,
-    .pitch = 0.0f,
-    .yaw = 0.0f,
-    .throttle = 0.0f,
-    .weapon = 0.0f,
     .arm_switch = false,
     .kill_switch = false,
     .selfright_switch = false,
-    .last_packet_ms = 0,
     .link_ok = false,
-    .raw_channels = {992, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992, 992}  // All at center
+    .raw_channels = {992, 992, 992, 992, 992, 992, 992, 992, 992},  // All at center
+    .weapon = 0,
+    .last_packet_ms = 0
+  },
+
+  // Output state (safe defaults)
+  .output = {
+    .motor_fl_pwm = SAFE_MOTOR_PWM,
+    .motor_fr_pwm = SAFE_MOTOR_PWM,
+    .motor_rl_pwm = SAFE_MOTOR_PWM,
+    .motor_rr_pwm = SAFE_MOTOR_PWM,
+    .weapon_us = SAFE_WEAPON_US,
+    .servo_us = SAFE_SERVO_US
   },
 
   // Safety state
@@ -36,30 +53,25 @@ RuntimeState g_state = {
     .kill_switch_debounced = false,
     .arm_switch_stable_ms = 0,
     .kill_switch_stable_ms = 0,
-    .last_arm_throttle = 0.0f
+    .last_arm_throttle = 0
   },
 
-  // Output state (safe defaults)
-  .output = {
-    .motor_fl_pwm = SAFE_MOTOR_PWM,
-    .motor_fr_pwm = SAFE_MOTOR_PWM,
-    .motor_rl_pwm = SAFE_MOTOR_PWM,
-    .motor_rr_pwm = SAFE_MOTOR_PWM,
-    .weapon_us = SAFE_WEAPON_US,
-    .servo_us = SAFE_SERVO_US
-  },
+  // Timing
+  .loop_stage = STAGE_BOOT,
+  .loop_duration_us = 0,
+  .loop_start_us = 0,
 
   // Diagnostics state
   .diagnostics = {
-    .led_last_update_ms = 0,
     .led_state = false,
     .error_blink_count = 0,
-    .error_blink_phase = 0
+    .error_blink_phase = 0,
+    .led_last_update_ms = 0
   },
 
   // Battery telemetry state
   .battery = {
-    .voltage = 0.0f,
+    .voltage_mv = 0,
     .percentage = 0,
     .last_telemetry_ms = 0
   }
@@ -0,0 +1,119 @@
+// thermal.cpp - L293D thermal model with dynamic duty derating
+// UpVote Battlebot - Phase 8
+#include "thermal.h"
+#include "config.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Derived thresholds (heat units)
+#define THERMAL_DERATE_START_HEAT  THERMAL_HEAT_AT_DUTY(THERMAL_DERATE_START_DUTY)
+#define THERMAL_DERATE_END_HEAT    THERMAL_HEAT_AT_DUTY(THERMAL_DERATE_END_DUTY)
+#define THERMAL_BOOST_ENTRY_HEAT   THERMAL_HEAT_AT_DUTY(THERMAL_BOOST_ENTRY_DUTY)
+#define THERMAL_BOOST_TICKS        (THERMAL_BOOST_MS / LOOP_PERIOD_MS)
+
+// Per-channel model state [RL, RR, FL, FR]
+static struct {
+  uint16_t heat;            // Estimated junction heat (I²t accumulator)
+  uint16_t boost_ticks;     // Remaining boost window (0 = not boosting)
+  uint8_t requested_duty;   // Last duty asked for by the mixer
+  uint8_t duty_limit;       // Cached duty limit for this tick
+  bool boost_ready;         // Boost window may be opened
+} g_thermal[4];
+
+// ============================================================================
+// PRIVATE HELPER FUNCTIONS
+// ============================================================================
+
+// Calculate duty limit for a channel from its heat and boost state
+// Full duty while cool, then linear derating to THERMAL_DUTY_FLOOR (hot).
+// A boost window holds full duty through the derate band.
+static uint8_t thermal_calculate_limit(uint16_t heat, bool boosting) {
+  if (heat <= THERMAL_DERATE_START_HEAT || (boosting && heat < THERMAL_DERATE_END_HEAT)) {
+    return MOTOR_PWM_MAX;
+  }
+  if (heat >= THERMAL_DERATE_END_HEAT) {
+    return THERMAL_DUTY_FLOOR;
+  }
+
+  // Interpolate between full duty and floor
+  uint32_t span = THERMAL_DERATE_END_HEAT - THERMAL_DERATE_START_HEAT;
+  uint32_t over = heat - THERMAL_DERATE_START_HEAT;
+  uint8_t derate = (uint8_t)(((uint32_t)(MOTOR_PWM_MAX - THERMAL_DUTY_FLOOR) * over) / span);
+  return MOTOR_PWM_MAX - derate;
+}
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void thermal_init() {
+  for (uint8_t i = 0; i < 4; i++) {
+    g_thermal[i].heat = 0;
+    g_thermal[i].boost_ticks = 0;
+    g_thermal[i].requested_duty = 0;
+    g_thermal[i].duty_limit = MOTOR_PWM_MAX;
+    g_thermal[i].boost_ready = true;  // Cold at boot - boost available
+  }
+}
+
+uint8_t thermal_clamp_duty(uint8_t motor_index, uint8_t requested_duty) {
+  // Bounds check motor index
+  if (motor_index > 3) return 0;
+
+  g_thermal[motor_index].requested_duty = requested_duty;
+
+  uint8_t limit = g_thermal[motor_index].duty_limit;
+  return (requested_duty > limit) ? limit : requested_duty;
+}
+
+void thermal_update_channel(uint8_t motor_index, uint8_t applied_duty) {
+  // Bounds check motor index
+  if (motor_index > 3) return;
+
+  uint16_t heat = g_thermal[motor_index].heat;
+
+  // Step 1: Integrate I²t heat input and exponential cooling
+  heat -= heat >> THERMAL_TAU_SHIFT;
+  heat += ((uint16_t)applied_duty * applied_duty) >> 8;
+  g_thermal[motor_index].heat = heat;
+
+  // Step 2: Update boost window (wanted when derating would cut the request)
+  bool wants_boost = g_thermal[motor_index].requested_duty >
+                     thermal_calculate_limit(heat, false);
+
+  if (g_thermal[motor_index].boost_ticks > 0) {
+    // Boosting - end window on timeout or once the channel runs out of headroom
+    g_thermal[motor_index].boost_ticks--;
+    if (g_thermal[motor_index].boost_ticks == 0 || heat >= THERMAL_DERATE_END_HEAT) {
+      g_thermal[motor_index].boost_ticks = 0;
+      g_thermal[motor_index].boost_ready = false;  // Must cool down before next boost
+    } else if (!wants_boost) {
+      g_thermal[motor_index].boost_ticks = 0;      // Driver eased off - close window early
+    }
+  } else {
+    // Not boosting - re-arm once cooled, open window on demand
+    if (heat < THERMAL_BOOST_ENTRY_HEAT) {
+      g_thermal[motor_index].boost_ready = true;
+    }
+    if (wants_boost && g_thermal[motor_index].boost_ready &&
+        heat < THERMAL_DERATE_END_HEAT) {
+      g_thermal[motor_index].boost_ticks = THERMAL_BOOST_TICKS;
+    }
+  }
+
+  // Step 3: Cache limit for next tick's thermal_clamp_duty() calls
+  g_thermal[motor_index].duty_limit =
+      thermal_calculate_limit(heat, g_thermal[motor_index].boost_ticks > 0);
+}
+
+uint16_t thermal_get_heat(uint8_t motor_index) {
+  if (motor_index > 3) return 0;
+  return g_thermal[motor_index].heat;
+}
+
+bool thermal_is_boosting(uint8_t motor_index) {
+  if (motor_index > 3) return false;
+  return g_thermal[motor_index].boost_ticks > 0;
+}
@@ -0,0 +1,90 @@
+// timebase.cpp - millis()/micros() that follow the motor PWM timer
+// UpVote Battlebot - Phase 8
+#include "timebase.h"
+#include "config.h"
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#if MOTOR_PWM_PRESCALER != 8 && MOTOR_PWM_PRESCALER != 64
+#error "MOTOR_PWM_PRESCALER must be 8 or 64"
+#endif
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+#if MOTOR_PWM_PRESCALER == 8
+// Overflow counter kept by the core's TIMER0_OVF ISR (wiring.c)
+extern volatile unsigned long timer0_overflow_count;
+
+// Core time runs 64 / MOTOR_PWM_PRESCALER = 8x fast: it adds 1.024ms per
+// overflow, which now takes 256 * 0.5us = 128us. Milliseconds are counted
+// here from the overflows instead (the core's millis() / 8 would wrap to 0
+// from 2^29 after ~6.2 days)
+#define TIMEBASE_OVERFLOW_US  128
+
+static uint32_t g_ms_overflows;   // Overflow count at the last update
+static uint32_t g_ms;             // Milliseconds since boot (wraps at 2^32)
+static uint16_t g_ms_us;          // Microseconds not yet counted in g_ms
+#endif
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+uint32_t timebase_millis() {
+#if MOTOR_PWM_PRESCALER == 64
+  return millis();
+#else
+  uint32_t ms;
+
+  // Adds the overflows since the last call (modular: right across the
+  // overflow counter's wrap). Called every tick, so there are fewer than
+  // 125 (16ms) and the remainder loop is short; longer gaps divide once.
+  // Atomic: the CRSF receive interrupt calls this too
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    uint32_t overflows = timer0_overflow_count;
+    uint32_t elapsed = overflows - g_ms_overflows;
+    g_ms_overflows = overflows;
+    if (elapsed >= 125) {
+      g_ms += (elapsed / 125) * 16;   // 125 overflows = 16ms exactly
+      elapsed %= 125;
+    }
+    uint16_t us = g_ms_us + (uint16_t)elapsed * TIMEBASE_OVERFLOW_US;
+    while (us >= 1000) {
+      us -= 1000;
+      g_ms++;
+    }
+    g_ms_us = us;
+    ms = g_ms;
+  }
+  return ms;
+#endif
+}
+
+uint32_t timebase_micros() {
+#if MOTOR_PWM_PRESCALER == 64
+  return micros();
+#else
+  uint32_t overflows;
+  uint8_t count;
+
+  // Same sampling as the core's micros(): an overflow that is pending but
+  // not yet counted belongs to this reading unless TCNT0 just wrapped past it
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    overflows = timer0_overflow_count;
+    count = TCNT0;
+    if ((TIFR0 & _BV(TOV0)) && count < 255) overflows++;
+  }
+
+  // 128us per overflow, 0.5us per count (wraps cleanly at 2^32 us)
+  return (overflows << 7) + (count >> 1);
+#endif
+}
+
+void timebase_delay_ms(uint16_t ms) {
+  uint32_t start_us = timebase_micros();
+  while (timebase_micros() - start_us < (uint32_t)ms * 1000UL) {
+    // Busy-wait
+  }
+}
@@ -6,20 +6,76 @@
 // SWITCH DEBOUNCING UTILITY
 // ============================================================================
 
-void debounce_switch(bool raw_state,
-                     bool *debounced_state,
+bool debounce_switch(bool raw_state,
+                     bool debounced_state,
                      uint32_t *stable_time_ms,
                      uint8_t debounce_ms,
                      uint32_t now) {
   // Check if raw state matches debounced state
-  if (raw_state != *debounced_state) {
+  if (raw_state != debounced_state) {
     // State changed, check if it's been stable long enough
     if ((now - *stable_time_ms) >= debounce_ms) {
       // Stable for long enough, accept the change
-      *debounced_state = raw_state;
+      return raw_state;
     }
   } else {
     // State matches, reset the stability timer
     *stable_time_ms = now;
   }
+  return debounced_state;
+}
+
+// ============================================================================
+// JERK-LIMITED (S-CURVE) FOLLOWER
+// ============================================================================
+
+void scurve_update(SCurveState *state, int16_t target, const SCurveLimits *limits) {
+  int16_t value = state->value;
+  int32_t rate = state->rate;
+  int32_t error = (int32_t)target - value;
+
+  // Step 0: Never run on past the target. A rate pointing away from it
+  // (the target moved onto or behind the output mid-ramp) is dropped at
+  // once: the output holds, then ramps toward the new target
+  if (error == 0) {
+    state->rate = 0;
+    return;
+  }
+  if ((rate > 0 && error < 0) || (rate < 0 && error > 0)) {
+    rate = 0;
+  }
+
+  // Step 1: Pick rate limit - moving toward zero uses the decel limit
+  int8_t direction = (error > 0) ? 1 : -1;
+  bool toward_zero = (value > 0 && direction < 0) || (value < 0 && direction > 0);
+  int32_t rate_limit = toward_zero ? limits->rate_toward : limits->rate_away;
+
+  // Step 2: Desired rate - full speed toward target, or zero once the
+  // stopping distance (rate^2 / 2*jerk) reaches the remaining error
+  int32_t desired = direction * rate_limit;
+  if (rate * direction > 0) {
+    uint32_t distance = (uint32_t)(error > 0 ? error : -error);
+    if ((uint32_t)(rate * rate) >= 2UL * (uint32_t)limits->rate_step * distance) {
+      desired = 0;
+    }
+  }
+
+  // Step 3: Jerk limit - rate moves toward desired by at most rate_step
+  if (desired > rate + limits->rate_step) {
+    rate += limits->rate_step;
+  } else if (desired < rate - limits->rate_step) {
+    rate -= limits->rate_step;
+  } else {
+    rate = desired;
+  }
+
+  // Step 4: Integrate, snapping to target on arrival
+  int32_t next = value + rate;
+  if ((direction > 0 && next >= target) || (direction < 0 && next <= target)) {
+    state->value = target;
+    state->rate = 0;
+  } else {
+    state->value = (int16_t)next;
+    state->rate = (int16_t)rate;
+  }
 }
@@ -5,13 +5,56 @@
 #include "state.h"
 #include "safety.h"
 #include "utilities.h"
+#include "mixing.h"
+#include "profiles.h"
+#include "timebase.h"
+#include "actuators.h"
+#include "weapon_rpm.h"
+#include "error_log.h"
 
 // ============================================================================
 // PRIVATE STATE
 // ============================================================================
 
-// Previous weapon command (for slew-rate limiting)
-static uint16_t g_weapon_previous_us = WEAPON_ESC_MIN_US;
+// Weapon ramp: S-curve follower over the ESC range, in 1/16 us above
+// WEAPON_ESC_MIN_US (extra resolution so long ramps keep a non-zero rate)
+#define WEAPON_RAMP_SHIFT   4
+#define WEAPON_RAMP_RANGE   ((int16_t)(WEAPON_ESC_MAX_US - WEAPON_ESC_MIN_US) << WEAPON_RAMP_SHIFT)
+
+// Arming thresholds in the Q12 throttle units of g_state.input.weapon
+#define ARM_THROTTLE_Q12    Q12_FROM_FLOAT(ARM_THROTTLE_THRESHOLD)
+#define REARM_THROTTLE_Q12  Q12_FROM_FLOAT(REARM_THROTTLE_THRESHOLD)
+
+static SCurveState g_weapon_ramp = {0, 0};
+static uint32_t g_weapon_ramp_ms;      // Time the ramp has advanced to
+
+// Ramp limits (per WEAPON_RAMP_STEP_MS) from the active profile, cached
+// until the drive mode, the profile or the low-battery state changes
+static SCurveLimits g_weapon_limits;
+static uint8_t g_weapon_limits_mode = 0xFF;
+static uint8_t g_weapon_limits_generation;
+static bool g_weapon_limits_lowbat;
+
+// Governor gains and limits (Q12 gains, limits in ramp units)
+#if WEAPON_GOVERNOR_ENABLED && WEAPON_RPM_BACKEND == WEAPON_RPM_BACKEND_NONE
+#error "WEAPON_GOVERNOR_ENABLED needs an RPM source (WEAPON_RPM_BACKEND)"
+#endif
+#define WEAPON_GOV_KP_Q12      Q12_FROM_FLOAT(WEAPON_GOV_KP)
+#define WEAPON_GOV_KI_Q12      Q12_FROM_FLOAT(WEAPON_GOV_KI)
+#define WEAPON_GOV_LIMIT       ((int16_t)(WEAPON_GOV_AUTHORITY * WEAPON_RAMP_RANGE))
+#define WEAPON_GOV_FAULT_LEVEL ((int16_t)(WEAPON_RAMP_RANGE / 100 * WEAPON_GOV_FAULT_PCT))
+#define WEAPON_GOV_FAULT_TICKS (WEAPON_GOV_FAULT_MS / LOOP_PERIOD_MS)
+
+static int16_t g_gov_integral;         // Accumulated Ki * error (ramp units)
+static uint8_t g_gov_fault_ticks;      // Ticks at speed with no RPM reading
+static bool g_gov_fault;               // Sensor fault - open loop until at rest
+
+// Impact log
+static WeaponImpactLog g_impact_log;
+static uint16_t g_impact_settled_rpm;  // Filtered RPM while the ramp is settled
+static uint16_t g_impact_from_rpm;     // Settled RPM when the impact started
+static uint32_t g_impact_start_ms;
+static bool g_impact_active;
 
 // ============================================================================
 // PRIVATE HELPER FUNCTIONS
@@ -20,21 +63,23 @@ static uint16_t g_weapon_previous_us = WEAPON_ESC_MIN_US;
 // Debounce switch inputs
 // Updates g_state.safety.arm_switch_debounced and kill_switch_debounced
 static void weapon_update_switch_debounce() {
-  uint32_t now = millis();
+  uint32_t now = timebase_millis();
 
   // Debounce ARM switch using utility function
-  debounce_switch(g_state.input.arm_switch,
-                  &g_state.safety.arm_switch_debounced,
-                  &g_state.safety.arm_switch_stable_ms,
-                  SWITCH_DEBOUNCE_MS,
-                  now);
+  g_state.safety.arm_switch_debounced =
+      debounce_switch(g_state.input.arm_switch,
+                      g_state.safety.arm_switch_debounced,
+                      &g_state.safety.arm_switch_stable_ms,
+                      SWITCH_DEBOUNCE_MS,
+                      now);
 
   // Debounce KILL switch using utility function
-  debounce_switch(g_state.input.kill_switch,
-                  &g_state.safety.kill_switch_debounced,
-                  &g_state.safety.kill_switch_stable_ms,
-                  SWITCH_DEBOUNCE_MS,
-                  now);
+  g_state.safety.kill_switch_debounced =
+      debounce_switch(g_state.input.kill_switch,
+                      g_state.safety.kill_switch_debounced,
+                      &g_state.safety.kill_switch_stable_ms,
+                      SWITCH_DEBOUNCE_MS,
+                      now);
 }
 
 // Update arming state machine
@@ -43,7 +88,7 @@ static void weapon_update_arming() {
   bool arm_switch = g_state.safety.arm_switch_debounced;
   bool kill_active = g_state.safety.kill_switch_debounced;
   bool link_ok = g_state.input.link_ok;
-  float throttle = g_state.input.weapon;
+  int16_t throttle = g_state.input.weapon;  // Q12
   SystemError error = g_state.safety.error;
 
   // ========================================================================
@@ -57,6 +102,13 @@ static void weapon_update_arming() {
   if (!link_ok) should_disarm = true;         // Link loss
   if (error != ERR_NONE) should_disarm = true; // System error
 
+  // Phase 8: Emergency stop (fast kill path) - the ESC is already at
+  // minimum, restart the ramp from there
+  if (actuators_take_stop_event()) {
+    should_disarm = true;
+    scurve_reset(&g_weapon_ramp, 0);
+  }
+
   if (should_disarm) {
     g_state.safety.arm_state = DISARMED;
     // Store throttle value for hysteresis
@@ -74,15 +126,15 @@ static void weapon_update_arming() {
     // below REARM threshold before allowing arm
     bool throttle_ok = false;
 
-    if (g_state.safety.last_arm_throttle > ARM_THROTTLE_THRESHOLD) {
+    if (g_state.safety.last_arm_throttle > ARM_THROTTLE_Q12) {
       // Previously had high throttle, need to go lower
-      if (throttle < REARM_THROTTLE_THRESHOLD) {
+      if (throttle < REARM_THROTTLE_Q12) {
         throttle_ok = true;
         g_state.safety.last_arm_throttle = throttle; // Update stored value
       }
     } else {
       // Previously had low throttle, just check against ARM threshold
-      if (throttle <= ARM_THROTTLE_THRESHOLD) {
+      if (throttle <= ARM_THROTTLE_Q12) {
         throttle_ok = true;
       }
     }
@@ -105,39 +157,175 @@ static void weapon_update_arming() {
   // If already armed, state remains ARMED (unless disarm conditions triggered above)
 }
 
-// Calculate weapon output with slew-rate limiting
-// Returns pulse width in microseconds [WEAPON_ESC_MIN_US, WEAPON_ESC_MAX_US]
-static uint16_t weapon_calculate_output() {
-  uint16_t target_us = WEAPON_ESC_MIN_US;
+// Convert a full-range ramp time (ms) to a rate per ramp step
+// Rounds up so a non-zero time never becomes a zero rate; 0 ms = no ramp
+static int16_t weapon_ramp_rate(uint32_t ms) {
+  if (ms == 0) return INT16_MAX;
+  uint32_t rate = ((uint32_t)WEAPON_RAMP_RANGE * WEAPON_RAMP_STEP_MS + ms - 1) / ms;
+  return (rate > INT16_MAX) ? INT16_MAX : (int16_t)rate;
+}
 
-  if (g_state.safety.arm_state == ARMED) {
-    // Scale weapon throttle [0.0, 1.0] to ESC range [MIN_US, MAX_US]
-    float throttle = g_state.input.weapon;
+// Low battery reading from the telemetry monitor (no reading yet = OK)
+static bool weapon_battery_low() {
+#if CRSF_TELEMETRY_ENABLED
+  return g_state.battery.last_telemetry_ms != 0 &&
+         g_state.battery.percentage < WEAPON_LOWBAT_PCT;
+#else
+  return false;
+#endif
+}
 
-    // Clamp throttle to valid range
-    if (throttle < 0.0f) throttle = 0.0f;
-    if (throttle > 1.0f) throttle = 1.0f;
+// Refresh the cached ramp limits if the active profile changed
+static void weapon_update_ramp_limits() {
+  uint8_t mode = mixing_get_drive_mode();
+  uint8_t generation = profiles_get_generation();
+  bool lowbat = weapon_battery_low();
+  if (mode == g_weapon_limits_mode && generation == g_weapon_limits_generation &&
+      lowbat == g_weapon_limits_lowbat) return;
+
+  g_weapon_limits_mode = mode;
+  g_weapon_limits_generation = generation;
+  g_weapon_limits_lowbat = lowbat;
+
+  // Spin-up grows the value (rate_away), spin-down shrinks it (rate_toward)
+  const DriveProfile* profile = profiles_get(mode);
+  uint32_t spinup_ms = profile->weapon_spinup_ms;
+  if (lowbat) spinup_ms = spinup_ms * WEAPON_LOWBAT_RAMP_PCT / 100;
+  g_weapon_limits.rate_away = weapon_ramp_rate(spinup_ms);
+  g_weapon_limits.rate_toward = weapon_ramp_rate(profile->weapon_spindown_ms);
+
+  // Jerk: reach the faster of the two rates within WEAPON_RAMP_JERK_MS
+  int16_t fastest = (g_weapon_limits.rate_away > g_weapon_limits.rate_toward) ?
+                    g_weapon_limits.rate_away : g_weapon_limits.rate_toward;
+  uint32_t step = ((uint32_t)fastest * WEAPON_RAMP_STEP_MS + WEAPON_RAMP_JERK_MS - 1) / WEAPON_RAMP_JERK_MS;
+  g_weapon_limits.rate_step = (fastest == INT16_MAX || step > INT16_MAX) ? INT16_MAX : (int16_t)step;
+}
 
-    // Map to microseconds
-    uint16_t range_us = WEAPON_ESC_MAX_US - WEAPON_ESC_MIN_US;
-    target_us = WEAPON_ESC_MIN_US + (uint16_t)(throttle * range_us);
+// Trim the ramped throttle to hold the RPM it stands for (governor)
+// reference: ramp output, also the open-loop throttle (ramp units)
+// settled: ramp has reached the slider target
+// Returns: Throttle in ramp units [0, WEAPON_RAMP_RANGE]
+static int16_t weapon_governor(int16_t reference, bool settled) {
+#if WEAPON_GOVERNOR_ENABLED
+  uint16_t rpm = weapon_rpm_get();
+
+  // Step 1: Sensor fault - throttle well up but no RPM for a while
+  // Open loop from then on, until the weapon is back at rest
+  if (reference == 0 && rpm == 0) g_gov_fault = false;
+  if (reference >= WEAPON_GOV_FAULT_LEVEL && rpm == 0) {
+    if (g_gov_fault_ticks < WEAPON_GOV_FAULT_TICKS) g_gov_fault_ticks++;
+    else g_gov_fault = true;
   } else {
-    // Disarmed - always minimum throttle
-    target_us = WEAPON_ESC_MIN_US;
+    g_gov_fault_ticks = 0;
   }
 
-  // Apply slew-rate limiting (slower than drive motors for safety)
-  int16_t delta = (int16_t)target_us - (int16_t)g_weapon_previous_us;
+  if (reference == 0 || g_gov_fault) {
+    g_gov_integral = 0;
+    return reference;
+  }
 
-  if (delta > WEAPON_SLEW_RATE_MAX) {
-    g_weapon_previous_us += WEAPON_SLEW_RATE_MAX;
-  } else if (delta < -WEAPON_SLEW_RATE_MAX) {
-    g_weapon_previous_us -= WEAPON_SLEW_RATE_MAX;
-  } else {
-    g_weapon_previous_us = target_us;
+  // Step 2: RPM error in ramp units (full range = WEAPON_RPM_MAX)
+  int32_t measured = (int32_t)rpm * WEAPON_RAMP_RANGE / WEAPON_RPM_MAX;
+  int16_t error = (int16_t)constrain((int32_t)reference - measured,
+                                     -WEAPON_RAMP_RANGE, WEAPON_RAMP_RANGE);
+
+  // Step 3: Open-loop throttle plus PI correction, correction limited
+  int16_t correction = constrain((int32_t)q12_mul(WEAPON_GOV_KP_Q12, error) + g_gov_integral,
+                                 -WEAPON_GOV_LIMIT, WEAPON_GOV_LIMIT);
+  int32_t output = (int32_t)reference + correction;
+
+  // Step 4: Integral with clamp (anti-windup), held while the ramp moves
+  // (spin-up lag) and while the throttle is pinned at full (after a hit)
+  bool pinned = (output >= WEAPON_RAMP_RANGE && error > 0);
+  if (settled && !pinned) {
+    int16_t integral = g_gov_integral + q12_mul(WEAPON_GOV_KI_Q12, error);
+    g_gov_integral = constrain(integral, -WEAPON_GOV_LIMIT, WEAPON_GOV_LIMIT);
+  }
+
+  return (int16_t)constrain(output, 0, WEAPON_RAMP_RANGE);
+#else
+  (void)settled;
+  return reference;
+#endif
+}
+
+// Log recovery time after hits: a sudden drop below the settled RPM starts
+// an impact, getting back within WEAPON_IMPACT_RECOVER_PCT of it ends one
+static void weapon_update_impact_log(bool settled) {
+  if (!weapon_rpm_available()) return;
+
+  uint16_t rpm = weapon_rpm_get();
+  uint32_t now = timebase_millis();
+  bool armed = (g_state.safety.arm_state == ARMED);
+
+  // Step 1: Impact in progress - wait for recovery (dropped if the slider
+  // moves, the weapon disarms or it takes too long)
+  if (g_impact_active) {
+    uint32_t elapsed = now - g_impact_start_ms;
+    if (!settled || !armed || elapsed > WEAPON_IMPACT_TIMEOUT_MS) {
+      g_impact_active = false;
+    } else if ((uint32_t)rpm * 100 >= (uint32_t)g_impact_from_rpm * (100 - WEAPON_IMPACT_RECOVER_PCT)) {
+      g_impact_active = false;
+      g_impact_log.count++;
+      g_impact_log.last_recovery_ms = (uint16_t)elapsed;
+      if (elapsed > g_impact_log.worst_recovery_ms) {
+        // New slowest recovery: into the error history (context: ms)
+        g_impact_log.worst_recovery_ms = (uint16_t)elapsed;
+        error_log_record(ERR_WEAPON_RECOVERY, (uint16_t)elapsed);
+      }
+    }
+    if (!g_impact_active) g_impact_settled_rpm = rpm;
+    return;
+  }
+
+  // Step 2: Track the settled speed, a sudden drop starts an impact
+  if (!settled || !armed) {
+    g_impact_settled_rpm = rpm;
+    return;
+  }
+  if (g_impact_settled_rpm >= WEAPON_IMPACT_MIN_RPM &&
+      (uint32_t)rpm * 100 < (uint32_t)g_impact_settled_rpm * (100 - WEAPON_IMPACT_DROP_PCT)) {
+    g_impact_active = true;
+    g_impact_start_ms = now;
+    g_impact_from_rpm = g_impact_settled_rpm;
+    return;
   }
+  g_impact_settled_rpm += ((int32_t)rpm - g_impact_settled_rpm) >> 2;
+}
 
-  return g_weapon_previous_us;
+// Calculate weapon output with the S-curve ramp
+// Returns pulse width in microseconds [WEAPON_ESC_MIN_US, WEAPON_ESC_MAX_US]
+static uint16_t weapon_calculate_output() {
+  int16_t target = 0;
+
+  if (g_state.safety.arm_state == ARMED) {
+    // Scale weapon throttle [0, Q12_ONE] to the ramp range
+    // (with the governor: target RPM as a fraction of WEAPON_RPM_MAX)
+    int16_t throttle = constrain(g_state.input.weapon, 0, Q12_ONE);
+    target = (int16_t)(((int32_t)throttle * WEAPON_RAMP_RANGE) >> Q12_SHIFT);
+  }
+  // Disarmed: target stays 0 and the output ramps down to minimum throttle
+
+  // Advance the ramp by the elapsed time in fixed steps (no divide);
+  // after a long stall, skip ahead rather than replaying every step
+  weapon_update_ramp_limits();
+  uint32_t now = timebase_millis();
+  uint8_t steps = 0;
+  while (now - g_weapon_ramp_ms >= WEAPON_RAMP_STEP_MS) {
+    if (++steps > WEAPON_RAMP_MAX_STEPS) {
+      g_weapon_ramp_ms = now;
+      break;
+    }
+    g_weapon_ramp_ms += WEAPON_RAMP_STEP_MS;
+    scurve_update(&g_weapon_ramp, target, &g_weapon_limits);
+  }
+
+  // Governor trims the ramped value, the impact log watches the result
+  bool settled = (g_weapon_ramp.value == target && g_weapon_ramp.rate == 0);
+  int16_t throttle = weapon_governor(g_weapon_ramp.value, settled);
+  weapon_update_impact_log(settled);
+
+  return WEAPON_ESC_MIN_US + (throttle >> WEAPON_RAMP_SHIFT);
 }
 
 // ============================================================================
@@ -146,7 +334,7 @@ static uint16_t weapon_calculate_output() {
 
 void weapon_init() {
   // Initialize debounce state
-  uint32_t now = millis();
+  uint32_t now = timebase_millis();
   g_state.safety.arm_switch_stable_ms = now;
   g_state.safety.kill_switch_stable_ms = now;
   g_state.safety.arm_switch_debounced = false;
@@ -154,11 +342,22 @@ void weapon_init() {
 
   // Initialize arming state
   g_state.safety.arm_state = DISARMED;  // CRITICAL: Always boot to DISARMED
-  g_state.safety.last_arm_throttle = 0.0f;
+  g_state.safety.last_arm_throttle = 0;
 
   // Initialize weapon output
-  g_weapon_previous_us = WEAPON_ESC_MIN_US;
+  scurve_reset(&g_weapon_ramp, 0);
+  g_weapon_ramp_ms = now;
   g_state.output.weapon_us = WEAPON_ESC_MIN_US;
+
+  // Initialize governor and impact log
+  g_gov_integral = 0;
+  g_gov_fault_ticks = 0;
+  g_gov_fault = false;
+  g_impact_log.count = 0;
+  g_impact_log.last_recovery_ms = 0;
+  g_impact_log.worst_recovery_ms = 0;
+  g_impact_settled_rpm = 0;
+  g_impact_active = false;
 }
 
 void weapon_update() {
@@ -171,3 +370,11 @@ void weapon_update() {
   // Calculate and apply weapon output
   g_state.output.weapon_us = weapon_calculate_output();
 }
+
+uint16_t weapon_get_target_rpm() {
+  return (uint16_t)((uint32_t)g_weapon_ramp.value * WEAPON_RPM_MAX / WEAPON_RAMP_RANGE);
+}
+
+const WeaponImpactLog* weapon_get_impact_log() {
+  return &g_impact_log;
+}
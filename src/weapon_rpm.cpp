@@ -0,0 +1,173 @@
+// weapon_rpm.cpp - Weapon RPM measurement
+// UpVote Battlebot - Phase 8
+#include "weapon_rpm.h"
+#include "config.h"
+#include "state.h"
+#include "timebase.h"
+#include <util/atomic.h>
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+#define WEAPON_RPM_TIMEOUT_US  ((uint32_t)WEAPON_RPM_TIMEOUT_MS * 1000UL)
+
+// RPM = WEAPON_RPM_PERIOD_SCALE / pulse period (us)
+#define WEAPON_RPM_PERIOD_SCALE  (60000000UL / WEAPON_TACH_PULSES_PER_REV)
+
+// Pulse capture, written by the ISR (or the simulation)
+static volatile uint16_t g_pulse_count;   // Free-running pulse counter
+static volatile uint32_t g_pulse_us;      // Time of the latest pulse
+
+// Estimator state
+static uint16_t g_last_count;             // Counter value at the previous estimate
+static uint32_t g_last_pulse_us;          // Pulse time at the previous estimate
+static bool g_have_reference;             // g_last_pulse_us is recent enough to time from
+static uint16_t g_rpm;
+
+// ============================================================================
+// PULSE CAPTURE
+// ============================================================================
+
+#if WEAPON_RPM_BACKEND == WEAPON_RPM_BACKEND_TACH
+#if ENCODER_BACKEND == ENCODER_BACKEND_HW
+#error "PIN_WEAPON_TACH (INT0) is the FR encoder pin - use one or the other"
+#endif
+
+// Pin 2 (PD2): tach on external interrupt 0 (falling edge, open collector)
+ISR(INT0_vect) {
+  g_pulse_us = timebase_micros();
+  g_pulse_count++;
+}
+
+static void capture_init() {
+  pinMode(PIN_WEAPON_TACH, INPUT_PULLUP);
+
+  EICRA = (EICRA & ~(_BV(ISC01) | _BV(ISC00))) | _BV(ISC01);
+  EIMSK |= _BV(INT0);
+}
+
+static void capture_update() {
+  // Pulses arrive from the ISR
+}
+
+#elif WEAPON_RPM_BACKEND == WEAPON_RPM_BACKEND_SIM
+// Simulated weapon: first-order response to the ESC output, free speed
+// falling with the battery, and a hit knocking off speed every period
+#define SIM_HIT_TICKS  (WEAPON_SIM_HIT_PERIOD_MS / LOOP_PERIOD_MS)
+
+static uint32_t g_sim_rpm_q4;       // Weapon speed (RPM * 16)
+static uint32_t g_sim_pulse_acc;    // Fractional pulses (Q16)
+static uint16_t g_sim_ticks;        // Hit schedule
+
+static void capture_init() {
+  g_sim_rpm_q4 = 0;
+  g_sim_pulse_acc = 0;
+  g_sim_ticks = 0;
+}
+
+static void capture_update() {
+  // Step 1: Free speed for the battery, scaled by last tick's throttle
+  uint8_t battery = 100;
+#if CRSF_TELEMETRY_ENABLED
+  if (g_state.battery.last_telemetry_ms != 0) battery = g_state.battery.percentage;
+#endif
+  uint32_t free_rpm = (uint32_t)WEAPON_RPM_MAX *
+                      (WEAPON_SIM_SAG_PCT * 100UL + (100 - WEAPON_SIM_SAG_PCT) * battery) / 10000;
+
+  uint16_t us = g_state.output.weapon_us;
+  if (us < WEAPON_ESC_MIN_US) us = WEAPON_ESC_MIN_US;
+  if (us > WEAPON_ESC_MAX_US) us = WEAPON_ESC_MAX_US;
+  int32_t target_q4 = (int32_t)((free_rpm << 4) * (us - WEAPON_ESC_MIN_US) /
+                                (WEAPON_ESC_MAX_US - WEAPON_ESC_MIN_US));
+
+  // Step 2: First-order response, then the periodic hit
+  int32_t rpm_q4 = (int32_t)g_sim_rpm_q4;
+  rpm_q4 += (target_q4 - rpm_q4) >> WEAPON_SIM_TAU_SHIFT;
+  if (++g_sim_ticks >= SIM_HIT_TICKS) {
+    g_sim_ticks = 0;
+    rpm_q4 -= rpm_q4 * WEAPON_SIM_HIT_PCT / 100;
+  }
+  g_sim_rpm_q4 = (rpm_q4 > 0) ? (uint32_t)rpm_q4 : 0;
+
+  // Step 3: Emit whole pulses, timestamped where they fell within the tick
+  uint32_t pps_q4 = g_sim_rpm_q4 * WEAPON_TACH_PULSES_PER_REV / 60;
+  g_sim_pulse_acc += (pps_q4 << 12) / LOOP_RATE_HZ;
+  uint16_t pulses = g_sim_pulse_acc >> 16;
+  g_sim_pulse_acc &= 0xFFFF;
+  if (pulses > 0) {
+    uint32_t period_us = 16000000UL / pps_q4;
+    g_pulse_count += pulses;
+    g_pulse_us = timebase_micros() - ((g_sim_pulse_acc * period_us) >> 16);
+  }
+}
+
+#else
+static void capture_init() {
+}
+
+static void capture_update() {
+}
+#endif
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void weapon_rpm_init() {
+  g_pulse_count = 0;
+  g_pulse_us = 0;
+  g_last_count = 0;
+  g_last_pulse_us = 0;
+  g_have_reference = false;
+  g_rpm = 0;
+  capture_init();
+}
+
+void weapon_rpm_update() {
+  capture_update();
+
+  // Step 1: Snapshot capture state (32-bit values are not atomic on AVR)
+  uint16_t count;
+  uint32_t pulse_us;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    count = g_pulse_count;
+    pulse_us = g_pulse_us;
+  }
+
+  uint16_t pulses = count - g_last_count;
+  uint32_t rpm = g_rpm;
+
+  if (pulses > 0) {
+    // Step 2: Mean period over every pulse since the last estimate, timed
+    // edge to edge (the first pulse after a stop only starts the timing)
+    uint32_t span = pulse_us - g_last_pulse_us;
+    if (g_have_reference && span > 0) {
+      uint32_t period = span / pulses;
+      rpm = (period > 0) ? WEAPON_RPM_PERIOD_SCALE / period : UINT16_MAX;
+    }
+    g_last_count = count;
+    g_last_pulse_us = pulse_us;
+    g_have_reference = true;
+  } else {
+    // Step 3: No pulse this tick - an overdue pulse bounds the speed from
+    // above, and none for WEAPON_RPM_TIMEOUT_MS means stopped
+    uint32_t age = timebase_micros() - g_last_pulse_us;
+    if (!g_have_reference || age > WEAPON_RPM_TIMEOUT_US) {
+      rpm = 0;
+      g_have_reference = false;
+    } else if (age > 0 && WEAPON_RPM_PERIOD_SCALE / age < rpm) {
+      rpm = WEAPON_RPM_PERIOD_SCALE / age;
+    }
+  }
+
+  g_rpm = (rpm > UINT16_MAX) ? UINT16_MAX : (uint16_t)rpm;
+}
+
+uint16_t weapon_rpm_get() {
+  return g_rpm;
+}
+
+bool weapon_rpm_available() {
+  return WEAPON_RPM_BACKEND != WEAPON_RPM_BACKEND_NONE;
+}
@@ -0,0 +1,50 @@
+// yaw_control.cpp - Closed-loop yaw-rate controller (fixed-point PI)
+// UpVote Battlebot - Phase 8
+#include "yaw_control.h"
+#include "config.h"
+#include "gyro.h"
+#include "utilities.h"
+
+// ============================================================================
+// PRIVATE STATE
+// ============================================================================
+
+// Gains and limits in Q12
+#define YAW_KP_Q12       Q12_FROM_FLOAT(YAW_KP)
+#define YAW_KI_Q12       Q12_FROM_FLOAT(YAW_KI)
+#define YAW_I_LIMIT_Q12  Q12_FROM_FLOAT(YAW_I_LIMIT)
+
+static int16_t g_integral;  // Accumulated Ki * error (Q12)
+
+// ============================================================================
+// PUBLIC INTERFACE
+// ============================================================================
+
+void yaw_control_init() {
+  g_integral = 0;
+}
+
+int16_t yaw_control_update(int16_t rate_cmd_q12, bool driving) {
+  // Open loop without a working gyro, or while parked (no creeping on
+  // gyro noise, and no integral wind-up while the robot sits still)
+  if (!driving || !gyro_is_healthy()) {
+    g_integral = 0;
+    return rate_cmd_q12;
+  }
+
+  // Step 1: Rate error (Q12, clamped so products fit int32)
+  int16_t error = (int16_t)constrain((int32_t)rate_cmd_q12 - gyro_get_yaw_rate(),
+                                     -2 * Q12_ONE, 2 * Q12_ONE);
+
+  // Step 2: Integral with clamp (anti-windup)
+  int16_t integral = g_integral + q12_mul(YAW_KI_Q12, error);
+  g_integral = constrain(integral, -YAW_I_LIMIT_Q12, YAW_I_LIMIT_Q12);
+
+  // Step 3: Feed-forward command plus PI correction, limited to full rotation
+  int32_t output = (int32_t)rate_cmd_q12 + q12_mul(YAW_KP_Q12, error) + g_integral;
+  return (int16_t)constrain(output, -Q12_ONE, Q12_ONE);
+}
+
+void yaw_control_reset() {
+  g_integral = 0;
+}
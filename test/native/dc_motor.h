@@ -0,0 +1,78 @@
+// dc_motor.h - Brushed DC motor on an L293D channel, simulated edge by edge
+// UpVote Battlebot - Phase 8
+//
+// Small gear motor on 2S: 7.4 V, 4 ohm / 1.5 mH winding, back-EMF 6.8 V at
+// no-load speed (speed is in units of no-load speed), 150 ms mechanical
+// time constant, friction worth 0.1 A (it also holds a stopped rotor).
+// PWM is simulated edge by edge (fast PWM, 256 counts per period): while
+// the enable is high the L293D drives the supply across the winding (or
+// shorts it, braking); while low its outputs float and the current decays
+// through the flyback diodes against the supply, then stops.
+// Shared by the native suites that drive a wheel (include after config.h).
+#ifndef DC_MOTOR_H
+#define DC_MOTOR_H
+
+#include <math.h>
+#include <string.h>
+
+#define MOTOR_V       7.4
+#define MOTOR_R       4.0
+#define MOTOR_L       1.5e-3
+#define MOTOR_KE      6.8
+#define MOTOR_J       (0.150 * MOTOR_KE * MOTOR_KE / MOTOR_R)
+#define MOTOR_FRICTION_A  0.1
+#define DIODE_V       0.7
+#define SIM_DT        1e-6          // Integration step (s)
+#define TOP_SPEED_MM_S  1000.0      // Wheel surface speed at no-load speed
+
+// PWM period at a Timer0/Timer2 prescaler (us)
+#define DC_MOTOR_PERIOD_US(prescaler)  (256UL * (prescaler) / (F_CPU / 1000000UL))
+
+struct DcMotor {
+  double speed;       // Fraction of no-load speed
+  double current;     // Winding current (A, positive = forward)
+  double travel_mm;   // Since last cleared
+  double peak_a;      // Since last cleared
+  double charge;      // Integral of current (A*s), since last cleared
+  bool locked;        // Rotor held still (stall torque)
+};
+
+// Advance the motor for duration_us in one channel state
+// period_us: PWM period; duty 0-255; drive direction +1/-1, or brake
+static void dc_motor_run(DcMotor* m, uint32_t period_us, uint8_t duty, int8_t dir,
+                         bool brake, uint32_t duration_us) {
+  uint32_t on_us = (period_us * duty) / MOTOR_PWM_MAX;
+  for (uint32_t us = 0; us < duration_us; us++) {
+    double emf = MOTOR_KE * m->speed;
+    double i = m->current;
+    bool on = (us % period_us) < on_us;
+
+    double v;
+    if (on) {
+      v = brake ? 0.0 : dir * MOTOR_V;
+    } else if (i != 0) {
+      v = (i > 0) ? -(MOTOR_V + 2 * DIODE_V) : (MOTOR_V + 2 * DIODE_V);
+    } else {
+      v = emf;   // Open: no current
+    }
+    double next = i + (v - MOTOR_R * i - emf) / MOTOR_L * SIM_DT;
+    if (!on && (next > 0) != (i > 0)) next = 0;   // Diodes block once decayed
+    m->current = next;
+    m->charge += next * SIM_DT;
+    if (fabs(next) > m->peak_a) m->peak_a = fabs(next);
+    if (m->locked) continue;
+
+    double torque_a = next;
+    if (m->speed > 0) torque_a -= MOTOR_FRICTION_A;
+    else if (m->speed < 0) torque_a += MOTOR_FRICTION_A;
+    else if (fabs(torque_a) <= MOTOR_FRICTION_A) torque_a = 0;   // Breakaway
+    double speed = m->speed + torque_a * MOTOR_KE / MOTOR_J * SIM_DT;
+    if ((speed > 0) != (m->speed > 0) && m->speed != 0 && fabs(next) <= MOTOR_FRICTION_A) {
+      speed = 0;   // Friction stops the rotor, it does not reverse it
+    }
+    m->speed = speed;
+    m->travel_mm += speed * TOP_SPEED_MM_S * SIM_DT;
+  }
+}
+
+#endif // DC_MOTOR_H
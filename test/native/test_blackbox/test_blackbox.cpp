@@ -0,0 +1,377 @@
+// test_blackbox.cpp - Black-box ring dumped and decoded by the host tool
+// UpVote Battlebot - Phase 8
+//
+// Runs blackbox.cpp on a fake clock over scripted ticks, dumps the ring
+// with the stick gesture and frames every dump payload as the telemetry
+// UART sends it (CRSF, type 0x7F). The capture goes through
+// tools/blackbox_decode.py; its CSV must reproduce every tick the ring
+// still holds, exactly, ending at the newest one. Capacity is checked
+// against what the README and the recorder's commit claim.
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "blackbox.cpp"
+#include "state.cpp"
+
+// ============================================================================
+// RECORDING AND DUMP
+// ============================================================================
+
+#define COLUMNS        (1 + BLACKBOX_FIELDS)   // t_ms, then the fields
+#define MAX_TICKS      4000
+#define TICKS_PER_S    (1000 / LOOP_PERIOD_MS)
+
+// Capacity of the 384-byte ring as the README states it, at the worst of
+// CAPACITY_PHASES freeze points spread over a keyframe interval
+#define CLAIM_STILL_TICKS  750   // Sticks still: 7.5 s
+#define CLAIM_SWEEP_TICKS  30    // Constant full-stick sweeps: 0.3 s
+#define CAPACITY_PHASES    8
+
+static uint32_t g_now_ms;
+uint32_t timebase_millis() { return g_now_ms; }
+
+// Every recorded tick as the decoder's CSV shows it
+static int32_t g_expected[MAX_TICKS][COLUMNS];
+static uint16_t g_recorded;
+
+static int32_t g_decoded[MAX_TICKS][COLUMNS];
+static uint16_t g_decoded_count;
+
+static FILE* g_capture;
+static bool g_dump_done;
+static char g_paths[3][256];   // Capture, CSV, decoder summary
+
+// CRC8 DVB-S2 over type + payload, as the CRSF library frames it
+static uint8_t crc8_dvb_s2(const uint8_t* data, uint8_t len) {
+  uint8_t crc = 0;
+  for (uint8_t n = 0; n < len; n++) {
+    crc ^= data[n];
+    for (uint8_t i = 0; i < 8; i++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+// One dump payload onto the capture as a CRSF frame
+static void capture_frame(const uint8_t* payload, uint8_t len) {
+  uint8_t body[1 + BLACKBOX_DUMP_PAYLOAD_MAX];
+  body[0] = CRSF_FRAMETYPE_BLACKBOX;
+  memcpy(&body[1], payload, len);
+  fputc(0xC8, g_capture);           // CRSF_ADDRESS_FLIGHT_CONTROLLER
+  fputc(len + 2, g_capture);        // Type + payload + CRC
+  fwrite(body, 1, len + 1, g_capture);
+  fputc(crc8_dvb_s2(body, len + 1), g_capture);
+}
+
+// This tick's inputs as recorded (stored widths, then the decoder's scaling)
+static void remember() {
+  TEST_ASSERT_LESS_THAN(MAX_TICKS, g_recorded);
+  int32_t* row = g_expected[g_recorded++];
+  row[0] = g_now_ms;
+  for (uint8_t i = 0; i < 8; i++) {
+    uint16_t stored = g_state.input.raw_channels[i] >> BLACKBOX_CHANNEL_SHIFT;
+    row[1 + i] = (stored > 511 ? 511 : stored) << BLACKBOX_CHANNEL_SHIFT;
+  }
+  row[9] = g_state.output.motor_fl_pwm;
+  row[10] = g_state.output.motor_fr_pwm;
+  row[11] = g_state.output.motor_rl_pwm;
+  row[12] = g_state.output.motor_rr_pwm;
+  row[13] = g_state.output.weapon_us;
+  row[14] = g_state.output.servo_us;
+  row[15] = (g_state.safety.arm_state == ARMED) ? 1 : 0;
+  uint16_t loop = g_state.loop_duration_us >> BLACKBOX_LOOP_SHIFT;
+  row[16] = (loop > 255 ? 255 : loop) << BLACKBOX_LOOP_SHIFT;
+}
+
+// One control loop tick: record, then the telemetry UART's dump frame
+static void step() {
+  g_now_ms += LOOP_PERIOD_MS;
+  blackbox_update();
+  if (g_last_tick_ms == g_now_ms) remember();
+
+  uint8_t payload[BLACKBOX_DUMP_PAYLOAD_MAX];
+  uint8_t len = blackbox_dump_frame(payload);
+  if (len > 0) {
+    TEST_ASSERT_LESS_OR_EQUAL(BLACKBOX_DUMP_PAYLOAD_MAX, len);
+    capture_frame(payload, len);
+    if (payload[0] == 'E') g_dump_done = true;
+  }
+}
+
+// Idle robot on a live link, recorder empty
+static void start(uint32_t now_ms) {
+  g_now_ms = now_ms;
+  g_recorded = 0;
+  g_dump_done = false;
+  g_state.input.link_ok = true;
+  g_state.input.kill_switch = false;
+  for (uint8_t i = 0; i < 8; i++) g_state.input.raw_channels[i] = 992;
+  g_state.output.motor_fl_pwm = 0;
+  g_state.output.motor_fr_pwm = 0;
+  g_state.output.motor_rl_pwm = 0;
+  g_state.output.motor_rr_pwm = 0;
+  g_state.output.weapon_us = 1000;
+  g_state.output.servo_us = 1500;
+  g_state.safety.arm_state = DISARMED;
+  g_state.safety.error = ERR_NONE;
+  g_state.loop_duration_us = 2000;
+  blackbox_init();
+}
+
+// Dump gesture until the end frame, with other UART traffic in front
+static void dump() {
+  const char* tmp = getenv("TMPDIR");
+  if (tmp == NULL) tmp = "/tmp";
+  snprintf(g_paths[0], sizeof(g_paths[0]), "%s/upvote_blackbox.bin", tmp);
+  snprintf(g_paths[1], sizeof(g_paths[1]), "%s/upvote_blackbox.csv", tmp);
+  snprintf(g_paths[2], sizeof(g_paths[2]), "%s/upvote_blackbox.txt", tmp);
+  g_capture = fopen(g_paths[0], "wb");
+  TEST_ASSERT_NOT_NULL(g_capture);
+  static const uint8_t traffic[] = { 0xC8, 0x04, 0x08, 0x02, 0x9E, 0x00, 0xEE, 0xC8 };
+  fwrite(traffic, 1, sizeof(traffic), g_capture);
+
+  g_state.input.link_ok = true;
+  g_state.input.kill_switch = true;
+  g_state.input.raw_channels[0] = BLACKBOX_DUMP_RAW;
+  for (uint16_t n = 0; n < 60 * TICKS_PER_S && !g_dump_done; n++) step();
+  fclose(g_capture);
+  TEST_ASSERT_TRUE(g_dump_done);
+}
+
+// Repository root from this file's path (PlatformIO passes it absolute)
+static void repo_path(char* out, size_t size, const char* file) {
+  const char* here = __FILE__;
+  const char* tail = strstr(here, "test/native/");
+  int root = tail ? (int)(tail - here) : 0;
+  snprintf(out, size, "%.*s%s", root, here, file);
+}
+
+// Run the decoder over the capture; rows into g_decoded, summary line kept
+static void decode(char* summary, size_t size) {
+  if (system("python3 --version > /dev/null 2>&1") != 0) {
+    TEST_IGNORE_MESSAGE("python3 not found: decoder not run");
+  }
+  char tool[256], command[4 * 256 + 64];
+  repo_path(tool, sizeof(tool), "tools/blackbox_decode.py");
+  snprintf(command, sizeof(command), "python3 \"%s\" \"%s\" -o \"%s\" 2> \"%s\"",
+           tool, g_paths[0], g_paths[1], g_paths[2]);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(0, system(command), "blackbox_decode.py failed");
+
+  FILE* f = fopen(g_paths[2], "r");
+  TEST_ASSERT_NOT_NULL(f);
+  summary[0] = '\0';
+  if (fgets(summary, size, f) != NULL) summary[strcspn(summary, "\n")] = '\0';
+  fclose(f);
+
+  f = fopen(g_paths[1], "r");
+  TEST_ASSERT_NOT_NULL(f);
+  char line[256];
+  TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), f));
+  TEST_ASSERT_EQUAL_INT(0, strncmp(line, "t_ms,ch1,", 9));
+  g_decoded_count = 0;
+  while (fgets(line, sizeof(line), f) != NULL) {
+    TEST_ASSERT_LESS_THAN(MAX_TICKS, g_decoded_count);
+    int32_t* row = g_decoded[g_decoded_count++];
+    char* p = line;
+    for (uint8_t c = 0; c < COLUMNS; c++) {
+      char* end;
+      row[c] = strtol(p, &end, 10);
+      TEST_ASSERT_TRUE(end != p);
+      p = end + 1;
+    }
+  }
+  fclose(f);
+  remove(g_paths[0]);
+  remove(g_paths[1]);
+  remove(g_paths[2]);
+}
+
+// The decoded rows are the newest recorded ticks, every column exact
+static void check_round_trip() {
+  TEST_ASSERT_GREATER_THAN(0, g_decoded_count);
+  TEST_ASSERT_LESS_OR_EQUAL(g_recorded, g_decoded_count);
+  uint16_t first = g_recorded - g_decoded_count;
+  for (uint16_t n = 0; n < g_decoded_count; n++) {
+    for (uint8_t c = 0; c < COLUMNS; c++) {
+      if (g_decoded[n][c] != g_expected[first + n][c]) {
+        char line[100];
+        snprintf(line, sizeof(line), "Tick at %ld ms, column %u: decoded %ld, recorded %ld",
+                 (long)g_expected[first + n][0], c, (long)g_decoded[n][c],
+                 (long)g_expected[first + n][c]);
+        TEST_FAIL_MESSAGE(line);
+      }
+    }
+  }
+}
+
+// ============================================================================
+// SCRIPTED INPUTS
+// ============================================================================
+
+static uint32_t g_seed;
+
+static uint16_t noise(uint16_t span) {
+  g_seed = g_seed * 1103515245UL + 12345;
+  return (g_seed >> 16) % span;
+}
+
+// Triangle between lo and hi over period ticks
+static int16_t triangle(uint16_t n, uint16_t period, int16_t lo, int16_t hi) {
+  uint16_t phase = n % period;
+  uint16_t half = period / 2;
+  uint16_t up = (phase < half) ? phase : period - phase;
+  return lo + (int32_t)(hi - lo) * up / half;
+}
+
+// Every field but the arm state moving every tick, sticks with noise
+static void storm_tick(uint16_t n) {
+  for (uint8_t i = 0; i < 8; i++) {
+    g_state.input.raw_channels[i] = triangle(n + 7 * i, 40 + 6 * i, 172, 1811) + noise(8);
+  }
+  g_state.output.motor_fl_pwm = triangle(n, 30, -255, 255);
+  g_state.output.motor_fr_pwm = triangle(n + 5, 30, -255, 255);
+  g_state.output.motor_rl_pwm = triangle(n + 10, 34, -255, 255);
+  g_state.output.motor_rr_pwm = triangle(n + 15, 34, -255, 255);
+  g_state.output.weapon_us = triangle(n, 50, 1000, 2000);
+  g_state.output.servo_us = triangle(n, 70, 1000, 2000);
+  g_state.loop_duration_us = 1600 + noise(1200);
+}
+
+// Full-stick sweeps (1 s end to end) on both sticks, the wheels following
+// and the loop time jittering: 8 of the 16 fields change every tick
+static void sweep_tick(uint16_t n) {
+  for (uint8_t i = 0; i < 4; i++) {
+    g_state.input.raw_channels[i] = triangle(n + 25 * i, 2 * TICKS_PER_S, 172, 1811);
+  }
+  int16_t drive = (g_state.input.raw_channels[1] - 992) * 255 / 820;
+  int16_t turn = (g_state.input.raw_channels[3] - 992) * 255 / 820 / 2;
+  g_state.output.motor_fl_pwm = constrain(drive + turn, -255, 255);
+  g_state.output.motor_rl_pwm = constrain(drive - turn / 2, -255, 255);
+  g_state.output.motor_fr_pwm = constrain(drive - turn, -255, 255);
+  g_state.output.motor_rr_pwm = constrain(drive + turn / 2, -255, 255);
+  g_state.loop_duration_us = 1900 + noise(200);
+}
+
+// Practice driving: two sticks drifting, outputs following, arm toggled,
+// a dead channel reading past the 11-bit range (saturates in the ring)
+static void drive_tick(uint16_t n) {
+  int16_t throttle = triangle(n, 400, 400, 1600);
+  int16_t steer = triangle(n, 260, 700, 1300);
+  g_state.input.raw_channels[1] = throttle;
+  g_state.input.raw_channels[3] = steer;
+  g_state.input.raw_channels[7] = (n % 300 < 150) ? 992 : 2100;
+  int16_t drive = (throttle - 1000) * 255 / 600;
+  int16_t turn = (steer - 1000) * 255 / 300 / 2;
+  g_state.output.motor_fl_pwm = constrain(drive + turn, -255, 255);
+  g_state.output.motor_rl_pwm = constrain(drive + turn, -255, 255);
+  g_state.output.motor_fr_pwm = constrain(drive - turn, -255, 255);
+  g_state.output.motor_rr_pwm = constrain(drive - turn, -255, 255);
+  g_state.safety.arm_state = (n % 300 < 200) ? ARMED : DISARMED;
+  g_state.output.weapon_us = (g_state.safety.arm_state == ARMED) ? 1600 : 1000;
+  g_state.loop_duration_us = (n % 10 == 0) ? 2900 : 2000;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+// Every field moving, then driving, link lost just before the 16-bit block
+// time wraps (65.536 s): the frozen ring decodes tick for tick across the
+// wrap, trigger in the header
+static void test_decoder_reproduces_every_tick() {
+  g_seed = 1;
+  start(57300);
+  uint16_t n = 0;
+  for (; n < 3 * TICKS_PER_S; n++) {
+    storm_tick(n);
+    step();
+  }
+  for (; n < 8 * TICKS_PER_S; n++) {
+    drive_tick(n);
+    step();
+  }
+  g_state.input.link_ok = false;
+  uint32_t trigger_ms = g_now_ms + LOOP_PERIOD_MS;
+  for (uint16_t k = 0; k < TICKS_PER_S; k++, n++) {
+    drive_tick(n);
+    step();
+  }
+  TEST_ASSERT_TRUE(blackbox_frozen());
+  uint16_t frozen = g_recorded;
+  dump();
+  TEST_ASSERT_EQUAL_INT(frozen, g_recorded);   // Nothing recorded while frozen
+
+  char summary[128], want[64];
+  decode(summary, sizeof(summary));
+  TEST_MESSAGE(summary);
+  snprintf(want, sizeof(want), "trigger: failsafe at %lu ms", (unsigned long)trigger_ms);
+  TEST_ASSERT_NOT_NULL(strstr(summary, want));
+
+  char line[100];
+  snprintf(line, sizeof(line), "%u ticks recorded, newest %u decoded (%ld-%ld ms), exact",
+           g_recorded, g_decoded_count, (long)g_decoded[0][0],
+           (long)g_decoded[g_decoded_count - 1][0]);
+  TEST_MESSAGE(line);
+  check_round_trip();
+  TEST_ASSERT_TRUE(g_decoded[0][0] < 65536 && g_decoded[g_decoded_count - 1][0] > 65536);
+  TEST_ASSERT_EQUAL_INT(trigger_ms + POST_TRIGGER_TICKS * LOOP_PERIOD_MS,
+                        g_decoded[g_decoded_count - 1][0]);
+}
+
+// Ticks the ring holds when frozen by a link loss after 20 s (plus extra
+// ticks) of one kind of tick (the decoded rows, all of that kind)
+static uint16_t capacity(void (*tick)(uint16_t), uint16_t extra) {
+  start(1000);
+  uint16_t n = 0;
+  for (; n < 20 * TICKS_PER_S + extra; n++) {
+    if (tick) tick(n);
+    step();
+  }
+  g_state.input.link_ok = false;
+  for (; !blackbox_frozen(); n++) {
+    if (tick) tick(n);
+    step();
+  }
+  dump();
+  char summary[128];
+  decode(summary, sizeof(summary));
+  check_round_trip();
+  return g_decoded_count;
+}
+
+// Capacity of the ring, sticks still and under full-stick sweeps: the
+// fewest ticks decoded over the freeze points
+static void test_capacity() {
+  uint16_t still = MAX_TICKS, sweep = MAX_TICKS;
+  for (uint8_t p = 0; p < CAPACITY_PHASES; p++) {
+    uint16_t extra = p * BLACKBOX_BLOCK_FRAMES / CAPACITY_PHASES;
+    uint16_t ticks = capacity(NULL, extra);
+    if (ticks < still) still = ticks;
+    g_seed = p + 1;
+    ticks = capacity(sweep_tick, extra);
+    if (ticks < sweep) sweep = ticks;
+  }
+
+  char line[100];
+  snprintf(line, sizeof(line), "Sticks still: %u ticks (%.2f s), README %.2f s",
+           still, still / (double)TICKS_PER_S, CLAIM_STILL_TICKS / (double)TICKS_PER_S);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "Full sweeps: %u ticks (%.2f s), README %.2f s",
+           sweep, sweep / (double)TICKS_PER_S, CLAIM_SWEEP_TICKS / (double)TICKS_PER_S);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_GREATER_OR_EQUAL(CLAIM_STILL_TICKS, still);
+  TEST_ASSERT_GREATER_OR_EQUAL(CLAIM_SWEEP_TICKS, sweep);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_decoder_reproduces_every_tick);
+  RUN_TEST(test_capacity);
+  return UNITY_END();
+}
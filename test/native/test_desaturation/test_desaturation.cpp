@@ -0,0 +1,230 @@
+// test_desaturation.cpp - Achieved vs commanded chassis motion per strategy
+// UpVote Battlebot - Phase 8
+//
+// Sweeps the whole stick envelope through the Q12 mixer (mecanum X, linear
+// curves, full duty) once per desaturation strategy. The wheel outputs are
+// turned back into chassis motion with the inverse of the mixer matrix and
+// compared with the commanded X, Y and R:
+//   Y = (RL + RR + FL + FR) / 4
+//   X = (-RL + RR + FL - FR) / 4
+//   R = (RL - RR + FL - FR) / 4
+// Prints the worst and mean error per axis, and checks what each strategy
+// promises to keep.
+#include <unity.h>
+#include <stdio.h>
+
+#include "mixing.h"
+#include "config.h"
+#include "state.h"
+#include "actuators.h"
+#include "utilities.h"
+#include "curves.h"
+#include "profiles.h"
+#include "speed_control.h"
+#include "servo.h"
+#include "yaw_control.h"
+
+#include "state.cpp"
+#include "utilities.cpp"
+#include "curves.cpp"
+#undef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT 1
+#include "mixing.cpp"
+
+#if MIXER_LAYOUT != MIXER_LAYOUT_MECANUM_X && MIXER_LAYOUT != MIXER_LAYOUT_OMNI_X
+#error "The inverse kinematics below are for the X layouts"
+#endif
+
+// ============================================================================
+// COLLABORATOR STUBS
+// ============================================================================
+
+// Linear curves, full rotation, full duty, no motion shaping: the chassis
+// command is the normalized stick
+static DriveProfile g_profile = {
+  "Test", 255, { CURVE_ID_LINEAR, CURVE_ID_LINEAR, CURVE_ID_LINEAR },
+  100, 0, {0, 0, 0}, {0, 0, 0}, 0, 0, 0
+};
+
+const DriveProfile* profiles_get(uint8_t) { return &g_profile; }
+uint8_t profiles_get_generation() { return 0; }
+
+static int16_t g_motor[4];
+void actuators_set_motor(uint8_t motor_index, int16_t command) { g_motor[motor_index] = command; }
+
+int16_t speed_control_apply(uint8_t, int16_t command) { return command; }
+void speed_control_init() {}
+void speed_control_reset() {}
+int16_t servo_get_drive_kick() { return 0; }
+void yaw_control_init() {}
+void yaw_control_reset() {}
+int16_t yaw_control_update(int16_t rate_cmd_q12, bool) { return rate_cmd_q12; }
+
+// ============================================================================
+// SWEEP
+// ============================================================================
+
+#define RAW_MIN    172
+#define RAW_MAX   1811
+#define RAW_STEP     9
+
+// One PWM count of wheel truncation, seen on an axis (Q12)
+#define AXIS_TOLERANCE  ((Q12_ONE + 254) / 255 + 1)
+
+struct AxisErrors {
+  int32_t worst[3];      // Largest |achieved - commanded| per axis (Q12)
+  int64_t total[3];      // For the mean
+  uint32_t samples;
+  uint32_t broken;       // Samples that broke the strategy's promise
+};
+
+// Wheel PWM back to Q12 chassis axes [X, Y, R]
+static void achieved_axes(int32_t* axes) {
+  int32_t rl = g_motor[0], rr = g_motor[1], fl = g_motor[2], fr = g_motor[3];
+  axes[0] = (-rl + rr + fl - fr) * Q12_ONE / (4 * 255);
+  axes[1] = ( rl + rr + fl + fr) * Q12_ONE / (4 * 255);
+  axes[2] = ( rl - rr + fl - fr) * Q12_ONE / (4 * 255);
+}
+
+// Does this sample keep what the strategy promises?
+static bool promise_kept(DesatStrategy desat, const int32_t* cmd, const int32_t* got) {
+  switch (desat) {
+    case DESAT_YAW_PRIORITY:
+      // Rotation alone always fits (unit coefficients), so it is exact
+      return abs(got[2] - cmd[2]) <= AXIS_TOLERANCE;
+
+    case DESAT_TRANSLATION_PRIORITY:
+      // Translation is exact whenever it fits on its own
+      if (abs(cmd[0]) + abs(cmd[1]) > Q12_ONE) return true;
+      return abs(got[0] - cmd[0]) <= AXIS_TOLERANCE && abs(got[1] - cmd[1]) <= AXIS_TOLERANCE;
+
+    case DESAT_UNIFORM:
+    default:
+      // Direction kept: achieved = s * commanded for one s in [0, 1]
+      // (cross products vanish), never more than commanded
+      for (uint8_t a = 0; a < 3; a++) {
+        if (abs(got[a]) > abs(cmd[a]) + AXIS_TOLERANCE) return false;
+        for (uint8_t b = a + 1; b < 3; b++) {
+          int64_t cross = (int64_t)got[a] * cmd[b] - (int64_t)got[b] * cmd[a];
+          if (llabs(cross) > (int64_t)2 * AXIS_TOLERANCE * Q12_ONE) return false;
+        }
+      }
+      return true;
+  }
+}
+
+static void sweep(DesatStrategy desat, AxisErrors* errors) {
+  memset(errors, 0, sizeof(*errors));
+  mixing_init();
+  g_mode_params.desat = desat;
+
+  for (int16_t roll = RAW_MIN; roll <= RAW_MAX; roll += RAW_STEP) {
+    for (int16_t pitch = RAW_MIN; pitch <= RAW_MAX; pitch += RAW_STEP) {
+      for (int16_t yaw = RAW_MIN; yaw <= RAW_MAX; yaw += RAW_STEP) {
+        g_state.input.raw_channels[0] = roll;
+        g_state.input.raw_channels[1] = pitch;
+        g_state.input.raw_channels[3] = yaw;
+        mixing_update();
+
+        int32_t cmd[3] = { g_shaper[0].value, g_shaper[1].value, g_shaper[2].value };
+        int32_t got[3];
+        achieved_axes(got);
+
+        for (uint8_t a = 0; a < 3; a++) {
+          int32_t err = abs(got[a] - cmd[a]);
+          if (err > errors->worst[a]) errors->worst[a] = err;
+          errors->total[a] += err;
+        }
+        errors->samples++;
+        if (!promise_kept(desat, cmd, got)) errors->broken++;
+      }
+    }
+  }
+}
+
+// Percent of full scale, one decimal
+static void report(const char* name, const AxisErrors* e) {
+  char line[160];
+  int32_t mean[3];
+  for (uint8_t a = 0; a < 3; a++) {
+    mean[a] = (int32_t)(e->total[a] / e->samples);
+  }
+  snprintf(line, sizeof(line),
+           "%s: worst error X %.1f%% Y %.1f%% R %.1f%%, mean X %.1f%% Y %.1f%% R %.1f%% (%u samples)",
+           name,
+           e->worst[0] * 100.0 / Q12_ONE, e->worst[1] * 100.0 / Q12_ONE, e->worst[2] * 100.0 / Q12_ONE,
+           mean[0] * 100.0 / Q12_ONE, mean[1] * 100.0 / Q12_ONE, mean[2] * 100.0 / Q12_ONE,
+           (unsigned)e->samples);
+  TEST_MESSAGE(line);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+static void test_uniform_keeps_direction() {
+  AxisErrors e;
+  sweep(DESAT_UNIFORM, &e);
+  report("Uniform", &e);
+  TEST_ASSERT_EQUAL_UINT32(0, e.broken);
+  // Full forward + full yaw: uniform scaling costs half the rotation
+  TEST_ASSERT_GREATER_OR_EQUAL_INT(Q12_ONE / 2 - AXIS_TOLERANCE, e.worst[2]);
+}
+
+static void test_yaw_priority_keeps_rotation() {
+  AxisErrors e;
+  sweep(DESAT_YAW_PRIORITY, &e);
+  report("Yaw priority", &e);
+  TEST_ASSERT_EQUAL_UINT32(0, e.broken);
+  TEST_ASSERT_LESS_OR_EQUAL_INT(AXIS_TOLERANCE, e.worst[2]);
+}
+
+static void test_translation_priority_keeps_translation() {
+  AxisErrors e;
+  sweep(DESAT_TRANSLATION_PRIORITY, &e);
+  report("Translation priority", &e);
+  TEST_ASSERT_EQUAL_UINT32(0, e.broken);
+}
+
+// Full forward with full clockwise yaw, by hand
+static void test_forward_and_full_yaw() {
+  g_state.input.raw_channels[0] = 992;
+  g_state.input.raw_channels[1] = RAW_MAX;
+  g_state.input.raw_channels[3] = RAW_MAX;
+  mixing_init();
+
+  // Uniform: both halved - left side full ahead, right side stopped
+  g_mode_params.desat = DESAT_UNIFORM;
+  mixing_update();
+  TEST_ASSERT_EQUAL_INT(255, g_motor[0]);
+  TEST_ASSERT_INT_WITHIN(1, 0, g_motor[1]);
+  TEST_ASSERT_EQUAL_INT(255, g_motor[2]);
+  TEST_ASSERT_INT_WITHIN(1, 0, g_motor[3]);
+
+  // Yaw priority: full rotation kept, translation shed - spin in place
+  g_mode_params.desat = DESAT_YAW_PRIORITY;
+  mixing_update();
+  TEST_ASSERT_EQUAL_INT(255, g_motor[0]);
+  TEST_ASSERT_EQUAL_INT(-255, g_motor[1]);
+  TEST_ASSERT_EQUAL_INT(255, g_motor[2]);
+  TEST_ASSERT_EQUAL_INT(-255, g_motor[3]);
+
+  // Translation priority: full forward kept, rotation shed - straight ahead
+  g_mode_params.desat = DESAT_TRANSLATION_PRIORITY;
+  mixing_update();
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL_INT(255, g_motor[i]);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_uniform_keeps_direction);
+  RUN_TEST(test_yaw_priority_keeps_rotation);
+  RUN_TEST(test_translation_priority_keeps_translation);
+  RUN_TEST(test_forward_and_full_yaw);
+  return UNITY_END();
+}
@@ -0,0 +1,272 @@
+// test_error_log.cpp - Error history ring in EEPROM, repeats and dump lines
+// UpVote Battlebot - Phase 8
+//
+// error_log.cpp runs on a fake clock against the RAM EEPROM stand-in
+// (support/avr/eeprom.h), with power cycles in between: events are written
+// in idle time into the 39-record ring, read back with the dump gesture
+// and compared with what was logged. The dump lines go out in a CRSF
+// flight mode frame, so none may be longer than 31 characters.
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "error_log.cpp"
+#include "state.cpp"
+
+// ============================================================================
+// FAKE BOARD
+// ============================================================================
+
+#define TICKS_PER_S      (1000 / LOOP_PERIOD_MS)
+#define LINE_MAX_CHARS   31         // Flight mode frame text, less its NUL
+#define MAX_EVENTS       400
+
+static_assert(sizeof(ErrorLogRecord) == 13, "Record layout differs from the AVR's");
+static_assert(ERROR_LOG_SLOTS == 39, "Error log ring is 39 records on the AVR");
+
+static uint32_t g_now_ms;
+uint32_t timebase_millis() { return g_now_ms; }
+
+static uint16_t g_load_us;
+uint16_t profiles_get_load_us() { return g_load_us; }
+
+struct Logged {
+  uint8_t boot;
+  uint8_t code;
+  uint8_t stage;
+  uint32_t time_ms;
+  uint16_t context;
+};
+
+// Every event that reached the EEPROM, in order
+static Logged g_logged[MAX_EVENTS];
+static uint16_t g_logged_count;
+
+// Lines of the last dump
+static char g_lines[ERROR_LOG_SLOTS + 2][ERROR_LOG_LINE_LEN];
+static uint8_t g_line_count;
+static uint8_t g_longest;
+
+static void erase_eeprom() {
+  memset(native_eeprom(), 0xFF, 1024);
+  g_logged_count = 0;
+}
+
+// Reset: RAM back to its power-on values, EEPROM kept, then setup()
+static void power_cycle() {
+  g_pending_head = 0;
+  g_pending_tail = 0;
+  g_dropped = 0;
+  g_repeats = 0;
+  g_last_code = ERR_NONE;
+  g_last_ms = 0;
+  g_boot = 0;
+  g_seq = 0;
+  g_next_slot = 0;
+  memset(&g_dump, 0, sizeof(g_dump));
+  g_state.input.kill_switch = false;
+  error_log_init();
+}
+
+// Idle time until every buffered event is in EEPROM
+static void flush() {
+  for (uint16_t n = 0; n < 1000; n++) {
+    if (g_pending_tail == g_pending_head && g_write_pos == sizeof(ErrorLogRecord)) return;
+    error_log_idle();
+  }
+  TEST_FAIL_MESSAGE("error_log_idle() never finished writing");
+}
+
+// Log one event and write it out, remembering what should be stored
+static void log_event(SystemError code, uint8_t stage, uint16_t context) {
+  g_state.loop_stage = stage;
+  error_log_record(code, context);
+  flush();
+  TEST_ASSERT_LESS_THAN(MAX_EVENTS, g_logged_count);
+  Logged* e = &g_logged[g_logged_count++];
+  e->boot = error_log_get_boot();
+  e->code = code;
+  e->stage = stage;
+  e->time_ms = g_now_ms;
+  e->context = context;
+}
+
+// Dump gesture, then control ticks (idle time in between) until "L end"
+static void dump() {
+  g_line_count = 0;
+  g_longest = 0;
+  g_state.input.kill_switch = true;
+  g_state.input.link_ok = true;
+  g_state.input.raw_channels[3] = ERROR_LOG_DUMP_RAW;
+  for (uint32_t n = 0; n < 60 * TICKS_PER_S; n++) {
+    g_now_ms += LOOP_PERIOD_MS;
+    error_log_update();
+    const char* line = error_log_dump_line();
+    if (line != NULL) {
+      uint8_t length = strlen(line);
+      if (length > g_longest) g_longest = length;
+      TEST_ASSERT_LESS_THAN(ERROR_LOG_SLOTS + 2, g_line_count);
+      strncpy(g_lines[g_line_count], line, ERROR_LOG_LINE_LEN - 1);
+      g_lines[g_line_count++][ERROR_LOG_LINE_LEN - 1] = '\0';
+      if (strcmp(line, "L end") == 0) break;
+    }
+    error_log_idle();
+  }
+  g_state.input.kill_switch = false;
+  g_state.input.raw_channels[3] = 992;
+  error_log_update();
+  TEST_ASSERT_FALSE(error_log_dumping());
+  TEST_ASSERT_GREATER_OR_EQUAL(2, g_line_count);
+  TEST_ASSERT_EQUAL_STRING("L end", g_lines[g_line_count - 1]);
+  TEST_ASSERT_LESS_OR_EQUAL(LINE_MAX_CHARS, g_longest);
+}
+
+// Header line fields: "L<boot> r<repeats> d<dropped> p<load us>"
+static void dump_header(unsigned* boot, unsigned* repeats, unsigned* dropped) {
+  unsigned load;
+  TEST_ASSERT_EQUAL_INT(4, sscanf(g_lines[0], "L%u r%u d%u p%u", boot, repeats, dropped, &load));
+  TEST_ASSERT_EQUAL_INT(g_load_us, load);
+}
+
+// The dumped events are the newest logged ones, oldest first
+static void check_dump_events() {
+  uint8_t events = g_line_count - 2;
+  uint16_t expect = (g_logged_count < ERROR_LOG_SLOTS) ? g_logged_count : ERROR_LOG_SLOTS;
+  TEST_ASSERT_EQUAL_INT(expect, events);
+  for (uint8_t n = 0; n < events; n++) {
+    const Logged* e = &g_logged[g_logged_count - events + n];
+    unsigned boot, code, stage, context;
+    unsigned long time_ms;
+    TEST_ASSERT_EQUAL_INT(5, sscanf(g_lines[1 + n], "b%u e%u s%u t%lu c%u",
+                                    &boot, &code, &stage, &time_ms, &context));
+    char where[64];
+    snprintf(where, sizeof(where), "dump line %u: %s", 1 + n, g_lines[1 + n]);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(e->boot, boot, where);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(e->code, code, where);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(e->stage, stage, where);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(e->time_ms, time_ms, where);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(e->context, context, where);
+  }
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {
+  erase_eeprom();
+  g_now_ms = 1000;
+  g_load_us = 180;
+  power_cycle();
+}
+
+void tearDown() {}
+
+// 300 events over six boots: the ring wraps every 39 records (and the
+// 8-bit sequence past 255); each boot finds the head and the dump holds
+// the newest 39, oldest first, with their boot numbers
+static void test_ring_wraps_across_slots() {
+  static const SystemError codes[] = { ERR_CRSF_TIMEOUT, ERR_LOOP_OVERRUN, ERR_CRSF_CRC };
+  uint16_t total = 0;
+  for (uint8_t boot = 0; boot < 6; boot++) {
+    TEST_ASSERT_EQUAL_INT(boot, error_log_get_boot());
+    TEST_ASSERT_EQUAL_INT(total % ERROR_LOG_SLOTS, g_next_slot);
+    uint16_t count = (boot == 0) ? 20 : 56;   // Short of one lap, then past it
+    for (uint16_t n = 0; n < count; n++, total++) {
+      g_now_ms += 137;
+      log_event(codes[total % 3], total % 11, total);
+    }
+    dump();
+    check_dump_events();
+    power_cycle();
+  }
+  char line[100];
+  snprintf(line, sizeof(line), "%u events in %u records (%u laps), newest in slot %u, sequence %u",
+           total, (unsigned)ERROR_LOG_SLOTS, total / (unsigned)ERROR_LOG_SLOTS,
+           (total - 1) % (unsigned)ERROR_LOG_SLOTS, g_seq);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_GREATER_THAN(255, total);
+}
+
+// The same error within ERROR_LOG_REPEAT_MS of its last occurrence is only
+// counted (a steady repeat never gets logged again); another error in
+// between, or a quiet spell, logs it again; a full buffer drops new events
+static void test_repeat_suppression() {
+  log_event(ERR_LOOP_OVERRUN, STAGE_INPUT, 1);
+  for (uint16_t n = 0; n < 50; n++) {
+    g_now_ms += ERROR_LOG_REPEAT_MS / 2;   // Every half window for 25 s
+    error_log_record(ERR_LOOP_OVERRUN, 2);
+  }
+  flush();
+  g_now_ms += ERROR_LOG_REPEAT_MS / 2;
+  log_event(ERR_CRSF_CRC, STAGE_INPUT, 3);             // Different code
+  g_now_ms += 10;
+  log_event(ERR_LOOP_OVERRUN, STAGE_INPUT, 4);         // Logged again after it
+  g_now_ms += ERROR_LOG_REPEAT_MS;
+  log_event(ERR_LOOP_OVERRUN, STAGE_INPUT, 5);         // Quiet for a window
+
+  // No idle time: the buffer keeps its first ERROR_LOG_RAM_EVENTS - 1
+  static const SystemError burst[] = { ERR_CRSF_TIMEOUT, ERR_CRSF_CRC };
+  for (uint8_t n = 0; n < ERROR_LOG_RAM_EVENTS + 3; n++) {
+    g_now_ms += 1;
+    error_log_record(burst[n % 2], 100 + n);
+    if (n < ERROR_LOG_RAM_EVENTS - 1) {
+      Logged* e = &g_logged[g_logged_count++];
+      e->boot = error_log_get_boot();
+      e->code = burst[n % 2];
+      e->stage = STAGE_INPUT;
+      e->time_ms = g_now_ms;
+      e->context = 100 + n;
+    }
+  }
+  flush();
+
+  dump();
+  unsigned boot, repeats, dropped;
+  dump_header(&boot, &repeats, &dropped);
+  TEST_MESSAGE(g_lines[0]);
+  TEST_ASSERT_EQUAL_INT(0, boot);
+  TEST_ASSERT_EQUAL_INT(50, repeats);
+  TEST_ASSERT_EQUAL_INT(4, dropped);
+  check_dump_events();
+}
+
+// Widest values every field can hold: header and event lines within
+// LINE_MAX_CHARS (the longest are reported)
+static void test_dump_lines_fit() {
+  // Boot 255: one event in every boot before it (a boot that logs
+  // nothing does not count)
+  for (uint16_t boot = 0; boot < 255; boot++) {
+    TEST_ASSERT_EQUAL_INT(boot, error_log_get_boot());
+    g_now_ms += 1;
+    log_event(ERR_CRSF_TIMEOUT, STAGE_INPUT, 0);
+    power_cycle();
+  }
+  TEST_ASSERT_EQUAL_INT(255, error_log_get_boot());
+
+  // Last code and stage, a 10-digit time (the dump ends before the clock
+  // wraps), full-scale context and counters
+  g_now_ms = UINT32_MAX - 60 * 1000UL;
+  log_event(ERR_WEAPON_RECOVERY, STAGE_DIAGNOSTICS, UINT16_MAX);
+  g_load_us = UINT16_MAX;
+  g_repeats = UINT16_MAX;
+  g_dropped = UINT16_MAX;
+
+  dump();
+  check_dump_events();
+  char line[100];
+  snprintf(line, sizeof(line), "Header \"%s\" (%u chars)", g_lines[0], (unsigned)strlen(g_lines[0]));
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "Event \"%s\" (%u chars), limit %u",
+           g_lines[g_line_count - 2], (unsigned)strlen(g_lines[g_line_count - 2]), LINE_MAX_CHARS);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL_STRING("L255 r65535 d65535 p65535", g_lines[0]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_ring_wraps_across_slots);
+  RUN_TEST(test_repeat_suppression);
+  RUN_TEST(test_dump_lines_fit);
+  return UNITY_END();
+}
@@ -0,0 +1,168 @@
+// test_mixer_policies.cpp - Stick-to-wheel behaviour of each mixer policy
+// UpVote Battlebot - Phase 8
+//
+// Runs the Q12 pipeline of each policy directly (mixing.cpp is part of this
+// translation unit, so every instantiation is reachable whatever config.h
+// selects) and checks which wheels each stick moves.
+#include <unity.h>
+#include <stdio.h>
+
+#include "mixing.cpp"
+#include "state.cpp"
+#include "utilities.cpp"
+#include "curves.cpp"
+
+// ============================================================================
+// COLLABORATOR STUBS
+// ============================================================================
+
+// Compiled default profiles, with motion shaping off so every call mixes
+// the stick position it is given
+#define TEST_PROFILE(mode) { \
+  mode##_PROFILE_NAME, mode##_MAX_DUTY, \
+  { mode##_CURVE_X, mode##_CURVE_Y, mode##_CURVE_R }, \
+  mode##_ROTATION_PCT, mode##_STOP_BRAKE, {0, 0, 0}, {0, 0, 0}, 0, 0, 0 }
+
+static DriveProfile g_profiles[3] = {
+  TEST_PROFILE(BEGINNER), TEST_PROFILE(NORMAL), TEST_PROFILE(AGGRESSIVE)
+};
+
+const DriveProfile* profiles_get(uint8_t mode) { return &g_profiles[mode < 3 ? mode : 1]; }
+uint8_t profiles_get_generation() { return 0; }
+
+static int16_t g_motor[4];   // RL, RR, FL, FR
+void actuators_set_motor(uint8_t motor_index, int16_t command) { g_motor[motor_index] = command; }
+
+int16_t speed_control_apply(uint8_t, int16_t command) { return command; }
+void speed_control_init() {}
+void speed_control_reset() {}
+int16_t servo_get_drive_kick() { return 0; }
+void yaw_control_init() {}
+void yaw_control_reset() {}
+int16_t yaw_control_update(int16_t rate_cmd_q12, bool) { return rate_cmd_q12; }
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+#define RAW_MIN     172
+#define RAW_CENTER  992
+#define RAW_MAX     1811
+
+#define RL  0
+#define RR  1
+#define FL  2
+#define FR  3
+
+// Mix one stick position through a policy (all sticks not given centered)
+template <class Policy>
+static void mix(uint16_t right_x, uint16_t right_y, uint16_t left_x, uint16_t left_y) {
+  g_state.input.raw_channels[MIXER_STICK_ROLL] = right_x;
+  g_state.input.raw_channels[MIXER_STICK_PITCH] = right_y;
+  g_state.input.raw_channels[MIXER_STICK_YAW] = left_x;
+  g_state.input.raw_channels[MIXER_STICK_LEFT_Y] = left_y;
+  mixing_pipeline<Policy>();
+}
+
+static void assert_wheels(int16_t rl, int16_t rr, int16_t fl, int16_t fr) {
+  char line[64];
+  snprintf(line, sizeof(line), "wheels RL %d RR %d FL %d FR %d",
+           g_motor[RL], g_motor[RR], g_motor[FL], g_motor[FR]);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(rl, g_motor[RL], line);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(rr, g_motor[RR], line);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(fl, g_motor[FL], line);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(fr, g_motor[FR], line);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {
+  mixing_init();
+  mixing_set_drive_mode(DRIVE_MODE_AGGRESSIVE);
+}
+void tearDown() {}
+
+// Tank: each stick's Y drives its own side, nothing else
+static void test_tank_left_stick_drives_left_wheels() {
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_CENTER, RAW_CENTER, RAW_MAX);
+  assert_wheels(AGGRESSIVE_MAX_DUTY, 0, AGGRESSIVE_MAX_DUTY, 0);
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_CENTER, RAW_CENTER, RAW_MIN);
+  assert_wheels(-AGGRESSIVE_MAX_DUTY, 0, -AGGRESSIVE_MAX_DUTY, 0);
+}
+
+static void test_tank_right_stick_drives_right_wheels() {
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_MAX, RAW_CENTER, RAW_CENTER);
+  assert_wheels(0, AGGRESSIVE_MAX_DUTY, 0, AGGRESSIVE_MAX_DUTY);
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_MIN, RAW_CENTER, RAW_CENTER);
+  assert_wheels(0, -AGGRESSIVE_MAX_DUTY, 0, -AGGRESSIVE_MAX_DUTY);
+}
+
+static void test_tank_both_sticks() {
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_MAX, RAW_CENTER, RAW_MAX);   // Both forward
+  assert_wheels(AGGRESSIVE_MAX_DUTY, AGGRESSIVE_MAX_DUTY, AGGRESSIVE_MAX_DUTY, AGGRESSIVE_MAX_DUTY);
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_MIN, RAW_CENTER, RAW_MAX);   // Counter-rotate
+  assert_wheels(AGGRESSIVE_MAX_DUTY, -AGGRESSIVE_MAX_DUTY, AGGRESSIVE_MAX_DUTY, -AGGRESSIVE_MAX_DUTY);
+}
+
+// Tank: left stick X strafes (same wheel pattern as holonomic right stick X),
+// right stick X does nothing
+static void test_tank_strafe_axis() {
+  mix<HolonomicMixer>(RAW_MAX, RAW_CENTER, RAW_CENTER, RAW_CENTER);
+  int16_t strafe[4];
+  memcpy(strafe, g_motor, sizeof(strafe));
+  TEST_ASSERT_NOT_EQUAL(0, strafe[RL]);
+
+  mix<TankStrafeMixer>(RAW_CENTER, RAW_CENTER, RAW_MAX, RAW_CENTER);
+  assert_wheels(strafe[RL], strafe[RR], strafe[FL], strafe[FR]);
+
+  mix<TankStrafeMixer>(RAW_MAX, RAW_CENTER, RAW_CENTER, RAW_CENTER);
+  assert_wheels(0, 0, 0, 0);
+}
+
+// Arcade: right stick drives and turns, never a strafe component
+// (front and rear wheel of a side always match on mecanum)
+static void test_arcade_never_strafes() {
+  for (uint16_t a = RAW_MIN; a <= RAW_MAX; a += 13) {
+    for (uint16_t b = RAW_MIN; b <= RAW_MAX; b += 13) {
+      mix<ArcadeMixer>(a, b, b, a);
+      TEST_ASSERT_EQUAL_INT(g_motor[RL], g_motor[FL]);
+      TEST_ASSERT_EQUAL_INT(g_motor[RR], g_motor[FR]);
+    }
+  }
+}
+
+static void test_arcade_ignores_left_stick() {
+  mix<ArcadeMixer>(RAW_CENTER, RAW_CENTER, RAW_MAX, RAW_MAX);
+  assert_wheels(0, 0, 0, 0);
+}
+
+// Holonomic: right stick X strafes, left stick X rotates, left stick Y unused
+static void test_holonomic_axes() {
+  mix<HolonomicMixer>(RAW_MAX, RAW_CENTER, RAW_CENTER, RAW_CENTER);
+  TEST_ASSERT_EQUAL_INT(g_motor[RL], g_motor[FR]);
+  TEST_ASSERT_EQUAL_INT(g_motor[RR], g_motor[FL]);
+  TEST_ASSERT_EQUAL_INT(-g_motor[RL], g_motor[RR]);
+
+  mix<HolonomicMixer>(RAW_CENTER, RAW_CENTER, RAW_MAX, RAW_CENTER);
+  TEST_ASSERT_GREATER_THAN(0, g_motor[RL]);
+  TEST_ASSERT_EQUAL_INT(g_motor[RL], g_motor[FL]);
+  TEST_ASSERT_EQUAL_INT(-g_motor[RL], g_motor[RR]);
+  TEST_ASSERT_EQUAL_INT(-g_motor[RL], g_motor[FR]);
+
+  mix<HolonomicMixer>(RAW_CENTER, RAW_CENTER, RAW_CENTER, RAW_MAX);
+  assert_wheels(0, 0, 0, 0);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_tank_left_stick_drives_left_wheels);
+  RUN_TEST(test_tank_right_stick_drives_right_wheels);
+  RUN_TEST(test_tank_both_sticks);
+  RUN_TEST(test_tank_strafe_axis);
+  RUN_TEST(test_arcade_never_strafes);
+  RUN_TEST(test_arcade_ignores_left_stick);
+  RUN_TEST(test_holonomic_axes);
+  return UNITY_END();
+}
@@ -0,0 +1,183 @@
+// test_mixing.cpp - Q12 mixing pipeline against the float reference
+// UpVote Battlebot - Phase 8
+//
+// mixing.cpp is compiled twice, once per MIXING_FIXED_POINT setting, each
+// copy in its own namespace. Both copies get the same sticks and profile
+// and must agree on every wheel within one PWM count.
+#include <unity.h>
+#include <stdio.h>
+
+// Everything mixing.cpp includes, up front, so the copies below only add
+// the module's own definitions inside their namespace
+#include "mixing.h"
+#include "config.h"
+#include "state.h"
+#include "actuators.h"
+#include "utilities.h"
+#include "curves.h"
+#include "profiles.h"
+#include "mixer_presets.h"
+#include "mixer_policies.h"
+#include "yaw_control.h"
+#include "speed_control.h"
+#include "servo.h"
+
+#include "state.cpp"
+#include "utilities.cpp"
+#include "curves.cpp"
+
+namespace fixed_path {
+#undef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT 1
+#include "mixing.cpp"
+}
+
+namespace float_path {
+#undef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT 0
+#include "mixing.cpp"
+}
+
+// ============================================================================
+// COLLABORATOR STUBS
+// ============================================================================
+
+// Compiled default profiles, with motion shaping off so every call mixes
+// the stick position it is given
+#define TEST_PROFILE(mode) { \
+  mode##_PROFILE_NAME, mode##_MAX_DUTY, \
+  { mode##_CURVE_X, mode##_CURVE_Y, mode##_CURVE_R }, \
+  mode##_ROTATION_PCT, mode##_STOP_BRAKE, {0, 0, 0}, {0, 0, 0}, 0, 0, 0 }
+
+static DriveProfile g_profiles[3] = {
+  TEST_PROFILE(BEGINNER), TEST_PROFILE(NORMAL), TEST_PROFILE(AGGRESSIVE)
+};
+
+const DriveProfile* profiles_get(uint8_t mode) { return &g_profiles[mode < 3 ? mode : 1]; }
+uint8_t profiles_get_generation() { return 0; }
+
+static int16_t g_motor[4];
+void actuators_set_motor(uint8_t motor_index, int16_t command) { g_motor[motor_index] = command; }
+
+int16_t speed_control_apply(uint8_t, int16_t command) { return command; }
+void speed_control_init() {}
+void speed_control_reset() {}
+int16_t servo_get_drive_kick() { return 0; }
+void yaw_control_init() {}
+void yaw_control_reset() {}
+int16_t yaw_control_update(int16_t rate_cmd_q12, bool) { return rate_cmd_q12; }
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+#define RAW_MIN  172
+#define RAW_MAX  1811
+
+// Largest |fixed - float| over one stick position, per wheel
+static int16_t g_worst;
+static int16_t g_worst_raw[3];
+
+static void compare_at(int16_t roll, int16_t pitch, int16_t yaw) {
+  g_state.input.raw_channels[0] = roll;
+  g_state.input.raw_channels[1] = pitch;
+  g_state.input.raw_channels[3] = yaw;
+
+  int16_t fixed_out[4];
+  fixed_path::mixing_update();
+  memcpy(fixed_out, g_motor, sizeof(fixed_out));
+  float_path::mixing_update();
+
+  for (uint8_t i = 0; i < 4; i++) {
+    int16_t diff = abs(fixed_out[i] - g_motor[i]);
+    if (diff > g_worst) {
+      g_worst = diff;
+      g_worst_raw[0] = roll;
+      g_worst_raw[1] = pitch;
+      g_worst_raw[2] = yaw;
+    }
+  }
+}
+
+static void select_mode(DriveMode mode) {
+  fixed_path::mixing_init();
+  float_path::mixing_init();
+  fixed_path::mixing_set_drive_mode(mode);
+  float_path::mixing_set_drive_mode(mode);
+  g_worst = 0;
+}
+
+static void report(const char* what) {
+  char line[96];
+  snprintf(line, sizeof(line), "%s: worst |fixed - float| = %d PWM at roll %d pitch %d yaw %d",
+           what, g_worst, g_worst_raw[0], g_worst_raw[1], g_worst_raw[2]);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(1, g_worst, line);
+}
+
+// Every raw value of two sticks, the third one centered
+static void sweep_planes(DriveMode mode, const char* what) {
+  select_mode(mode);
+  for (int16_t a = RAW_MIN; a <= RAW_MAX; a++) {
+    for (int16_t b = RAW_MIN; b <= RAW_MAX; b++) {
+      compare_at(a, b, 992);   // Roll + pitch (translation)
+      compare_at(a, 992, b);   // Roll + yaw
+      compare_at(992, a, b);   // Pitch + yaw
+    }
+  }
+  report(what);
+}
+
+// All three sticks together on a grid (every 7th raw value, both ends in)
+static void sweep_volume(DriveMode mode, const char* what) {
+  select_mode(mode);
+  for (int16_t a = RAW_MIN; a <= RAW_MAX + 6; a += 7) {
+    for (int16_t b = RAW_MIN; b <= RAW_MAX + 6; b += 7) {
+      for (int16_t c = RAW_MIN; c <= RAW_MAX + 6; c += 7) {
+        compare_at(a > RAW_MAX ? RAW_MAX : a, b > RAW_MAX ? RAW_MAX : b, c > RAW_MAX ? RAW_MAX : c);
+      }
+    }
+  }
+  report(what);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+static void test_center_is_zero() {
+  select_mode(DRIVE_MODE_NORMAL);
+  compare_at(992, 992, 992);
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL_INT(0, g_motor[i]);
+  }
+}
+
+static void test_full_forward_reaches_max_duty() {
+  select_mode(DRIVE_MODE_AGGRESSIVE);
+  compare_at(992, RAW_MAX, 992);
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL_INT(AGGRESSIVE_MAX_DUTY, g_motor[i]);
+  }
+}
+
+static void test_planes_beginner()   { sweep_planes(DRIVE_MODE_BEGINNER, "Beginner planes"); }
+static void test_planes_normal()     { sweep_planes(DRIVE_MODE_NORMAL, "Normal planes"); }
+static void test_planes_aggressive() { sweep_planes(DRIVE_MODE_AGGRESSIVE, "Aggressive planes"); }
+static void test_volume_normal()     { sweep_volume(DRIVE_MODE_NORMAL, "Normal volume"); }
+static void test_volume_aggressive() { sweep_volume(DRIVE_MODE_AGGRESSIVE, "Aggressive volume"); }
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_center_is_zero);
+  RUN_TEST(test_full_forward_reaches_max_duty);
+  RUN_TEST(test_planes_beginner);
+  RUN_TEST(test_planes_normal);
+  RUN_TEST(test_planes_aggressive);
+  RUN_TEST(test_volume_normal);
+  RUN_TEST(test_volume_aggressive);
+  return UNITY_END();
+}
@@ -0,0 +1,153 @@
+// test_pwm_linearity.cpp - Low-duty torque and speed at both motor PWM rates
+// UpVote Battlebot - Phase 8
+//
+// Drives the DC motor model (dc_motor.h) at low duties with the PWM period
+// of each MOTOR_PWM_PRESCALER: 64 (976 Hz) and 8 (7.8 kHz). Mean winding
+// current with the rotor held is the low-speed torque; mean speed running
+// free is what the wheel does with it. Each is reported per duty, with its
+// nonlinearity (largest distance from the least-squares line, as a share
+// of its span). With a 375 us winding time constant the current never
+// settles within a 7.8 kHz on-time and the L293D's fast decay empties it
+// each period, so the fast rate gives less torque and a curve that bends
+// further; the report shows by how much.
+#include <unity.h>
+#include <stdio.h>
+#include "config.h"
+#include "../dc_motor.h"
+
+#define DUTY_MIN     16
+#define DUTY_STEP    16
+#define DUTY_POINTS  8      // 16-128: the low half of the range
+#define STALL_SETTLE_US   20000UL
+#define STALL_US         100000UL
+#define FREE_SETTLE_US  1500000UL   // 10 mechanical time constants
+#define FREE_US          100000UL
+#define MAX_NONLINEARITY  0.10      // At 976 Hz, of the span
+#define MOVING_SPEED      0.01      // Turning, not just creeping per pulse
+
+struct Curve {
+  double stall_a[DUTY_POINTS];    // Mean current, rotor held
+  double speed[DUTY_POINTS];      // Mean speed, running free
+};
+
+static uint8_t duty_at(uint8_t n) { return DUTY_MIN + n * DUTY_STEP; }
+static unsigned pwm_hz(uint16_t prescaler) { return F_CPU / 256 / prescaler; }
+
+// Mean current (rotor held) or speed (free) at one duty, from rest
+static double mean_at(uint32_t period_us, uint8_t duty, bool locked) {
+  DcMotor motor;
+  memset(&motor, 0, sizeof(motor));
+  motor.locked = locked;
+  dc_motor_run(&motor, period_us, duty, 1, false, locked ? STALL_SETTLE_US : FREE_SETTLE_US);
+  motor.charge = 0;
+  motor.travel_mm = 0;
+  uint32_t us = locked ? STALL_US : FREE_US;
+  dc_motor_run(&motor, period_us, duty, 1, false, us);
+  return locked ? motor.charge / (us * 1e-6)
+                : motor.travel_mm / TOP_SPEED_MM_S / (us * 1e-6);
+}
+
+static void measure(uint16_t prescaler, Curve* curve) {
+  uint32_t period_us = DC_MOTOR_PERIOD_US(prescaler);
+  for (uint8_t n = 0; n < DUTY_POINTS; n++) {
+    curve->stall_a[n] = mean_at(period_us, duty_at(n), true);
+    curve->speed[n] = mean_at(period_us, duty_at(n), false);
+  }
+}
+
+// Largest distance of y from its least-squares line over the duties, as a
+// share of y's span (0 = straight)
+static double nonlinearity(const double* y) {
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (uint8_t n = 0; n < DUTY_POINTS; n++) {
+    double x = duty_at(n);
+    sx += x;
+    sy += y[n];
+    sxx += x * x;
+    sxy += x * y[n];
+  }
+  double slope = (DUTY_POINTS * sxy - sx * sy) / (DUTY_POINTS * sxx - sx * sx);
+  double offset = (sy - slope * sx) / DUTY_POINTS;
+  double worst = 0;
+  for (uint8_t n = 0; n < DUTY_POINTS; n++) {
+    double error = fabs(y[n] - offset - slope * duty_at(n));
+    if (error > worst) worst = error;
+  }
+  double span = y[DUTY_POINTS - 1] - y[0];
+  return span > 0 ? worst / span : 1.0;
+}
+
+static void report(uint16_t prescaler, const Curve* curve) {
+  char line[100];
+  for (uint8_t n = 0; n < DUTY_POINTS; n++) {
+    double ideal_a = duty_at(n) * MOTOR_V / MOTOR_R / MOTOR_PWM_MAX;
+    snprintf(line, sizeof(line), "%4u Hz duty %3u: held %.3f A (%2.0f%% of duty * V/R), free speed %.3f",
+             pwm_hz(prescaler), duty_at(n), curve->stall_a[n],
+             100.0 * curve->stall_a[n] / ideal_a, curve->speed[n]);
+    TEST_MESSAGE(line);
+  }
+  snprintf(line, sizeof(line), "%4u Hz nonlinearity: current %.1f%%, speed %.1f%%", pwm_hz(prescaler),
+           100.0 * nonlinearity(curve->stall_a), 100.0 * nonlinearity(curve->speed));
+  TEST_MESSAGE(line);
+}
+
+static Curve g_slow;   // Prescaler 64
+static Curve g_fast;   // Prescaler 8
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+// More duty is never less torque or speed, at either rate
+static void test_monotonic() {
+  for (uint8_t n = 1; n < DUTY_POINTS; n++) {
+    TEST_ASSERT_TRUE(g_slow.stall_a[n] > g_slow.stall_a[n - 1]);
+    TEST_ASSERT_TRUE(g_fast.stall_a[n] > g_fast.stall_a[n - 1]);
+    TEST_ASSERT_TRUE(g_slow.speed[n] >= g_slow.speed[n - 1]);
+    TEST_ASSERT_TRUE(g_fast.speed[n] >= g_fast.speed[n - 1]);
+  }
+}
+
+// First duty that turns the wheel (DUTY_POINTS: none in the range)
+static uint8_t breakaway(const Curve* curve) {
+  uint8_t n = 0;
+  while (n < DUTY_POINTS && curve->speed[n] < MOVING_SPEED) n++;
+  return n;
+}
+
+// 976 Hz: more torque at every low duty, turns the wheel no later
+static void test_low_duty_torque() {
+  for (uint8_t n = 0; n < DUTY_POINTS; n++) {
+    TEST_ASSERT_TRUE(g_slow.stall_a[n] > g_fast.stall_a[n]);
+  }
+  uint8_t slow = breakaway(&g_slow), fast = breakaway(&g_fast);
+  char line[64];
+  snprintf(line, sizeof(line), "Breakaway duty: %u at %u Hz, %u at %u Hz",
+           duty_at(slow), pwm_hz(64), duty_at(fast), pwm_hz(8));
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_THAN(DUTY_POINTS, slow);
+  TEST_ASSERT_TRUE(slow <= fast);
+}
+
+// Duty to current and to speed: straighter at 976 Hz, within the bound
+static void test_linearity() {
+  report(64, &g_slow);
+  report(8, &g_fast);
+  TEST_ASSERT_TRUE(nonlinearity(g_slow.stall_a) < nonlinearity(g_fast.stall_a));
+  TEST_ASSERT_TRUE(nonlinearity(g_slow.speed) < nonlinearity(g_fast.speed));
+  TEST_ASSERT_TRUE(nonlinearity(g_slow.stall_a) <= MAX_NONLINEARITY);
+}
+
+int main() {
+  measure(64, &g_slow);
+  measure(8, &g_fast);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_linearity);
+  RUN_TEST(test_monotonic);
+  RUN_TEST(test_low_duty_torque);
+  return UNITY_END();
+}
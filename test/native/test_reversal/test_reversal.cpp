@@ -0,0 +1,162 @@
+// test_reversal.cpp - Wheel reversal handling against a DC motor model
+// UpVote Battlebot - Phase 8
+//
+// actuators.cpp drives a simulated brushed motor (winding resistance,
+// back-EMF, inertia, friction) through the L293D's drive / brake / coast
+// states. A full-speed wheel commanded to full reverse is run with the
+// firmware's reversal handling and with the command plugged straight in,
+// and the report compares stopping time, travel and peak channel current.
+#include <unity.h>
+#include <stdio.h>
+
+#include "actuators.cpp"
+#include "state.cpp"
+#include "../dc_motor.h"
+
+// ============================================================================
+// COLLABORATOR STUBS
+// ============================================================================
+
+#define TEST_DEADZONE  30    // Breakaway duty of every channel
+
+static uint8_t g_duty[4];
+static uint8_t g_reverse_mask;
+static uint8_t g_brake_mask;
+static uint8_t g_heat_duty[4];
+
+void motor_driver_init() {}
+void motor_driver_brake() {}
+void motor_driver_write(const uint8_t duty[4], uint8_t reverse_mask, uint8_t brake_mask) {
+  memcpy(g_duty, duty, sizeof(g_duty));
+  g_reverse_mask = reverse_mask;
+  g_brake_mask = brake_mask;
+}
+void pulse_out_init() {}
+void pulse_out_write(uint16_t, uint16_t) {}
+uint8_t thermal_clamp_duty(uint8_t, uint8_t requested_duty) { return requested_duty; }
+void thermal_update_channel(uint8_t motor_index, uint8_t applied_duty) { g_heat_duty[motor_index] = applied_duty; }
+int16_t motor_comp_apply(uint8_t, int16_t command) { return command; }
+uint8_t motor_comp_get_deadzone(uint8_t, uint8_t) { return TEST_DEADZONE; }
+bool crsf_uart_kill_active() { return false; }
+DriveMode mixing_get_drive_mode() { return DRIVE_MODE_NORMAL; }
+
+static DriveProfile g_profile;   // Coast at stop
+const DriveProfile* profiles_get(uint8_t) { return &g_profile; }
+
+// ============================================================================
+// MOTOR MODEL
+// ============================================================================
+
+static DcMotor g_motor;   // See dc_motor.h
+
+// Advance the motor one tick in a channel state at the firmware's PWM rate
+static void motor_tick(uint8_t duty, int8_t dir, bool brake) {
+  dc_motor_run(&g_motor, DC_MOTOR_PERIOD_US(MOTOR_PWM_PRESCALER), duty, dir, brake,
+               LOOP_PERIOD_MS * 1000UL);
+}
+
+// One control tick: either through actuators.cpp (wheel 0 = RL) or with
+// the command applied to the motor as is
+static void tick(int16_t command, bool firmware) {
+  if (firmware) {
+    g_state.output.motor_rl_pwm = command;
+    actuators_update();
+    bool reverse = (g_reverse_mask ^ MOTOR_INVERT_MASK) & 0x01;
+    motor_tick(g_duty[0], reverse ? -1 : 1, g_brake_mask & 0x01);
+  } else {
+    motor_tick((uint8_t)abs(command), command < 0 ? -1 : 1, false);
+  }
+}
+
+struct StopResult {
+  uint16_t stop_ms;     // Reversal command to wheel at rest
+  double travel_mm;     // Forward travel in that time
+  double peak_a;        // Highest channel current in it
+};
+
+// Full forward until settled, then full reverse until the wheel stops
+static StopResult full_reversal(bool firmware) {
+  actuators_init();
+  memset(&g_motor, 0, sizeof(g_motor));
+  for (uint16_t t = 0; t < 100; t++) tick(MOTOR_PWM_MAX, firmware);
+
+  g_motor.travel_mm = 0;
+  g_motor.peak_a = 0;
+  StopResult result;
+  result.stop_ms = 0;
+  while (g_motor.speed > 0 && result.stop_ms < 1000) {
+    tick(-MOTOR_PWM_MAX, firmware);
+    result.stop_ms += LOOP_PERIOD_MS;
+  }
+  result.travel_mm = g_motor.travel_mm;
+  result.peak_a = g_motor.peak_a;
+  return result;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {
+  actuators_init();
+  memset(&g_motor, 0, sizeof(g_motor));
+}
+void tearDown() {}
+
+static void test_full_reversal_vs_plugging() {
+  StopResult fw = full_reversal(true);
+  StopResult plug = full_reversal(false);
+
+  char line[100];
+  snprintf(line, sizeof(line), "Brake %d ms + ramp %d ms: stop in %u ms, %.0f mm, peak %.2f A",
+           MOTOR_REVERSE_BRAKE_MS, MOTOR_REVERSE_RAMP_MS, fw.stop_ms, fw.travel_mm, fw.peak_a);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "Plugged straight into reverse: stop in %u ms, %.0f mm, peak %.2f A",
+           plug.stop_ms, plug.travel_mm, plug.peak_a);
+  TEST_MESSAGE(line);
+
+  // The brake and ramp exist to cut the plugging current spike; they cost
+  // stopping distance (the wheel is still turning when the ramp starts)
+  TEST_ASSERT_TRUE_MESSAGE(fw.peak_a < plug.peak_a * 0.9, "Peak current not reduced");
+  TEST_ASSERT_TRUE_MESSAGE(fw.travel_mm < plug.travel_mm * 2.5, "Stopping distance grew too much");
+  TEST_ASSERT_LESS_THAN(1000, fw.stop_ms);
+}
+
+// The brake ticks are seen by the thermal model (they carry back-EMF current)
+static void test_brake_heats_channel() {
+  for (uint8_t t = 0; t < 50; t++) tick(200, true);
+  tick(-200, true);
+  TEST_ASSERT_TRUE(g_brake_mask & 0x01);
+  TEST_ASSERT_EQUAL_UINT8((200 * MOTOR_REVERSE_BRAKE_DUTY) / MOTOR_PWM_MAX, g_heat_duty[0]);
+}
+
+// A wheel crawling at breakaway changes direction without brake or ramp
+static void test_slow_wheel_flips_without_brake() {
+  const int16_t slow = TEST_DEADZONE + MOTOR_REVERSE_MIN_DUTY;
+  for (uint8_t t = 0; t < 50; t++) tick(slow, true);
+  tick(-slow, true);
+  TEST_ASSERT_FALSE(g_brake_mask & 0x01);
+  TEST_ASSERT_EQUAL_UINT8(slow, g_duty[0]);
+
+  // One count faster is a reversal
+  for (uint8_t t = 0; t < 50; t++) tick(-(slow + 1), true);
+  tick(slow + 1, true);
+  TEST_ASSERT_TRUE(g_brake_mask & 0x01);
+}
+
+// Stopped for the brake time: the next direction starts straight away
+static void test_settled_wheel_starts_without_brake() {
+  for (uint8_t t = 0; t < 50; t++) tick(200, true);
+  for (uint8_t t = 0; t < REVERSE_BRAKE_TICKS; t++) tick(0, true);
+  tick(-200, true);
+  TEST_ASSERT_FALSE(g_brake_mask & 0x01);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_reversal_vs_plugging);
+  RUN_TEST(test_brake_heats_channel);
+  RUN_TEST(test_slow_wheel_flips_without_brake);
+  RUN_TEST(test_settled_wheel_starts_without_brake);
+  return UNITY_END();
+}
@@ -0,0 +1,104 @@
+// test_scurve.cpp - Jerk-limited follower: limits held, target never passed
+// UpVote Battlebot - Phase 8
+// scurve_update() shapes the drive axes and the weapon ramp, so a follower
+// that ran on past its target would keep a weapon speeding up after the
+// slider came down.
+#include <unity.h>
+#include <stdlib.h>
+
+#include "utilities.h"
+#include "utilities.cpp"
+
+static const SCurveLimits g_limits = { 40, 80, 10 };   // away, toward, jerk
+
+// One step, checking the invariants every caller relies on
+static void step(SCurveState* s, int16_t target, const SCurveLimits* limits) {
+  int16_t before = s->value;
+  int16_t rate_before = s->rate;
+  scurve_update(s, target, limits);
+
+  // New value lies between the old one and the target (inclusive)
+  int16_t lo = before < target ? before : target;
+  int16_t hi = before < target ? target : before;
+  TEST_ASSERT_TRUE_MESSAGE(s->value >= lo && s->value <= hi, "moved away from or past the target");
+
+  // Rate within the larger limit, and changed by at most one jerk step
+  // unless it was dropped to zero (target moved onto or behind the output)
+  int16_t rate_limit = limits->rate_away > limits->rate_toward ? limits->rate_away : limits->rate_toward;
+  TEST_ASSERT_LESS_OR_EQUAL_INT(rate_limit, abs(s->rate));
+  if (s->rate != 0 && s->value != target) {
+    int16_t delta = s->rate - rate_before;
+    bool dropped = (rate_before > 0) != (s->rate > 0) && rate_before != 0;
+    if (!dropped) TEST_ASSERT_LESS_OR_EQUAL_INT(limits->rate_step, abs(delta));
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_reaches_target_without_passing() {
+  SCurveState s = { 0, 0 };
+  uint16_t steps = 0;
+  while (s.value != 1000 || s.rate != 0) {
+    step(&s, 1000, &g_limits);
+    TEST_ASSERT_LESS_THAN_INT(200, ++steps);
+  }
+  // 1000 at 40/step with 4-step ramps each end: ~29 steps
+  TEST_ASSERT_LESS_OR_EQUAL_INT(32, steps);
+}
+
+static void test_target_onto_output_mid_ramp_holds() {
+  SCurveState s = { 0, 0 };
+  for (uint8_t i = 0; i < 8; i++) step(&s, 1000, &g_limits);
+  TEST_ASSERT_GREATER_THAN_INT(0, s.rate);
+
+  int16_t hold = s.value;
+  for (uint8_t i = 0; i < 20; i++) {
+    step(&s, hold, &g_limits);
+    TEST_ASSERT_EQUAL_INT(hold, s.value);
+  }
+  TEST_ASSERT_EQUAL_INT(0, s.rate);
+}
+
+static void test_target_behind_output_turns_back_at_once() {
+  SCurveState s = { 0, 0 };
+  for (uint8_t i = 0; i < 8; i++) step(&s, 1000, &g_limits);
+  int16_t peak = s.value;
+
+  // Slider back to zero mid spin-up: never above the point it was at
+  for (uint8_t i = 0; i < 100; i++) {
+    step(&s, 0, &g_limits);
+    TEST_ASSERT_LESS_OR_EQUAL_INT(peak, s.value);
+  }
+  TEST_ASSERT_EQUAL_INT(0, s.value);
+}
+
+static void test_pass_through_limits() {
+  const SCurveLimits open = { INT16_MAX, INT16_MAX, INT16_MAX };
+  SCurveState s = { 0, 0 };
+  scurve_update(&s, 4096, &open);
+  TEST_ASSERT_EQUAL_INT(4096, s.value);
+  scurve_update(&s, -4096, &open);
+  TEST_ASSERT_EQUAL_INT(-4096, s.value);
+}
+
+// Targets that jump around every few steps, both signs
+static void test_random_targets_keep_invariants() {
+  srand(1234);
+  SCurveState s = { 0, 0 };
+  int16_t target = 0;
+  for (uint32_t i = 0; i < 200000; i++) {
+    if (rand() % 7 == 0) target = (int16_t)(rand() % 8193 - 4096);
+    step(&s, target, &g_limits);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_reaches_target_without_passing);
+  RUN_TEST(test_target_onto_output_mid_ramp_holds);
+  RUN_TEST(test_target_behind_output_turns_back_at_once);
+  RUN_TEST(test_pass_through_limits);
+  RUN_TEST(test_random_targets_keep_invariants);
+  return UNITY_END();
+}
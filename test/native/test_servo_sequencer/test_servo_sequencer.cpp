@@ -0,0 +1,218 @@
+// test_servo_sequencer.cpp - Self-right keyframe timing on a fake clock
+// UpVote Battlebot - Phase 8
+//
+// Plays the compiled self-right sequence through servo_update() with
+// regular, jittered and stalled ticks, and checks every tick against the
+// keyframe table read as a timeline in ms: servo position, drive kick
+// window, repeats while CH7 is held, the SELFRIGHT_MAX_MS cut-off, and the
+// immediate abort on kill or link loss.
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "servo.cpp"
+#include "state.cpp"
+
+// ============================================================================
+// STUBS
+// ============================================================================
+
+static uint32_t g_now_ms;
+
+uint32_t timebase_millis() { return g_now_ms; }
+
+// ============================================================================
+// REFERENCE TIMELINE
+// ============================================================================
+
+static const ServoKeyframe g_frames[] = SEQ_FRAMES(SELFRIGHT_SEQUENCE);
+#define FRAME_COUNT  (sizeof(g_frames) / sizeof(g_frames[0]))
+
+struct Expected {
+  bool active;
+  uint16_t servo_us;
+  int16_t kick_q12;
+};
+
+// Where the sequence should be t ms after its start, from the table alone
+// held: CH7 high the whole time (else released right after the start)
+static Expected expected_at(uint32_t t, bool held, uint16_t start_us) {
+  uint32_t frame_ms = 0;
+  uint16_t from_us = start_us;
+  uint8_t index = 0;
+  for (;;) {
+    const ServoKeyframe& frame = g_frames[index];
+    uint32_t duration = (uint32_t)frame.move_ms + frame.hold_ms;
+    if (t < frame_ms + duration) {
+      uint32_t elapsed = t - frame_ms;
+      int32_t travel = (int32_t)frame.servo_us - from_us;
+      uint16_t us = (elapsed >= frame.move_ms) ? frame.servo_us :
+                    (uint16_t)(from_us + travel * (int32_t)elapsed / frame.move_ms);
+      return { true, us, (int16_t)((int32_t)frame.kick_pct * Q12_ONE / 100) };
+    }
+    frame_ms += duration;
+    from_us = frame.servo_us;
+    if (++index >= FRAME_COUNT) {
+      if (!held || frame_ms >= SELFRIGHT_MAX_MS) return { false, from_us, 0 };
+      index = SEQ_REPEAT_FROM;
+    }
+  }
+}
+
+// ============================================================================
+// HARNESS
+// ============================================================================
+
+static uint32_t g_start_ms;
+static uint16_t g_start_us;
+
+static void tick(uint16_t period_ms) {
+  g_now_ms += period_ms;
+  servo_update();
+}
+
+// Link up, no kill, CH7 seen released, then pressed on the next tick
+static void start_sequence() {
+  g_now_ms = 5000;
+  g_state.input.link_ok = true;
+  g_state.input.kill_switch = false;
+  g_state.input.selfright_switch = false;
+  servo_init();
+  tick(LOOP_PERIOD_MS);
+  g_start_us = g_state.output.servo_us;
+  g_state.input.selfright_switch = true;
+  tick(LOOP_PERIOD_MS);
+  g_start_ms = g_now_ms;
+}
+
+// Tick lengths: fixed, or LOOP_PERIOD_MS +-7 ms with one 250 ms stall
+static uint16_t next_period(bool jitter, uint16_t n) {
+  if (!jitter) return LOOP_PERIOD_MS;
+  if (n == 37) return 250;
+  return LOOP_PERIOD_MS - 7 + rand() % 15;
+}
+
+// Run until well past the end, checking every tick against the timeline
+// Returns the time (from the start) of the first tick with the sequence over
+static uint32_t play_and_check(bool held, bool jitter) {
+  start_sequence();
+  if (!held) g_state.input.selfright_switch = false;
+
+  uint32_t end_ms = 0;
+  uint16_t last_us = g_state.output.servo_us;
+  for (uint16_t n = 0; g_now_ms - g_start_ms < SELFRIGHT_MAX_MS + 1000; n++) {
+    // The start tick itself is checked too (t = 0)
+    uint32_t t = g_now_ms - g_start_ms;
+    Expected e = expected_at(t, held, g_start_us);
+    char where[64];
+    snprintf(where, sizeof(where), "t = %lu ms", (unsigned long)t);
+
+    if (e.active) {
+      TEST_ASSERT_EQUAL_UINT16_MESSAGE(e.servo_us, g_state.output.servo_us, where);
+      TEST_ASSERT_EQUAL_INT16_MESSAGE(e.kick_q12, servo_get_drive_kick(), where);
+    } else {
+      if (end_ms == 0) end_ms = t;
+      // Over: no kick, and the servo only slews back toward neutral
+      TEST_ASSERT_EQUAL_INT16_MESSAGE(0, servo_get_drive_kick(), where);
+      TEST_ASSERT_TRUE_MESSAGE(abs((int)g_state.output.servo_us - (int)last_us) <= SERVO_SLEW_RATE_MAX ||
+                               t == end_ms, where);
+    }
+    last_us = g_state.output.servo_us;
+    tick(next_period(jitter, n));
+  }
+  TEST_ASSERT_EQUAL_UINT16(SERVO_NEUTRAL_US, g_state.output.servo_us);
+  return end_ms;
+}
+
+// Length of one pass through the table (ms)
+static uint32_t sequence_ms() {
+  uint32_t total = 0;
+  for (const ServoKeyframe& frame : g_frames) total += frame.move_ms + frame.hold_ms;
+  return total;
+}
+
+void setUp() {
+  srand(1);
+}
+void tearDown() {}
+
+// Released after the start: one pass, positions on the timeline every tick
+static void test_single_pass_fixed_ticks() {
+  uint32_t end = play_and_check(false, false);
+  TEST_ASSERT_UINT32_WITHIN(LOOP_PERIOD_MS, sequence_ms(), end);
+}
+
+// Same pass with jittered ticks and a 250 ms stall: still on the timeline,
+// and the stall does not stretch the sequence
+static void test_single_pass_jittered_ticks() {
+  uint32_t end = play_and_check(false, true);
+  char line[64];
+  snprintf(line, sizeof(line), "One pass: %lu ms, ended on the tick at %lu ms",
+           (unsigned long)sequence_ms(), (unsigned long)end);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_UINT32_WITHIN(LOOP_PERIOD_MS + 7, sequence_ms(), end);
+}
+
+// Held: replays from the repeat keyframe until SELFRIGHT_MAX_MS
+static void test_held_repeats_until_max() {
+  uint32_t end = play_and_check(true, true);
+  char line[64];
+  snprintf(line, sizeof(line), "Held: repeats stopped on the tick at %lu ms", (unsigned long)end);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_TRUE(end >= SELFRIGHT_MAX_MS);
+  TEST_ASSERT_TRUE(end <= SELFRIGHT_MAX_MS + sequence_ms());
+}
+
+// Kill or link loss mid-sequence: kick off and servo slewing on that tick,
+// no restart until CH7 has been released
+static void check_abort(bool kill) {
+  start_sequence();
+  uint32_t kick_ms = 0;
+  while (servo_get_drive_kick() == 0) {
+    tick(LOOP_PERIOD_MS);
+    kick_ms += LOOP_PERIOD_MS;
+    TEST_ASSERT_TRUE(kick_ms < SELFRIGHT_MAX_MS);
+  }
+
+  uint16_t before = g_state.output.servo_us;
+  if (kill) g_state.input.kill_switch = true; else g_state.input.link_ok = false;
+  tick(LOOP_PERIOD_MS);
+  TEST_ASSERT_EQUAL_INT16(0, servo_get_drive_kick());
+  TEST_ASSERT_TRUE(abs((int)g_state.output.servo_us - (int)before) <= SERVO_SLEW_RATE_MAX);
+
+  // Cleared with CH7 still held: stays stopped
+  g_state.input.kill_switch = false;
+  g_state.input.link_ok = true;
+  for (uint8_t i = 0; i < 50; i++) {
+    before = g_state.output.servo_us;
+    tick(LOOP_PERIOD_MS);
+    TEST_ASSERT_TRUE(abs((int)g_state.output.servo_us - (int)before) <= SERVO_SLEW_RATE_MAX);
+  }
+
+  // Release and press: starts again from where the servo is
+  g_state.input.selfright_switch = false;
+  tick(LOOP_PERIOD_MS);
+  uint16_t from = g_state.output.servo_us;
+  g_state.input.selfright_switch = true;
+  tick(LOOP_PERIOD_MS);
+  tick(LOOP_PERIOD_MS);
+  TEST_ASSERT_EQUAL_UINT16(expected_at(LOOP_PERIOD_MS, true, from).servo_us, g_state.output.servo_us);
+}
+
+static void test_kill_aborts() {
+  check_abort(true);
+}
+
+static void test_link_loss_aborts() {
+  check_abort(false);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_single_pass_fixed_ticks);
+  RUN_TEST(test_single_pass_jittered_ticks);
+  RUN_TEST(test_held_repeats_until_max);
+  RUN_TEST(test_kill_aborts);
+  RUN_TEST(test_link_loss_aborts);
+  return UNITY_END();
+}
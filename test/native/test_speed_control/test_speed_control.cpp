@@ -0,0 +1,179 @@
+// test_speed_control.cpp - Per-wheel speed PI closed around the simulated wheels
+// UpVote Battlebot - Phase 8
+//
+// speed_control_apply() runs against encoders.cpp's simulated wheels
+// (first-order response, front wheels breaking away at a higher duty than
+// the rear, one wheel at a time losing traction). Its output goes to the
+// wheels and the sim reads it back next tick, as on the robot. Each case
+// is run closed and open loop so the report shows what the encoders buy.
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ENCODER_BACKEND  2   // ENCODER_BACKEND_SIM (config.h only sets a default)
+
+#include "speed_control.cpp"
+#include "encoders.cpp"
+#include "state.cpp"
+#include "utilities.cpp"
+
+// ============================================================================
+// CLOSED LOOP
+// ============================================================================
+
+#define TICKS_PER_S     (1000 / LOOP_PERIOD_MS)
+#define SETTLE_TICKS    (TICKS_PER_S / 2)
+#define WINDOW_TICKS    (TICKS_PER_S)     // Ends before the second slip period
+#define SPEED_BAND      0.05              // Of the target speed
+
+static uint32_t g_now_us;
+uint32_t timebase_micros() { return g_now_us; }
+uint32_t timebase_millis() { return g_now_us / 1000; }
+
+static bool g_closed;   // Encoders in the loop (else the command goes straight out)
+
+// One control tick: encoders, controller, duties onto the wheels
+static void tick(int16_t command) {
+  g_now_us += LOOP_PERIOD_US;
+  encoders_update();
+  int16_t out[4];
+  for (uint8_t i = 0; i < 4; i++) {
+    out[i] = g_closed ? speed_control_apply(i, command) : command;
+  }
+  g_state.output.motor_rl_pwm = out[0];
+  g_state.output.motor_rr_pwm = out[1];
+  g_state.output.motor_fl_pwm = out[2];
+  g_state.output.motor_fr_pwm = out[3];
+}
+
+// Cleared wheels and controllers; the sim's slip schedule starts over
+// (wheel RL slips for the first SIM_SLIP_TICKS)
+static void start(bool closed) {
+  g_closed = closed;
+  g_now_us = 0;
+  g_state.output.motor_rl_pwm = 0;
+  g_state.output.motor_rr_pwm = 0;
+  g_state.output.motor_fl_pwm = 0;
+  g_state.output.motor_fr_pwm = 0;
+  encoders_init();
+  speed_control_init();
+}
+
+// Target speed of a command (edges/s)
+static int32_t target_eps(int16_t command) {
+  return ((int32_t)command * ENCODER_MAX_EPS) / MOTOR_PWM_MAX;
+}
+
+// Mean speed per wheel over WINDOW_TICKS after SETTLE_TICKS, clear of the
+// first slip period
+static void settled_speeds(bool closed, int16_t command, int32_t mean[4]) {
+  start(closed);
+  for (uint16_t n = 0; n < SETTLE_TICKS; n++) tick(command);
+  int32_t total[4] = { 0, 0, 0, 0 };
+  for (uint16_t n = 0; n < WINDOW_TICKS; n++) {
+    tick(command);
+    for (uint8_t i = 0; i < 4; i++) total[i] += encoders_get_speed(i);
+  }
+  for (uint8_t i = 0; i < 4; i++) mean[i] = total[i] / WINDOW_TICKS;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+// Front and rear break away at different duties: open loop they run at
+// different speeds, closed loop every wheel meets the target (period
+// method at the low command, count method at the high one)
+static void test_converges_despite_friction_mismatch() {
+  static const int16_t commands[] = { 60, -60, 160, -160 };
+  for (uint8_t c = 0; c < sizeof(commands) / sizeof(commands[0]); c++) {
+    int32_t closed[4], open[4];
+    settled_speeds(true, commands[c], closed);
+    settled_speeds(false, commands[c], open);
+    int32_t target = target_eps(commands[c]);
+
+    char line[100];
+    snprintf(line, sizeof(line), "Command %d (%ld eps), RL/RR/FL/FR: closed %ld/%ld/%ld/%ld",
+             commands[c], (long)target, (long)closed[0], (long)closed[1], (long)closed[2], (long)closed[3]);
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "Command %d (%ld eps), RL/RR/FL/FR: open %ld/%ld/%ld/%ld",
+             commands[c], (long)target, (long)open[0], (long)open[1], (long)open[2], (long)open[3]);
+    TEST_MESSAGE(line);
+
+    int32_t band = (int32_t)(labs(target) * SPEED_BAND);
+    for (uint8_t i = 0; i < 4; i++) {
+      TEST_ASSERT_INT_WITHIN(band, target, closed[i]);
+    }
+    // The sim does have the mismatch: open-loop front wheels are short
+    TEST_ASSERT_TRUE(labs(open[2] - target) > band && labs(open[3] - target) > band);
+  }
+}
+
+// A wheel losing traction is flagged while it overspeeds (integral frozen,
+// feed-forward only), released once it grips again and back on target
+// before the next wheel slips; the others are never flagged
+static void test_slip_flagged_and_released() {
+  const int16_t command = 160;
+  const int32_t target = target_eps(command);
+  start(true);
+  for (uint16_t n = 0; n < SIM_SLIP_PERIOD_TICKS - 1; n++) tick(command);
+  TEST_ASSERT_EQUAL_HEX8(0, speed_control_get_slip_mask());
+
+  // The sim moves the slip to RR on the next tick, for SIM_SLIP_TICKS
+  // (mean RR speed over the last half second)
+  uint16_t flagged = 0, released = 0;
+  bool others = false;
+  int32_t held = 0, total = 0;
+  for (uint16_t n = 0; n < SIM_SLIP_TICKS + TICKS_PER_S; n++) {
+    tick(command);
+    uint8_t mask = speed_control_get_slip_mask();
+    if ((mask & 0x02) && flagged == 0) {
+      flagged = n + 1;
+      held = g_integral[1];
+    }
+    if ((mask & 0x02) && released == 0) {
+      TEST_ASSERT_EQUAL_INT32(held, g_integral[1]);
+      TEST_ASSERT_EQUAL_INT(command, g_state.output.motor_rr_pwm);
+    }
+    if (!(mask & 0x02) && flagged != 0 && released == 0) released = n + 1;
+    if (mask & ~0x02) others = true;
+    if (n >= SIM_SLIP_TICKS + TICKS_PER_S / 2) total += encoders_get_speed(1);
+  }
+
+  char line[100];
+  snprintf(line, sizeof(line), "RR slip for %d ms: flagged after %u ms, released %u ms after it ended",
+           ENCODER_SIM_SLIP_MS, flagged * LOOP_PERIOD_MS,
+           released > SIM_SLIP_TICKS ? (released - SIM_SLIP_TICKS) * LOOP_PERIOD_MS : 0);
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_NOT_EQUAL(0, flagged);
+  TEST_ASSERT_LESS_THAN(SIM_SLIP_TICKS, flagged);
+  TEST_ASSERT_GREATER_THAN(SIM_SLIP_TICKS, released);
+  TEST_ASSERT_LESS_OR_EQUAL(SIM_SLIP_TICKS + TICKS_PER_S / 5, released);
+  TEST_ASSERT_FALSE(others);
+
+  // Integral held through the slip: RR is back on target
+  int32_t band = (int32_t)(target * SPEED_BAND);
+  TEST_ASSERT_INT_WITHIN(band, target, total / (TICKS_PER_S / 2));
+}
+
+// Zero command: passes through as 0, integral cleared
+static void test_stop_clears_wheel() {
+  start(true);
+  for (uint16_t n = 0; n < SETTLE_TICKS; n++) tick(160);
+  TEST_ASSERT_NOT_EQUAL(0, g_integral[2]);   // Front wheel needed trimming
+  tick(0);
+  TEST_ASSERT_EQUAL_INT(0, g_integral[2]);
+  TEST_ASSERT_EQUAL_INT(0, speed_control_apply(2, 0));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_converges_despite_friction_mismatch);
+  RUN_TEST(test_slip_flagged_and_released);
+  RUN_TEST(test_stop_clears_wheel);
+  return UNITY_END();
+}
@@ -0,0 +1,225 @@
+// test_weapon_governor.cpp - Weapon RPM governor closed around the sim weapon
+// UpVote Battlebot - Phase 8
+//
+// weapon.cpp runs against the simulated weapon of weapon_rpm.cpp (first-
+// order spin-up, free speed sagging with the battery, a 40% hit every 4 s),
+// whose tach pulses go through the real RPM estimator. weapon.cpp is built
+// twice, governor on and off, so each case shows what the governor buys.
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WEAPON_RPM_BACKEND  2   // WEAPON_RPM_BACKEND_SIM (config.h only sets a default)
+
+#include "weapon.h"
+#include "config.h"
+#include "state.h"
+#include "safety.h"
+#include "utilities.h"
+#include "mixing.h"
+#include "profiles.h"
+#include "timebase.h"
+#include "actuators.h"
+#include "weapon_rpm.h"
+#include "error_log.h"
+
+#include "weapon_rpm.cpp"
+#include "state.cpp"
+#include "utilities.cpp"
+
+namespace closed_loop {
+#undef WEAPON_GOVERNOR_ENABLED
+#define WEAPON_GOVERNOR_ENABLED 1
+#include "weapon.cpp"
+}
+
+namespace open_loop {
+#undef WEAPON_GOVERNOR_ENABLED
+#define WEAPON_GOVERNOR_ENABLED 0
+#include "weapon.cpp"
+}
+
+// ============================================================================
+// STUBS
+// ============================================================================
+
+static uint32_t g_now_ms;
+static DriveProfile g_profile;
+static uint8_t g_logged_code;
+static uint16_t g_logged_context;
+
+uint32_t timebase_millis() { return g_now_ms; }
+uint32_t timebase_micros() { return g_now_ms * 1000UL; }
+DriveMode mixing_get_drive_mode() { return DRIVE_MODE_NORMAL; }
+const DriveProfile* profiles_get(uint8_t) { return &g_profile; }
+uint8_t profiles_get_generation() { return 0; }
+bool actuators_take_stop_event() { return false; }
+void error_log_record(SystemError code, uint16_t context) {
+  g_logged_code = code;
+  g_logged_context = context;
+}
+
+// ============================================================================
+// CLOSED LOOP
+// ============================================================================
+
+#define TICKS_PER_S       (1000 / LOOP_PERIOD_MS)
+#define HIT_TICKS         (WEAPON_SIM_HIT_PERIOD_MS / LOOP_PERIOD_MS)
+#define SLIDER_Q12        Q12_FROM_FLOAT(0.7f)
+#define TARGET_RPM        ((uint32_t)WEAPON_RPM_MAX * SLIDER_Q12 / Q12_ONE)
+#define BATTERY_PCT       40      // Free speed down to 88% of WEAPON_RPM_MAX
+#define BAND_PCT          5
+
+static bool g_closed;           // Governor build (else open loop)
+static bool g_sensor_dead;      // Tach reads nothing
+
+// One control tick: sensor, then the weapon, as in the main loop
+static uint16_t tick() {
+  g_now_ms += LOOP_PERIOD_MS;
+  if (g_sensor_dead) {
+    weapon_rpm_init();
+  } else {
+    weapon_rpm_update();
+  }
+  if (g_closed) {
+    closed_loop::weapon_update();
+  } else {
+    open_loop::weapon_update();
+  }
+  return (uint16_t)(g_sim_rpm_q4 >> 4);   // True weapon speed
+}
+
+// Boot, arm and set the slider; the hit schedule starts here
+static void start(bool closed) {
+  g_closed = closed;
+  g_sensor_dead = false;
+  g_now_ms = 1000;
+  memset(&g_state, 0, sizeof(g_state));
+  g_profile.weapon_spinup_ms = NORMAL_WEAPON_SPINUP_MS;
+  g_profile.weapon_spindown_ms = NORMAL_WEAPON_SPINDOWN_MS;
+  g_state.battery.last_telemetry_ms = g_now_ms;
+  g_state.battery.percentage = BATTERY_PCT;
+  g_logged_code = ERR_NONE;
+
+  weapon_rpm_init();
+  if (closed) closed_loop::weapon_init(); else open_loop::weapon_init();
+  g_state.input.arm_switch = true;
+  g_state.input.link_ok = true;
+  for (uint8_t i = 0; i < 5; i++) tick();
+  TEST_ASSERT_EQUAL(ARMED, g_state.safety.arm_state);
+  g_state.input.weapon = SLIDER_Q12;
+}
+
+static uint16_t error_pct(uint16_t rpm) {
+  return (uint16_t)(labs((long)rpm - (long)TARGET_RPM) * 100 / TARGET_RPM);
+}
+
+// Mean speed error over the second before the first hit (%)
+static uint16_t settled_error_pct(bool closed) {
+  start(closed);
+  uint32_t total = 0;
+  for (uint16_t i = 5; i < HIT_TICKS - 1; i++) {
+    uint16_t rpm = tick();
+    if (i >= HIT_TICKS - 1 - TICKS_PER_S) total += error_pct(rpm);
+  }
+  return (uint16_t)(total / TICKS_PER_S);
+}
+
+// Ticks from the first hit until the speed is back within the band of the
+// target (UINT16_MAX = not before the next hit)
+static uint16_t recovery_ticks(bool closed) {
+  start(closed);
+  for (uint16_t i = 5; i < HIT_TICKS; i++) tick();
+  for (uint16_t i = 1; i < HIT_TICKS; i++) {
+    if (error_pct(tick()) < BAND_PCT) return i;
+  }
+  return UINT16_MAX;
+}
+
+static void report(const char* label, uint16_t closed, uint16_t open, const char* unit) {
+  char line[96];
+  if (open == UINT16_MAX) {
+    snprintf(line, sizeof(line), "%s: governor %u %s, open loop never", label, closed, unit);
+  } else {
+    snprintf(line, sizeof(line), "%s: governor %u %s, open loop %u %s", label, closed, unit, open, unit);
+  }
+  TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Battery sag: open loop settles short of the target, the governor holds it
+static void test_holds_speed_through_sag() {
+  uint16_t closed = settled_error_pct(true);
+  uint16_t open = settled_error_pct(false);
+  report("Speed error at 40% battery", closed, open, "%");
+  TEST_ASSERT_LESS_THAN_UINT16(2, closed);
+  TEST_ASSERT_GREATER_THAN_UINT16(BAND_PCT, open);
+}
+
+// A 40% hit: the governor gets back within 5% of the target well before
+// the next one, open loop never does (it never got there)
+static void test_recovers_from_hit() {
+  uint16_t closed = recovery_ticks(true);
+  uint16_t open = recovery_ticks(false);
+  report("Recovery to 5% after a hit", closed == UINT16_MAX ? closed : closed * LOOP_PERIOD_MS,
+         open == UINT16_MAX ? open : open * LOOP_PERIOD_MS, "ms");
+  TEST_ASSERT_LESS_THAN_UINT16(TICKS_PER_S, closed);
+  TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, open);
+}
+
+// The integral is held while the ramp moves: the spin-up overshoot (from
+// the proportional term chasing the lagging weapon) stays inside the band
+static void test_no_overshoot_after_spinup() {
+  start(true);
+  uint16_t peak = 0;
+  for (uint16_t i = 5; i < HIT_TICKS - 1; i++) {
+    uint16_t rpm = tick();
+    if (rpm > peak) peak = rpm;
+  }
+  char line[64];
+  snprintf(line, sizeof(line), "Peak after spin-up: %u RPM (target %lu)", peak, (unsigned long)TARGET_RPM);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(TARGET_RPM * (100 + BAND_PCT) / 100, peak);
+}
+
+// No tach pulses with the throttle up: open loop after WEAPON_GOV_FAULT_MS
+static void test_sensor_fault_falls_back_to_open_loop() {
+  start(true);
+  for (uint16_t i = 0; i < TICKS_PER_S; i++) tick();
+  g_sensor_dead = true;
+  for (uint16_t i = 0; i < WEAPON_GOV_FAULT_MS / LOOP_PERIOD_MS + 2; i++) tick();
+
+  // Open-loop pulse for the slider, as the governor-off build would send
+  uint16_t open_us = WEAPON_ESC_MIN_US +
+      ((((int32_t)SLIDER_Q12 * WEAPON_RAMP_RANGE) >> Q12_SHIFT) >> WEAPON_RAMP_SHIFT);
+  TEST_ASSERT_EQUAL_UINT16(open_us, g_state.output.weapon_us);
+}
+
+// Recovered impacts land in the impact log, the slowest in the error history
+static void test_impact_logged() {
+  start(true);
+  for (uint16_t i = 5; i < 2 * HIT_TICKS; i++) tick();
+  const WeaponImpactLog* log = closed_loop::weapon_get_impact_log();
+
+  char line[80];
+  snprintf(line, sizeof(line), "Impact log: %u hits, last %u ms, worst %u ms",
+           log->count, log->last_recovery_ms, log->worst_recovery_ms);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL_UINT16(1, log->count);
+  TEST_ASSERT_TRUE(log->worst_recovery_ms > 0);
+  TEST_ASSERT_EQUAL(ERR_WEAPON_RECOVERY, g_logged_code);
+  TEST_ASSERT_EQUAL_UINT16(log->worst_recovery_ms, g_logged_context);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_holds_speed_through_sag);
+  RUN_TEST(test_recovers_from_hit);
+  RUN_TEST(test_no_overshoot_after_spinup);
+  RUN_TEST(test_sensor_fault_falls_back_to_open_loop);
+  RUN_TEST(test_impact_logged);
+  return UNITY_END();
+}
@@ -0,0 +1,177 @@
+// test_weapon_ramp.cpp - Weapon spin-up and spin-down times per profile
+// UpVote Battlebot - Phase 8
+//
+// Runs weapon_update() on a fake clock with the compiled profile ramp
+// times, open loop (no RPM source). Full-range ramps must take their
+// nominal time plus at most the S-curve corners, whatever the loop period
+// or jitter, and the low-battery spin-up must stretch by its percentage.
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "weapon.cpp"
+#include "state.cpp"
+#include "utilities.cpp"
+
+// ============================================================================
+// STUBS
+// ============================================================================
+
+static uint32_t g_now_ms;
+static DriveProfile g_profile;
+static uint8_t g_generation;
+
+uint32_t timebase_millis() { return g_now_ms; }
+DriveMode mixing_get_drive_mode() { return DRIVE_MODE_NORMAL; }
+const DriveProfile* profiles_get(uint8_t) { return &g_profile; }
+uint8_t profiles_get_generation() { return g_generation; }
+bool actuators_take_stop_event() { return false; }
+uint16_t weapon_rpm_get() { return 0; }
+bool weapon_rpm_available() { return false; }
+void error_log_record(SystemError, uint16_t) {}
+
+// ============================================================================
+// RAMP TIMING
+// ============================================================================
+
+struct RampTimes {
+  const char* name;
+  uint16_t spinup_ms;
+  uint16_t spindown_ms;
+};
+
+static const RampTimes g_ramps[] = {
+  { BEGINNER_PROFILE_NAME, BEGINNER_WEAPON_SPINUP_MS, BEGINNER_WEAPON_SPINDOWN_MS },
+  { NORMAL_PROFILE_NAME, NORMAL_WEAPON_SPINUP_MS, NORMAL_WEAPON_SPINDOWN_MS },
+  { AGGRESSIVE_PROFILE_NAME, AGGRESSIVE_WEAPON_SPINUP_MS, AGGRESSIVE_WEAPON_SPINDOWN_MS },
+  { PUSHER_PROFILE_NAME, PUSHER_WEAPON_SPINUP_MS, PUSHER_WEAPON_SPINDOWN_MS },
+};
+
+static uint8_t g_jitter_ms;     // Tick period varies by up to +-this
+
+static void use_profile(const RampTimes& ramp) {
+  g_profile.weapon_spinup_ms = ramp.spinup_ms;
+  g_profile.weapon_spindown_ms = ramp.spindown_ms;
+  g_generation++;
+}
+
+// One control tick of period_ms (give or take the jitter)
+static void tick(uint8_t period_ms) {
+  int16_t jitter = g_jitter_ms ? (rand() % (2 * g_jitter_ms + 1)) - g_jitter_ms : 0;
+  g_now_ms += period_ms + jitter;
+  weapon_update();
+}
+
+// Boot and arm with the slider at zero (debounce, then the arming checks)
+static void start_armed(uint8_t period_ms) {
+  g_now_ms = 1000;
+  memset(&g_state, 0, sizeof(g_state));
+  weapon_init();
+  g_state.input.arm_switch = true;
+  g_state.input.link_ok = true;
+  for (uint8_t i = 0; i < 10; i++) tick(period_ms);
+  TEST_ASSERT_EQUAL(ARMED, g_state.safety.arm_state);
+}
+
+// Time for the output to reach a pulse width after the slider moves (ms)
+static uint32_t time_to(int16_t throttle_q12, uint16_t weapon_us, uint8_t period_ms) {
+  uint32_t start = g_now_ms;
+  g_state.input.weapon = throttle_q12;
+  while (g_state.output.weapon_us != weapon_us) {
+    tick(period_ms);
+    if (g_now_ms - start > 10000) return UINT32_MAX;
+  }
+  return g_now_ms - start;
+}
+
+// Nominal time up to the S-curve corners, at tick resolution
+static void check_time(const char* label, uint32_t measured, uint16_t nominal, uint8_t period_ms) {
+  char line[96];
+  snprintf(line, sizeof(line), "%s: %lu ms (nominal %u, %u ms ticks +-%u)", label,
+           (unsigned long)measured, nominal, period_ms, g_jitter_ms);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_TRUE_MESSAGE(measured + period_ms + g_jitter_ms >= nominal, "ramp faster than its profile time");
+  TEST_ASSERT_TRUE_MESSAGE(measured <= (uint32_t)nominal + WEAPON_RAMP_JERK_MS + period_ms + g_jitter_ms,
+                           "ramp slower than its profile time plus the S-curve corners");
+}
+
+void setUp() {
+  g_jitter_ms = 0;
+  srand(1);
+}
+void tearDown() {}
+
+// Every profile, full range up and back down at the 100 Hz loop rate
+static void test_profile_ramp_times() {
+  for (const RampTimes& ramp : g_ramps) {
+    use_profile(ramp);
+    start_armed(LOOP_PERIOD_MS);
+    char label[48];
+    snprintf(label, sizeof(label), "%s spin-up", ramp.name);
+    check_time(label, time_to(Q12_ONE, WEAPON_ESC_MAX_US, LOOP_PERIOD_MS), ramp.spinup_ms, LOOP_PERIOD_MS);
+    snprintf(label, sizeof(label), "%s spin-down", ramp.name);
+    check_time(label, time_to(0, WEAPON_ESC_MIN_US, LOOP_PERIOD_MS), ramp.spindown_ms, LOOP_PERIOD_MS);
+  }
+}
+
+// Spin-down is never quicker than spin-up in the compiled defaults
+static void test_spindown_not_faster_than_spinup() {
+  for (const RampTimes& ramp : g_ramps) {
+    TEST_ASSERT_TRUE_MESSAGE(ramp.spindown_ms >= ramp.spinup_ms, ramp.name);
+  }
+}
+
+// Same ramp time at other loop periods and with a jittery loop
+static void test_independent_of_loop_rate() {
+  static const uint8_t periods[] = { 5, 10, 20 };
+  use_profile(g_ramps[DRIVE_MODE_NORMAL]);
+  for (uint8_t jitter = 0; jitter <= 3; jitter += 3) {
+    for (uint8_t period : periods) {
+      g_jitter_ms = (jitter < period) ? jitter : 0;
+      start_armed(period);
+      check_time("Normal spin-up", time_to(Q12_ONE, WEAPON_ESC_MAX_US, period), NORMAL_WEAPON_SPINUP_MS, period);
+      check_time("Normal spin-down", time_to(0, WEAPON_ESC_MIN_US, period), NORMAL_WEAPON_SPINDOWN_MS, period);
+    }
+  }
+}
+
+// Disarming mid-spin ramps down at the spin-down rate, not a cut
+static void test_disarm_ramps_down() {
+  use_profile(g_ramps[DRIVE_MODE_NORMAL]);
+  start_armed(LOOP_PERIOD_MS);
+  time_to(Q12_ONE, WEAPON_ESC_MAX_US, LOOP_PERIOD_MS);
+
+  g_state.input.arm_switch = false;
+  uint32_t start = g_now_ms;
+  uint16_t last_us = g_state.output.weapon_us;
+  while (g_state.output.weapon_us != WEAPON_ESC_MIN_US && g_now_ms - start < 10000) {
+    tick(LOOP_PERIOD_MS);
+    TEST_ASSERT_TRUE_MESSAGE(g_state.output.weapon_us <= last_us, "output rose after disarm");
+    last_us = g_state.output.weapon_us;
+  }
+  TEST_ASSERT_EQUAL(DISARMED, g_state.safety.arm_state);
+  check_time("Normal disarm spin-down", g_now_ms - start, NORMAL_WEAPON_SPINDOWN_MS, LOOP_PERIOD_MS);
+}
+
+// Low battery stretches the spin-up only
+static void test_low_battery_spinup() {
+  use_profile(g_ramps[DRIVE_MODE_NORMAL]);
+  start_armed(LOOP_PERIOD_MS);
+  g_state.battery.last_telemetry_ms = g_now_ms;
+  g_state.battery.percentage = WEAPON_LOWBAT_PCT - 1;
+  check_time("Normal spin-up, low battery", time_to(Q12_ONE, WEAPON_ESC_MAX_US, LOOP_PERIOD_MS),
+             NORMAL_WEAPON_SPINUP_MS * WEAPON_LOWBAT_RAMP_PCT / 100, LOOP_PERIOD_MS);
+  check_time("Normal spin-down, low battery", time_to(0, WEAPON_ESC_MIN_US, LOOP_PERIOD_MS),
+             NORMAL_WEAPON_SPINDOWN_MS, LOOP_PERIOD_MS);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_profile_ramp_times);
+  RUN_TEST(test_spindown_not_faster_than_spinup);
+  RUN_TEST(test_independent_of_loop_rate);
+  RUN_TEST(test_disarm_ramps_down);
+  RUN_TEST(test_low_battery_spinup);
+  return UNITY_END();
+}
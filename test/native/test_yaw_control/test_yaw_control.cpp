@@ -0,0 +1,175 @@
+// test_yaw_control.cpp - Yaw-rate PI closed around the simulated chassis
+// UpVote Battlebot - Phase 8
+//
+// The controller runs against gyro_sim.cpp (first-order chassis with a
+// constant drift and a periodic hit). A stand-in mixer turns the rotation
+// term into wheel duties the way the rotation column of the matrix does,
+// and the sim reads them back next tick, as on the robot. Each case is run
+// closed and open loop so the report shows what the gyro buys.
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define GYRO_BACKEND  2   // GYRO_BACKEND_SIM (config.h only sets a default)
+
+#include "yaw_control.cpp"
+#include "gyro_sim.cpp"
+#include "state.cpp"
+#include "utilities.cpp"
+
+// ============================================================================
+// CLOSED LOOP
+// ============================================================================
+
+#define TICKS_PER_S     (1000 / LOOP_PERIOD_MS)
+#define HIT_TICKS       (GYRO_SIM_HIT_PERIOD_MS / LOOP_PERIOD_MS)
+#define DRIFT_Q12       Q12_FROM_FLOAT(GYRO_SIM_DRIFT)
+
+static bool g_closed;   // Gyro in the loop (else the command goes straight out)
+
+// One control tick: sensor, controller, rotation onto the wheels
+static int16_t tick(int16_t rate_cmd_q12) {
+  gyro_update();
+  int16_t r = g_closed ? yaw_control_update(rate_cmd_q12, true) : rate_cmd_q12;
+
+  int16_t duty = (int16_t)(((int32_t)r * MOTOR_PWM_MAX) >> Q12_SHIFT);
+  g_state.output.motor_rl_pwm = (g_mixer_matrix[0][2] > 0) ? duty : -duty;
+  g_state.output.motor_rr_pwm = (g_mixer_matrix[1][2] > 0) ? duty : -duty;
+  g_state.output.motor_fl_pwm = (g_mixer_matrix[2][2] > 0) ? duty : -duty;
+  g_state.output.motor_fr_pwm = (g_mixer_matrix[3][2] > 0) ? duty : -duty;
+  return gyro_get_yaw_rate();
+}
+
+static void start(bool closed) {
+  g_closed = closed;
+  gyro_init();
+  yaw_control_init();
+  g_state.output.motor_rl_pwm = 0;
+  g_state.output.motor_rr_pwm = 0;
+  g_state.output.motor_fl_pwm = 0;
+  g_state.output.motor_fr_pwm = 0;
+}
+
+// Mean |rate - command| over a window (Q12)
+static int16_t mean_error(int16_t rate_cmd_q12, uint16_t ticks) {
+  int32_t total = 0;
+  for (uint16_t i = 0; i < ticks; i++) {
+    total += abs(tick(rate_cmd_q12) - rate_cmd_q12);
+  }
+  return (int16_t)(total / ticks);
+}
+
+// Settled error between hits: 1 s to settle, then the next second
+static int16_t settled_error(bool closed, int16_t rate_cmd_q12) {
+  start(closed);
+  for (uint16_t i = 0; i < TICKS_PER_S; i++) tick(rate_cmd_q12);
+  return mean_error(rate_cmd_q12, TICKS_PER_S);
+}
+
+// Ticks from a hit until the rate is back within band of the command
+// (runs up to the first hit after settling)
+static uint16_t hit_recovery_ticks(bool closed, int16_t rate_cmd_q12, int16_t band_q12) {
+  start(closed);
+  for (uint16_t i = 0; i < HIT_TICKS - 1; i++) tick(rate_cmd_q12);
+  tick(rate_cmd_q12);   // Hit lands on this tick
+  for (uint16_t i = 1; i < HIT_TICKS; i++) {
+    if (abs(tick(rate_cmd_q12) - rate_cmd_q12) <= band_q12) return i;
+  }
+  return HIT_TICKS;
+}
+
+static void report(const char* what, int16_t closed_q12, int16_t open_q12) {
+  char line[96];
+  snprintf(line, sizeof(line), "%s: closed %.1f%%, open %.1f%% of full rate",
+           what, closed_q12 * 100.0 / Q12_ONE, open_q12 * 100.0 / Q12_ONE);
+  TEST_MESSAGE(line);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+// Straight driving: the drift would turn the robot, the loop holds heading
+static void test_rejects_drift() {
+  int16_t closed = settled_error(true, 0);
+  int16_t open = settled_error(false, 0);
+  report("Drift, yaw stick centered", closed, open);
+  TEST_ASSERT_INT_WITHIN(DRIFT_Q12 / 2, DRIFT_Q12, open);   // Sim does drift
+  TEST_ASSERT_LESS_THAN(DRIFT_Q12 / 10, closed);
+}
+
+// Commanded turn rates are met despite the drift
+static void test_tracks_rate_command() {
+  static const int16_t commands[] = { Q12_ONE / 4, -Q12_ONE / 4, Q12_ONE / 2, -Q12_ONE / 2 };
+  for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+    int16_t closed = settled_error(true, commands[i]);
+    int16_t open = settled_error(false, commands[i]);
+    char what[48];
+    snprintf(what, sizeof(what), "Rate command %d", commands[i]);
+    report(what, closed, open);
+    TEST_ASSERT_LESS_THAN(DRIFT_Q12 / 10, closed);
+  }
+}
+
+// A hit is trimmed out faster than the chassis settles on its own
+static void test_recovers_from_hit() {
+  const int16_t band = Q12_ONE / 20;   // 5% of full rate
+  uint16_t closed = hit_recovery_ticks(true, 0, band);
+  uint16_t open = hit_recovery_ticks(false, 0, band);
+  char line[80];
+  snprintf(line, sizeof(line), "Hit recovery to 5%%: closed %u ms, open %s",
+           closed * LOOP_PERIOD_MS, open >= HIT_TICKS ? "never (drift)" : "in time");
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_THAN(open, closed);
+  TEST_ASSERT_LESS_OR_EQUAL(300 / LOOP_PERIOD_MS, closed);
+}
+
+// Ticks after releasing a full-rate turn until the rate stays within 5%
+// (both phases end before the first hit)
+static uint16_t stop_ticks(bool closed) {
+  start(closed);
+  for (uint16_t i = 0; i < TICKS_PER_S; i++) tick(-Q12_ONE);
+
+  uint16_t ticks = 0;
+  for (uint16_t i = 1; i <= TICKS_PER_S; i++) {
+    if (abs(tick(0)) > Q12_ONE / 20) ticks = i;
+  }
+  return ticks;
+}
+
+// Full command against the drift saturates the output and winds the
+// integral up; the clamp must let the turn stop promptly on release
+static void test_integral_clamped_in_saturation() {
+  uint16_t closed = stop_ticks(true);
+  TEST_ASSERT_INT_WITHIN(YAW_I_LIMIT_Q12, 0, g_integral);
+  uint16_t open = stop_ticks(false);
+
+  char line[80];
+  snprintf(line, sizeof(line), "Stop after a full-rate turn (to 5%%): closed %u ms, open %s",
+           closed * LOOP_PERIOD_MS, open >= TICKS_PER_S ? "never (drift)" : "in time");
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_OR_EQUAL(400 / LOOP_PERIOD_MS, closed);
+}
+
+// Parked: command passes through, integral cleared
+static void test_parked_is_open_loop() {
+  start(true);
+  for (uint16_t i = 0; i < TICKS_PER_S; i++) tick(0);
+  TEST_ASSERT_NOT_EQUAL(0, g_integral);
+
+  TEST_ASSERT_EQUAL_INT(1234, yaw_control_update(1234, false));
+  TEST_ASSERT_EQUAL_INT(0, g_integral);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_rejects_drift);
+  RUN_TEST(test_tracks_rate_command);
+  RUN_TEST(test_recovers_from_hit);
+  RUN_TEST(test_integral_clamped_in_saturation);
+  RUN_TEST(test_parked_is_open_loop);
+  return UNITY_END();
+}
@@ -0,0 +1,56 @@
+// cycles.h - CPU cycle counting for the on-target test suites
+// UpVote Battlebot - Phase 8
+// Timer1 runs at the CPU clock (no prescaler) while a function under test
+// executes with interrupts masked, so the count is exact in simavr and on
+// the board. Timer1 normally drives the weapon/servo pulses: suites using
+// this must not call pulse_out_init().
+#ifndef TEST_CYCLES_H
+#define TEST_CYCLES_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <unity.h>
+
+#define CYCLES_OVERFLOW  0xFFFFFFFFUL   // Function took 65536 cycles or more
+
+static inline void cycles_init() {
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);      // Normal mode, clk/1
+  TIMSK1 = 0;
+}
+
+static void __attribute__((noinline)) cycles_empty() {
+  __asm__ __volatile__("");
+}
+
+// Raw Timer1 count around one call (interrupts masked)
+// Returns CYCLES_OVERFLOW if the timer wrapped
+static uint32_t __attribute__((noinline)) cycles_raw(void (*fn)()) {
+  uint8_t sreg = SREG;
+  cli();
+  TIFR1 = _BV(TOV1);
+  TCNT1 = 0;
+  fn();
+  uint16_t count = TCNT1;
+  bool overflow = TIFR1 & _BV(TOV1);
+  SREG = sreg;
+  return overflow ? CYCLES_OVERFLOW : count;
+}
+
+// Cycles spent in fn(), the cost of calling an empty function subtracted
+static uint32_t cycles_of(void (*fn)()) {
+  uint32_t overhead = cycles_raw(cycles_empty);
+  uint32_t count = cycles_raw(fn);
+  if (count == CYCLES_OVERFLOW) return CYCLES_OVERFLOW;
+  return (count > overhead) ? count - overhead : 0;
+}
+
+// Print "label: cycles (us at 16 MHz)" as a Unity message
+static void cycles_report(const char* label, uint32_t cycles) {
+  char line[80];
+  snprintf(line, sizeof(line), "%s: %lu cycles (%lu us)", label,
+           (unsigned long)cycles, (unsigned long)(cycles / (F_CPU / 1000000UL)));
+  TEST_MESSAGE(line);
+}
+
+#endif // TEST_CYCLES_H
@@ -0,0 +1,43 @@
+// rc_frame.h - CRSF RC channels frames for the on-target test suites
+// UpVote Battlebot - Phase 8
+// Builds the frame a receiver sends, to be fed through crsf_uart_receive()
+// (the receive interrupt's byte handling) one byte at a time.
+#ifndef TEST_RC_FRAME_H
+#define TEST_RC_FRAME_H
+
+#include <Arduino.h>
+
+#define RC_FRAME_BYTES    26     // Sync, length, type, 22 payload, CRC
+#define RC_CHANNELS       16
+#define RC_RAW_MIN        172    // 988 us
+#define RC_RAW_CENTER     992    // 1500 us
+#define RC_RAW_MAX        1811   // 2012 us
+
+// CRC8 DVB-S2 over type + payload
+static uint8_t rc_frame_crc8(const uint8_t* data, uint8_t length) {
+  uint8_t crc = 0;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t i = 0; i < 8; i++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+// 16 x 11-bit raw channel values (CH1 first), packed LSB first
+static void rc_frame_build(uint8_t* frame, const uint16_t* raw) {
+  frame[0] = 0xC8;
+  frame[1] = 24;
+  frame[2] = 0x16;
+  for (uint8_t i = 3; i < 25; i++) frame[i] = 0;
+  uint16_t bit = 0;
+  for (uint8_t ch = 0; ch < RC_CHANNELS; ch++) {
+    for (uint8_t b = 0; b < 11; b++, bit++) {
+      if (raw[ch] & (1 << b)) frame[3 + bit / 8] |= (uint8_t)(1 << (bit % 8));
+    }
+  }
+  frame[25] = rc_frame_crc8(&frame[2], 23);
+}
+
+#endif // TEST_RC_FRAME_H
@@ -0,0 +1,70 @@
+// test_dshot_timing.cpp - DShot frame length and the deferred kill frame
+// UpVote Battlebot - Phase 8
+//
+// Runs in the simavr_dshot environment (DShot300 build). Frame lengths are
+// counted with Timer1; the edges themselves go to a VCD trace of PB1 that
+// tools/dshot_trace_check.py checks (bit period, T0H/T1H, CRC):
+//   python3 tools/dshot_trace_check.py .pio/build/simavr_dshot/dshot.vcd --expect 0,48,2047
+#include <Arduino.h>
+#include <unity.h>
+#include "../cycles.h"
+#include "config.h"
+#include "actuators.h"
+#include "dshot.h"
+
+static_assert(WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_DSHOT300, "Build with the simavr_dshot environment");
+
+// 16 bits at 300 kbit/s (the bit loop's last branch is not taken: -1)
+#define BIT_CYCLES     ((F_CPU + 150000UL) / 300000UL)
+#define FRAME_CYCLES   (16 * BIT_CYCLES - 1)
+#define FRAME_SETUP    96    // Throttle scaling, CRC, port reads, call
+
+static void send_stop()      { dshot_update(WEAPON_ESC_MIN_US); }
+static void send_first()     { dshot_update(WEAPON_ESC_MIN_US + 1); }
+static void send_full()      { dshot_update(WEAPON_ESC_MAX_US); }
+
+void setUp() {}
+void tearDown() {}
+
+// Frames for the trace, in --expect order: stop (0), first step (48),
+// full throttle (2047); each must take 16 bit periods plus setup
+static void test_frame_length() {
+  void (*const frames[3])() = { send_stop, send_first, send_full };
+  static const char* const names[3] = { "Stop frame", "Throttle 48 frame", "Throttle 2047 frame" };
+  for (uint8_t i = 0; i < 3; i++) {
+    uint32_t cycles = cycles_of(frames[i]);
+    cycles_report(names[i], cycles);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(FRAME_CYCLES, cycles);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(FRAME_CYCLES + FRAME_SETUP, cycles);
+    delayMicroseconds(100);   // Idle low between frames in the trace
+  }
+}
+
+// The emergency stop runs in the CRSF receive interrupt: no frame there,
+// the owed stop frame goes out from actuators_idle(), once
+static void test_kill_frame_deferred() {
+  uint32_t stop = cycles_of(actuators_emergency_stop);
+  cycles_report("actuators_emergency_stop()", stop);
+  TEST_ASSERT_LESS_THAN_UINT32(FRAME_CYCLES, stop);
+
+  uint32_t idle = cycles_of(actuators_idle);
+  cycles_report("actuators_idle() after a stop", idle);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(FRAME_CYCLES, idle);
+
+  idle = cycles_of(actuators_idle);
+  cycles_report("actuators_idle() with nothing owed", idle);
+  TEST_ASSERT_LESS_THAN_UINT32(FRAME_CYCLES, idle);
+}
+
+void setup() {
+  UNITY_BEGIN();
+
+  actuators_init();
+  cycles_init();   // After actuators_init(): Timer1 taken over from pulse_out
+
+  RUN_TEST(test_frame_length);
+  RUN_TEST(test_kill_frame_deferred);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,106 @@
+// test_kill_latency.cpp - Kill path time in the CRSF receive interrupt
+// UpVote Battlebot - Phase 8
+//
+// Feeds RC frames through the receive interrupt's byte handling one by one,
+// the CRC byte arriving one frame's wire time after the sync byte as on the
+// link. Reports the latency the firmware itself measures (the value logged
+// as e6 on the robot) and the exact cycles of the CRC byte's handling.
+#include <Arduino.h>
+#include <unity.h>
+#include "../cycles.h"
+#include "../rc_frame.h"
+#include "config.h"
+#include "actuators.h"
+#include "crsf_uart.h"
+#include "timebase.h"
+
+static_assert(KILL_FAST_PATH_ENABLED, "Kill fast path is off in config.h");
+
+#define KILL_LATENCY_MAX_US  50   // Far below one 4 ms receiver frame
+
+static uint8_t g_frame[RC_FRAME_BYTES];
+
+// RC channels frame with every channel centred, CH3 as given
+static void build_frame(uint16_t ch3_raw) {
+  uint16_t raw[RC_CHANNELS];
+  for (uint8_t ch = 0; ch < RC_CHANNELS; ch++) raw[ch] = RC_RAW_CENTER;
+  raw[2] = ch3_raw;
+  rc_frame_build(g_frame, raw);
+}
+
+// Wire time of the 25 bytes after sync at the UART's current rate
+static uint16_t frame_tail_us() {
+  return (uint16_t)((25UL * 10 * 8 * (UBRR0 + 1)) / (F_CPU / 1000000UL));
+}
+
+// Everything up to the CRC byte, then wait out the rest of the frame
+static void feed_frame_head() {
+  cli();
+  crsf_uart_receive(g_frame[0]);
+  sei();
+  uint32_t sync_us = timebase_micros();
+  cli();
+  for (uint8_t i = 1; i < RC_FRAME_BYTES - 1; i++) crsf_uart_receive(g_frame[i]);
+  sei();
+  while (timebase_micros() - sync_us < frame_tail_us()) {
+    // CRC byte still on the wire
+  }
+}
+
+static void feed_crc() {
+  crsf_uart_receive(g_frame[RC_FRAME_BYTES - 1]);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// A normal frame: CRC check only, nothing stopped
+static void test_run_frame() {
+  build_frame(RC_RAW_MAX);
+  feed_frame_head();
+  uint32_t cycles = cycles_of(feed_crc);
+  cycles_report("CRC byte, run frame", cycles);
+  TEST_ASSERT_FALSE(crsf_uart_kill_active());
+  TEST_ASSERT_EQUAL_UINT16(0, crsf_uart_get_kill_latency_us());
+}
+
+// The kill frame: outputs safe from the CRC byte, latency within budget
+static void test_kill_frame() {
+  build_frame(RC_RAW_MIN);
+  feed_frame_head();
+  uint32_t cycles = cycles_of(feed_crc);
+  cycles_report("CRC byte, kill frame (emergency stop)", cycles);
+
+  uint16_t latency = crsf_uart_get_kill_latency_us();
+  char line[48];
+  snprintf(line, sizeof(line), "Kill latency measured by the firmware: %u us", latency);
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_TRUE(crsf_uart_kill_active());
+  TEST_ASSERT_TRUE(actuators_take_stop_event());
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(KILL_LATENCY_MAX_US * (F_CPU / 1000000UL), cycles);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT16(KILL_LATENCY_MAX_US, latency);
+}
+
+// Kill held: no second emergency stop per frame
+static void test_kill_held() {
+  build_frame(RC_RAW_MIN);
+  feed_frame_head();
+  uint32_t cycles = cycles_of(feed_crc);
+  cycles_report("CRC byte, kill held", cycles);
+  TEST_ASSERT_FALSE(actuators_take_stop_event());
+}
+
+void setup() {
+  UNITY_BEGIN();
+
+  actuators_init();  // Timer0 at the PWM prescaler: timebase_micros() in 0.5 us steps
+  cycles_init();     // After actuators_init(): Timer1 taken over from pulse_out
+
+  RUN_TEST(test_run_frame);
+  RUN_TEST(test_kill_frame);
+  RUN_TEST(test_kill_held);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,174 @@
+// test_mixing_cycles.cpp - Cycles per mixing_update(), Q12 vs float path
+// UpVote Battlebot - Phase 8
+//
+// The firmware's mixing.cpp (built with MIXING_FIXED_POINT as configured)
+// is measured against a second copy compiled here with the float path.
+// A third copy runs each mixer policy's pipeline, next to the function
+// before policies existed (mixing_baseline.inc).
+// Each stick position is held until motion shaping settles, then one call
+// is timed. Prints worst and mean cycles per drive mode.
+#include <Arduino.h>
+#include <unity.h>
+#include "../cycles.h"
+
+// Everything mixing.cpp includes, so the copy below only adds its own code
+#include "mixing.h"
+#include "config.h"
+#include "state.h"
+#include "actuators.h"
+#include "utilities.h"
+#include "curves.h"
+#include "profiles.h"
+#include "mixer_presets.h"
+#include "mixer_policies.h"
+#include "yaw_control.h"
+#include "speed_control.h"
+#include "servo.h"
+#include "thermal.h"
+#include "motor_comp.h"
+
+// Path the firmware copy was built with (the copy below changes the macro)
+#if MIXING_FIXED_POINT
+#define FIRMWARE_FIXED_POINT  1
+#else
+#define FIRMWARE_FIXED_POINT  0
+#endif
+
+namespace float_path {
+#undef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT 0
+#include "mixing.cpp"
+}
+
+namespace policy_path {
+#undef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT 1
+#include "mixing.cpp"
+}
+
+namespace baseline {
+#undef MIXING_FIXED_POINT
+#define MIXING_FIXED_POINT 1
+#include "mixing_baseline.inc"
+}
+
+// Stick positions [roll, pitch, yaw, left Y]: rest, translation, rotation
+// and saturating combinations (the normalization/desaturation paths)
+static const int16_t g_positions[][4] = {
+  {  992,  992,  992,  992 },
+  {  992, 1811,  992, 1811 },
+  { 1811, 1811,  992,  992 },
+  {  992,  992, 1811,  172 },
+  { 1811, 1811, 1811, 1811 },
+  {  172, 1811,  172,  172 },
+  { 1400,  600, 1200, 1500 },
+};
+#define POSITION_COUNT  (sizeof(g_positions) / sizeof(g_positions[0]))
+#define SETTLE_CALLS    100    // Longer than any profile's ramp (1 s)
+
+static void run_fixed() { mixing_update(); }
+static void run_float() { float_path::mixing_update(); }
+static void run_holonomic() { policy_path::mixing_pipeline<HolonomicMixer>(); }
+static void run_tank()      { policy_path::mixing_pipeline<TankStrafeMixer>(); }
+static void run_arcade()    { policy_path::mixing_pipeline<ArcadeMixer>(); }
+static void run_baseline()  { baseline::mixing_update(); }
+
+// A policy may cost its own stick arithmetic over holonomic, nothing more
+// (no dispatch or strategy branches in the tick)
+#define POLICY_MARGIN_CYCLES  64
+
+// Worst and mean cycles of one pipeline over all positions in a mode
+static void measure(void (*run)(), void (*set_mode)(DriveMode), DriveMode mode,
+                    uint32_t* worst, uint32_t* mean) {
+  set_mode(mode);
+  *worst = 0;
+  uint32_t total = 0;
+  for (uint8_t p = 0; p < POSITION_COUNT; p++) {
+    g_state.input.raw_channels[0] = g_positions[p][0];
+    g_state.input.raw_channels[1] = g_positions[p][1];
+    g_state.input.raw_channels[3] = g_positions[p][2];
+    g_state.input.raw_channels[8] = g_positions[p][3];
+    for (uint8_t i = 0; i < SETTLE_CALLS; i++) run();
+
+    uint32_t cycles = cycles_of(run);
+    TEST_ASSERT_TRUE(cycles != CYCLES_OVERFLOW);
+    if (cycles > *worst) *worst = cycles;
+    total += cycles;
+  }
+  *mean = total / POSITION_COUNT;
+}
+
+static void compare_mode(DriveMode mode, const char* name) {
+  uint32_t fixed_worst, fixed_mean, float_worst, float_mean;
+  measure(run_fixed, mixing_set_drive_mode, mode, &fixed_worst, &fixed_mean);
+  measure(run_float, float_path::mixing_set_drive_mode, mode, &float_worst, &float_mean);
+
+  char label[48];
+  snprintf(label, sizeof(label), "%s Q12 worst", name);
+  cycles_report(label, fixed_worst);
+  snprintf(label, sizeof(label), "%s Q12 mean", name);
+  cycles_report(label, fixed_mean);
+  snprintf(label, sizeof(label), "%s float worst", name);
+  cycles_report(label, float_worst);
+  snprintf(label, sizeof(label), "%s float mean", name);
+  cycles_report(label, float_mean);
+
+  // The Q12 path exists to be cheaper than the float one
+  TEST_ASSERT_TRUE_MESSAGE(FIRMWARE_FIXED_POINT, "Build with MIXING_FIXED_POINT 1 to compare");
+  TEST_ASSERT_LESS_THAN_UINT32(float_worst, fixed_worst);
+}
+
+// Each policy's pipeline and the pre-policy function in one mode
+// The baseline predates rotation sensitivity, the self-right drive kick,
+// yaw and wheel speed control, so the policies carry those stages too
+static void compare_policies(DriveMode mode, const char* name) {
+  uint32_t worst[4], mean[4];
+  measure(run_baseline, baseline::mixing_set_drive_mode, mode, &worst[0], &mean[0]);
+  measure(run_holonomic, policy_path::mixing_set_drive_mode, mode, &worst[1], &mean[1]);
+  measure(run_tank, policy_path::mixing_set_drive_mode, mode, &worst[2], &mean[2]);
+  measure(run_arcade, policy_path::mixing_set_drive_mode, mode, &worst[3], &mean[3]);
+
+  static const char* const names[4] = { "pre-policy", "holonomic", "tank-strafe", "arcade" };
+  char label[48];
+  for (uint8_t i = 0; i < 4; i++) {
+    snprintf(label, sizeof(label), "%s %s worst", name, names[i]);
+    cycles_report(label, worst[i]);
+    snprintf(label, sizeof(label), "%s %s mean", name, names[i]);
+    cycles_report(label, mean[i]);
+  }
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(worst[1] + POLICY_MARGIN_CYCLES, worst[2]);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(worst[1] + POLICY_MARGIN_CYCLES, worst[3]);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_beginner()   { compare_mode(DRIVE_MODE_BEGINNER, "Beginner"); }
+static void test_normal()     { compare_mode(DRIVE_MODE_NORMAL, "Normal"); }
+static void test_aggressive() { compare_mode(DRIVE_MODE_AGGRESSIVE, "Aggressive"); }
+static void test_policies_normal()     { compare_policies(DRIVE_MODE_NORMAL, "Normal"); }
+static void test_policies_aggressive() { compare_policies(DRIVE_MODE_AGGRESSIVE, "Aggressive"); }
+
+void setup() {
+  UNITY_BEGIN();
+
+  // Modules the mixer writes through (same order as main.cpp)
+  thermal_init();
+  motor_comp_init();
+  profiles_init();
+  mixing_init();
+  float_path::mixing_init();
+  policy_path::mixing_init();
+  baseline::mixing_init();
+  cycles_init();
+
+  RUN_TEST(test_beginner);
+  RUN_TEST(test_normal);
+  RUN_TEST(test_aggressive);
+  RUN_TEST(test_policies_normal);
+  RUN_TEST(test_policies_aggressive);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,120 @@
+// test_motor_cycles.cpp - Drive motor output per tick, direct port vs AFMotor
+// UpVote Battlebot - Phase 8
+//
+// Times update_motors() (a copy of actuators.cpp compiled here, so the
+// static function can be called) against the AFMotor path it replaced
+// (afmotor_baseline.inc), on the same wheel commands. Changed ticks move
+// every duty and flip directions, so the direct-port driver has to latch;
+// unchanged ticks repeat the last command, where it writes nothing.
+// Both paths feed the thermal model, which is kept cool.
+#include <Arduino.h>
+#include <unity.h>
+#include <util/atomic.h>
+#include "../cycles.h"
+
+// Everything actuators.cpp includes, so the copy below only adds its own code
+#include "actuators.h"
+#include "config.h"
+#include "state.h"
+#include "thermal.h"
+#include "motor_comp.h"
+#include "motor_driver.h"
+#include "pulse_out.h"
+#include "dshot.h"
+#include "profiles.h"
+#include "mixing.h"
+#include "crsf_uart.h"
+
+namespace drive {
+#include "actuators.cpp"
+}
+
+namespace baseline {
+#include "afmotor_baseline.inc"
+}
+
+#define SPEEDUP_MIN  10      // The replacement was for an order of magnitude
+
+// Wheel commands [RL, RR, FL, FR]; alternating them changes every duty
+// and the direction of two wheels each tick
+static const int16_t g_commands[2][4] = {
+  {  200, -150,  100,  -50 },
+  {  120,  150, -100,  -60 },
+};
+#define TICKS         20
+#define SETTLE_TICKS  100    // Longer than the reversal brake and ramp
+
+static void set_commands(const int16_t* command) {
+  g_state.output.motor_rl_pwm = command[0];
+  g_state.output.motor_rr_pwm = command[1];
+  g_state.output.motor_fl_pwm = command[2];
+  g_state.output.motor_fr_pwm = command[3];
+}
+
+static void run_direct()  { drive::update_motors(); }
+static void run_afmotor() { baseline::update_afmotor_motors(); }
+
+// Worst cycles over TICKS ticks, commands alternating or held
+// Held commands are run until the reversal ramp has settled first; the
+// thermal model is reset before each tick so neither path derates
+static uint32_t measure(void (*run)(), bool changing) {
+  set_commands(g_commands[changing ? 1 : 0]);
+  for (uint8_t n = 0; n < SETTLE_TICKS; n++) {
+    thermal_init();
+    run();
+  }
+  uint32_t worst = 0;
+  for (uint8_t n = 0; n < TICKS; n++) {
+    set_commands(g_commands[changing ? (n & 1) : 0]);
+    thermal_init();
+    uint32_t cycles = cycles_of(run);
+    TEST_ASSERT_TRUE(cycles != CYCLES_OVERFLOW);
+    if (cycles > worst) worst = cycles;
+  }
+  return worst;
+}
+
+static void compare(bool changing) {
+  uint32_t direct = measure(run_direct, changing);
+  uint32_t afmotor = measure(run_afmotor, changing);
+
+  const char* tick = changing ? "changed" : "unchanged";
+  char label[48];
+  snprintf(label, sizeof(label), "AFMotor, %s tick", tick);
+  cycles_report(label, afmotor);
+  snprintf(label, sizeof(label), "Direct port, %s tick", tick);
+  cycles_report(label, direct);
+  snprintf(label, sizeof(label), "Speed-up, %s tick: %lu.%lux", tick,
+           (unsigned long)(afmotor / direct), (unsigned long)(afmotor * 10 / direct % 10));
+  TEST_MESSAGE(label);
+
+  TEST_ASSERT_TRUE_MESSAGE(afmotor >= direct * SPEEDUP_MIN, "Less than 10x faster than AFMotor");
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_changed_tick()   { compare(true); }
+static void test_unchanged_tick() { compare(false); }
+
+void setup() {
+  UNITY_BEGIN();
+
+  // Modules update_motors() reads (same order as main.cpp), then the
+  // shield pins for the AFMotor path
+  drive::actuators_init();
+  thermal_init();
+  motor_comp_init();
+  profiles_init();
+  mixing_init();
+  pinMode(MOTORLATCH, OUTPUT);
+  pinMode(MOTORCLK, OUTPUT);
+  pinMode(MOTORDATA, OUTPUT);
+  cycles_init();     // After actuators_init(): Timer1 is ours from here
+
+  RUN_TEST(test_changed_tick);
+  RUN_TEST(test_unchanged_tick);
+  UNITY_END();
+}
+
+void loop() {}
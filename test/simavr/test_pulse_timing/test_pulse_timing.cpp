@@ -0,0 +1,123 @@
+// test_pulse_timing.cpp - OneShot125/Multishot weapon pulses and servo interleave
+// UpVote Battlebot - Phase 8
+//
+// Runs in the simavr_oneshot and simavr_multishot environments. Weapon
+// pulse widths are measured here against Timer1; the full picture goes to
+// a VCD trace of PB1 (weapon), PB2 (servo) and PB5 (marker, high around
+// each pulse_out_write()) that tools/pulse_trace_check.py checks: widths,
+// 400 Hz framing, the 50 Hz servo pulse every 8th frame clear of the weapon
+// pulse, and the frame restart latency after each write:
+//   python3 tools/pulse_trace_check.py .pio/build/simavr_oneshot/pulse.vcd --protocol oneshot125 --expect 1000,1500,2000
+//   python3 tools/pulse_trace_check.py .pio/build/simavr_multishot/pulse.vcd --protocol multishot --expect 1000,1500,2000
+#include <Arduino.h>
+#include <unity.h>
+#include <util/atomic.h>
+#include "config.h"
+#include "pulse_out.h"
+
+static_assert(WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_ONESHOT125 ||
+              WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_MULTISHOT,
+              "Build with the simavr_oneshot or simavr_multishot environment");
+
+#define FRAME_TICKS    (F_CPU / PULSE_FAST_HZ)       // Prescaler 1
+#define FRAME_US       (1000000UL / PULSE_FAST_HZ)
+#define WIDTH_SLACK    8      // Ticks: polling loop and the TCNT1 read
+#define RESTART_TICKS  32     // TCNT1 just after a write that restarted the frame
+#define WRITES         16
+
+// Nominal weapon width (ticks) per the protocol, not pulse_out.cpp's shortcut
+#if WEAPON_ESC_PROTOCOL == ESC_PROTOCOL_ONESHOT125
+#define NOMINAL_TICKS(us)  ((uint32_t)(us) * 16 / 8)                       // us / 8
+#else
+#define NOMINAL_TICKS(us)  (16UL * 5 + ((uint32_t)(us) - 1000) * 16 / 50)  // 5 + (us - 1000) / 50
+#endif
+
+// Write with the trace marker (PB5, D13) high around it
+static void marked_write(uint16_t weapon_us) {
+  PORTB |= _BV(PB5);
+  pulse_out_write(weapon_us, SAFE_SERVO_US);
+  PORTB &= ~_BV(PB5);
+}
+
+static uint16_t read_tcnt1() {
+  uint16_t now;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { now = TCNT1; }
+  return now;
+}
+
+// Width of the next weapon pulse in ticks. It starts at BOTTOM, so TCNT1
+// when it ends is its width. Interrupts off so the frame-end interrupt
+// cannot delay the poll (it runs right after, well before the next BOTTOM)
+static uint16_t next_pulse_ticks() {
+  uint16_t ticks;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    while (PINB & _BV(PB1)) {}
+    while (!(PINB & _BV(PB1))) {}
+    while (PINB & _BV(PB1)) {}
+    ticks = TCNT1;
+  }
+  return ticks;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Timer1 frame: 400 Hz at prescaler 1
+static void test_frame_rate() {
+  TEST_ASSERT_EQUAL_UINT32(FRAME_TICKS - 1, ICR1);
+  TEST_ASSERT_EQUAL_HEX8(_BV(CS10), TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10)));
+}
+
+// Stop, half and full throttle, in --expect order: each held for two servo
+// periods in the trace, width as the protocol defines it (one tick over:
+// fast PWM holds the pin through the compare match)
+static void test_widths() {
+  static const uint16_t throttle_us[3] = { WEAPON_ESC_MIN_US, 1500, WEAPON_ESC_MAX_US };
+  for (uint8_t i = 0; i < 3; i++) {
+    marked_write(throttle_us[i]);
+    delayMicroseconds(2 * FRAME_US);   // Applied by the next frame at the latest
+    uint16_t ticks = next_pulse_ticks();
+
+    char line[48];
+    snprintf(line, sizeof(line), "%u us throttle: %u ticks (%lu nominal)",
+             throttle_us[i], ticks, (unsigned long)NOMINAL_TICKS(throttle_us[i]));
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(NOMINAL_TICKS(throttle_us[i]), ticks);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(NOMINAL_TICKS(throttle_us[i]) + WIDTH_SLACK, ticks);
+    delay(40);
+  }
+}
+
+// Writes mid-frame restart it (TCNT1 wraps at once) except in a servo
+// frame, one in PULSE_FAST_HZ / PULSE_OUT_HZ; the trace checker holds each
+// write that did not restart to a servo frame
+static void test_restart() {
+  uint8_t restarts = 0;
+  for (uint8_t i = 0; i < WRITES; i++) {
+    delayMicroseconds(FRAME_US + (i % 3) * FRAME_US);   // Vary the frame phase
+    while (read_tcnt1() < FRAME_TICKS / 2) {}
+    marked_write(i & 1 ? 1750 : 1250);
+    if (read_tcnt1() < RESTART_TICKS) restarts++;
+  }
+  char line[48];
+  snprintf(line, sizeof(line), "Restarted on write: %u of %u", restarts, WRITES);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT8(WRITES / 2, restarts);
+  delay(40);
+}
+
+void setup() {
+  UNITY_BEGIN();
+
+  pulse_out_init();   // Timer1 stays with pulse_out: no cycles.h here
+  DDRB |= _BV(PB5);
+  PORTB &= ~_BV(PB5);
+  delay(40);          // Safe widths in the trace before the first marker
+
+  RUN_TEST(test_frame_rate);
+  RUN_TEST(test_widths);
+  RUN_TEST(test_restart);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,201 @@
+// test_ram_budget.cpp - Worst-case RAM use of the whole firmware
+// UpVote Battlebot - Phase 8
+//
+// Boots every module as main.cpp does and runs its control loop body at
+// 100 Hz on RC frames fed through the receive interrupt's byte handling:
+// armed full-stick driving with the weapon up and a self-right, both dump
+// gestures (error history and black box over telemetry), then a link loss.
+// The stack canary scan (diagnostics_idle) then gives the deepest stack,
+// and the peak - static data (black box ring, UART and error-log buffers
+// included) + heap + stack - must stay within RAM_BUDGET_BYTES.
+// The suite's own statics (Unity, this file) count too, so the firmware
+// alone uses slightly less than reported.
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/wdt.h>
+#include <util/atomic.h>
+#include "../rc_frame.h"
+#include "config.h"
+#include "state.h"
+#include "safety.h"
+#include "actuators.h"
+#include "diagnostics.h"
+#include "input.h"
+#include "mixing.h"
+#include "weapon.h"
+#include "servo.h"
+#include "thermal.h"
+#include "motor_comp.h"
+#include "gyro.h"
+#include "encoders.h"
+#include "weapon_rpm.h"
+#include "profiles.h"
+#include "timebase.h"
+#include "error_log.h"
+#include "blackbox.h"
+#include "crsf_uart.h"
+
+extern uint8_t __heap_start;
+
+#define UART_BUFFER_BYTES   (64 + 64)   // crsf_uart.cpp receive + transmit rings
+#define STATIC_BUFFERS      (BLACKBOX_BUFFER_BYTES + UART_BUFFER_BYTES + \
+                             ERROR_LOG_RAM_EVENTS * sizeof(ErrorEvent))
+
+static uint16_t g_raw[RC_CHANNELS];
+static uint32_t g_next_tick_us;
+
+// ============================================================================
+// FIRMWARE LOOP
+// ============================================================================
+
+// setup() of main.cpp
+static void firmware_init() {
+  actuators_init();
+  error_log_init();
+  safety_init();
+  diagnostics_init();
+  input_init();
+  thermal_init();
+  motor_comp_init();
+  profiles_init();
+  gyro_init();
+  encoders_init();
+  mixing_init();
+  weapon_rpm_init();
+  weapon_init();
+  servo_init();
+  blackbox_init();
+}
+
+// Control loop body of main.cpp's loop()
+static void firmware_tick() {
+  safety_watchdog_reset();
+  input_update();
+  profiles_update();
+  error_log_update();
+  input_update_telemetry();
+  gyro_update();
+  encoders_update();
+  servo_update();
+  if (g_state.input.link_ok && !g_state.input.kill_switch) {
+    if (motor_comp_calibrating()) {
+      motor_comp_calibration_update();
+    } else {
+      mixing_update();
+    }
+  } else {
+    mixing_stop();
+    motor_comp_calibration_hold();
+  }
+  weapon_rpm_update();
+  weapon_update();
+  actuators_update();
+  diagnostics_update();
+  blackbox_update();
+}
+
+// Idle work between ticks, as main.cpp's loop()
+static void firmware_idle() {
+  actuators_idle();
+  profiles_idle();
+  error_log_idle();
+  motor_comp_idle();
+  diagnostics_idle();
+}
+
+// Ticks at 100 Hz, one RC frame from g_raw per tick (none if !link)
+// stick: called before each tick to move the sticks (may be NULL)
+static void run(uint16_t ticks, bool link, void (*stick)(uint16_t)) {
+  uint8_t frame[RC_FRAME_BYTES];
+  for (uint16_t n = 0; n < ticks; n++) {
+    while ((int32_t)(timebase_micros() - g_next_tick_us) < 0) firmware_idle();
+    g_next_tick_us += LOOP_PERIOD_US;
+
+    if (stick) stick(n);
+    if (link) {
+      rc_frame_build(frame, g_raw);
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < RC_FRAME_BYTES; i++) crsf_uart_receive(frame[i]);
+      }
+    }
+    firmware_tick();
+  }
+}
+
+// Sticks sweeping corner to corner, CH9 against CH2 (tank)
+static void sweep(uint16_t n) {
+  static const uint16_t corners[4] = { RC_RAW_MIN, RC_RAW_MAX, RC_RAW_CENTER, RC_RAW_MAX };
+  g_raw[0] = corners[n & 3];
+  g_raw[1] = corners[(n >> 2) & 3];
+  g_raw[3] = corners[(n >> 4) & 3];
+  g_raw[8] = corners[(n + 1) & 3];
+  g_raw[6] = ((n >> 6) & 1) ? RC_RAW_MAX : RC_RAW_MIN;   // Self-right on and off
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+void setUp() {}
+void tearDown() {}
+
+static void test_worst_case_within_budget() {
+  for (uint8_t ch = 0; ch < RC_CHANNELS; ch++) g_raw[ch] = RC_RAW_CENTER;
+  g_raw[2] = RC_RAW_MAX;    // Kill off
+  g_raw[4] = RC_RAW_MIN;    // Weapon slider down
+  g_raw[5] = RC_RAW_MAX;    // Arm
+  g_raw[6] = RC_RAW_MIN;    // Self-right off
+  g_raw[7] = RC_RAW_MAX;    // Aggressive
+  g_next_tick_us = timebase_micros();
+
+  // Arm with the slider down, then drive hard with the weapon up
+  run(50, true, NULL);
+  TEST_ASSERT_EQUAL(ARMED, g_state.safety.arm_state);
+  g_raw[4] = RC_RAW_MAX;
+  run(300, true, sweep);
+
+  // Kill, yaw and roll held fully left: error history and black-box dumps
+  g_raw[2] = RC_RAW_MIN;
+  g_raw[0] = RC_RAW_MIN;
+  g_raw[1] = RC_RAW_CENTER;
+  g_raw[3] = RC_RAW_MIN;
+  g_raw[6] = RC_RAW_MIN;
+  run(300, true, NULL);
+
+  // Link loss (failsafe freezes the black box)
+  run(100, false, NULL);
+
+  // Telemetry shares the UART with this report: end its last frame's line
+  wdt_disable();
+  CrsfSerial.flush();
+  CrsfSerial.write('\n');
+
+  // One full canary pass after the run
+  for (uint16_t i = 0; i < 4 * (RAMEND + 1 - RAMSTART) / STACK_SCAN_CHUNK; i++) diagnostics_idle();
+
+  uint16_t static_bytes = (uint16_t)(&__heap_start - (uint8_t*)RAMSTART);
+  uint16_t peak = diagnostics_get_ram_peak();
+  uint16_t headroom = diagnostics_get_stack_headroom();
+  char line[96];
+  snprintf(line, sizeof(line), "Static data: %u bytes (black box %u, UART %u, error log %u)",
+           static_bytes, BLACKBOX_BUFFER_BYTES, UART_BUFFER_BYTES,
+           (unsigned)(ERROR_LOG_RAM_EVENTS * sizeof(ErrorEvent)));
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "Deepest stack: %u bytes", peak - static_bytes);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "Worst-case use: %u of %u bytes budget (PHASE7 %u), free %u",
+           peak, RAM_BUDGET_BYTES, PHASE7_RAM_BUDGET_BYTES, headroom);
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT16(STATIC_BUFFERS, static_bytes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT16(RAM_BUDGET_BYTES, peak);
+}
+
+void setup() {
+  UNITY_BEGIN();
+  firmware_init();
+  RUN_TEST(test_worst_case_within_budget);
+  UNITY_END();
+}
+
+void loop() {}
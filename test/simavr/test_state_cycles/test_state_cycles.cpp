@@ -0,0 +1,213 @@
+// test_state_cycles.cpp - Compact RuntimeState vs the layout before Phase 8
+// UpVote Battlebot - Phase 8
+//
+// Prints sizeof(RuntimeState) now and before (state_baseline.inc) as
+// avr-gcc lays them out, and times the per-tick accesses that changed with
+// the compact layout, each against its old version: the weapon throttle
+// from CH5 (Q12 vs float divide), switch debouncing (bitfields through the
+// returned state vs bools through pointers), the arming throttle
+// hysteresis (Q12 vs float compares) and the weapon ramp target (Q12
+// multiply vs float multiply and conversion).
+#include <Arduino.h>
+#include <unity.h>
+#include "../cycles.h"
+#include "config.h"
+#include "state.h"
+#include "utilities.h"
+
+// As weapon.cpp
+#define WEAPON_RAMP_SHIFT   4
+#define WEAPON_RAMP_RANGE   ((int16_t)(WEAPON_ESC_MAX_US - WEAPON_ESC_MIN_US) << WEAPON_RAMP_SHIFT)
+#define ARM_THROTTLE_Q12    Q12_FROM_FLOAT(ARM_THROTTLE_THRESHOLD)
+#define REARM_THROTTLE_Q12  Q12_FROM_FLOAT(REARM_THROTTLE_THRESHOLD)
+
+namespace baseline {
+#include "state_baseline.inc"
+}
+
+// ============================================================================
+// CURRENT LAYOUT (the same lines of input.cpp and weapon.cpp today)
+// ============================================================================
+
+namespace compact {
+
+static void input_weapon(uint16_t ch5_us) {
+  g_state.input.weapon = constrain(map(ch5_us, 988, 2012, 0, Q12_ONE), 0, Q12_ONE);
+}
+
+static void weapon_debounce(uint32_t now) {
+  g_state.safety.arm_switch_debounced =
+      debounce_switch(g_state.input.arm_switch,
+                      g_state.safety.arm_switch_debounced,
+                      &g_state.safety.arm_switch_stable_ms,
+                      SWITCH_DEBOUNCE_MS,
+                      now);
+  g_state.safety.kill_switch_debounced =
+      debounce_switch(g_state.input.kill_switch,
+                      g_state.safety.kill_switch_debounced,
+                      &g_state.safety.kill_switch_stable_ms,
+                      SWITCH_DEBOUNCE_MS,
+                      now);
+}
+
+static bool weapon_can_arm() {
+  bool arm_switch = g_state.safety.arm_switch_debounced;
+  bool kill_active = g_state.safety.kill_switch_debounced;
+  bool link_ok = g_state.input.link_ok;
+  int16_t throttle = g_state.input.weapon;
+  SystemError error = g_state.safety.error;
+
+  if (!arm_switch || kill_active || !link_ok || error != ERR_NONE) {
+    g_state.safety.arm_state = DISARMED;
+    g_state.safety.last_arm_throttle = throttle;
+    return false;
+  }
+
+  bool throttle_ok = false;
+  if (g_state.safety.last_arm_throttle > ARM_THROTTLE_Q12) {
+    if (throttle < REARM_THROTTLE_Q12) {
+      throttle_ok = true;
+      g_state.safety.last_arm_throttle = throttle;
+    }
+  } else {
+    if (throttle <= ARM_THROTTLE_Q12) {
+      throttle_ok = true;
+    }
+  }
+  return throttle_ok;
+}
+
+static int16_t weapon_target() {
+  int16_t target = 0;
+  if (g_state.safety.arm_state == ARMED) {
+    int16_t throttle = constrain(g_state.input.weapon, 0, Q12_ONE);
+    target = (int16_t)(((int32_t)throttle * WEAPON_RAMP_RANGE) >> Q12_SHIFT);
+  }
+  return target;
+}
+
+}  // namespace compact
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+// Inputs read through volatiles so nothing folds to a constant
+static volatile uint16_t g_ch5_us;
+static volatile uint32_t g_now_ms;
+static volatile bool g_sink_bool;
+static volatile int16_t g_sink_target;
+
+static void __attribute__((noinline)) old_input()   { baseline::input_weapon(g_ch5_us); }
+static void __attribute__((noinline)) new_input()   { compact::input_weapon(g_ch5_us); }
+static void __attribute__((noinline)) old_debounce() { baseline::weapon_debounce(g_now_ms); }
+static void __attribute__((noinline)) new_debounce() { compact::weapon_debounce(g_now_ms); }
+static void __attribute__((noinline)) old_arming()  { g_sink_bool = baseline::weapon_can_arm(); }
+static void __attribute__((noinline)) new_arming()  { g_sink_bool = compact::weapon_can_arm(); }
+static void __attribute__((noinline)) old_target()  { g_sink_target = baseline::weapon_target(); }
+static void __attribute__((noinline)) new_target()  { g_sink_target = compact::weapon_target(); }
+
+struct Path {
+  const char* name;
+  void (*before)();
+  void (*after)();
+};
+
+static const Path g_paths[] = {
+  { "CH5 weapon throttle", old_input, new_input },
+  { "Switch debounce", old_debounce, new_debounce },
+  { "Arming hysteresis", old_arming, new_arming },
+  { "Weapon ramp target", old_target, new_target },
+};
+
+// Armed, link up, slider at ch5_us, switches stable or just flipped
+static void set_inputs(uint16_t ch5_us, bool flip) {
+  g_ch5_us = ch5_us;
+  g_now_ms = flip ? 1000 + SWITCH_DEBOUNCE_MS : 1000;
+
+  baseline::g_state.input.arm_switch = true;
+  baseline::g_state.input.kill_switch = flip;
+  baseline::g_state.input.link_ok = true;
+  baseline::g_state.safety.arm_switch_debounced = true;
+  baseline::g_state.safety.kill_switch_debounced = false;
+  baseline::g_state.safety.arm_switch_stable_ms = 1000;
+  baseline::g_state.safety.kill_switch_stable_ms = 1000;
+  baseline::g_state.safety.arm_state = baseline::ARMED;
+  baseline::g_state.safety.error = baseline::ERR_NONE;
+
+  g_state.input.arm_switch = true;
+  g_state.input.kill_switch = flip;
+  g_state.input.link_ok = true;
+  g_state.safety.arm_switch_debounced = true;
+  g_state.safety.kill_switch_debounced = false;
+  g_state.safety.arm_switch_stable_ms = 1000;
+  g_state.safety.kill_switch_stable_ms = 1000;
+  g_state.safety.arm_state = ARMED;
+  g_state.safety.error = ERR_NONE;
+
+  old_input();
+  new_input();
+}
+
+// Worst cycles of each path over slider positions and switch flips
+static void measure(uint32_t* before, uint32_t* after) {
+  static const uint16_t sliders[] = { 988, 1000, 1100, 1500, 2012 };
+  for (uint8_t p = 0; p < sizeof(g_paths) / sizeof(g_paths[0]); p++) {
+    before[p] = 0;
+    after[p] = 0;
+    for (uint16_t ch5_us : sliders) {
+      for (uint8_t flip = 0; flip <= 1; flip++) {
+        set_inputs(ch5_us, flip);
+        uint32_t cycles = cycles_of(g_paths[p].before);
+        if (cycles > before[p]) before[p] = cycles;
+        set_inputs(ch5_us, flip);
+        cycles = cycles_of(g_paths[p].after);
+        if (cycles > after[p]) after[p] = cycles;
+      }
+    }
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Bytes of RuntimeState before and after, as this compiler lays them out
+static void test_state_size() {
+  char line[64];
+  snprintf(line, sizeof(line), "RuntimeState: %u bytes, was %u",
+           (unsigned)sizeof(RuntimeState), (unsigned)sizeof(baseline::RuntimeState));
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_THAN_UINT16(sizeof(baseline::RuntimeState), sizeof(RuntimeState));
+}
+
+// Worst cycles per path and per tick: cheaper overall (a bitfield store
+// costs a read-modify-write, so the debounce alone may not gain)
+static void test_access_cycles() {
+  uint32_t before[4], after[4];
+  measure(before, after);
+
+  uint32_t total_before = 0, total_after = 0;
+  char label[48];
+  for (uint8_t p = 0; p < 4; p++) {
+    snprintf(label, sizeof(label), "%s, before", g_paths[p].name);
+    cycles_report(label, before[p]);
+    snprintf(label, sizeof(label), "%s, after", g_paths[p].name);
+    cycles_report(label, after[p]);
+    TEST_ASSERT_TRUE(before[p] != CYCLES_OVERFLOW && after[p] != CYCLES_OVERFLOW);
+    total_before += before[p];
+    total_after += after[p];
+  }
+  cycles_report("Per tick, before", total_before);
+  cycles_report("Per tick, after", total_after);
+  TEST_ASSERT_LESS_THAN_UINT32(total_before, total_after);
+}
+
+void setup() {
+  UNITY_BEGIN();
+  cycles_init();
+  RUN_TEST(test_state_size);
+  RUN_TEST(test_access_cycles);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,55 @@
+// Arduino.h - Host stand-in for the Arduino core (native tests only)
+// UpVote Battlebot - Phase 8
+// Just enough of the core to compile the control-law modules on the host.
+// Time comes from the test itself: each suite defines timebase_millis()
+// and timebase_micros() (or includes the module it exercises with them).
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
+
+typedef uint8_t byte;
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+static inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+static inline void pinMode(uint8_t, uint8_t) {}
+
+// Stream interface, for headers declaring drivers (no I/O on the host)
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t byte) = 0;
+  size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+#endif // NATIVE_ARDUINO_H
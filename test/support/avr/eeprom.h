@@ -0,0 +1,31 @@
+// avr/eeprom.h - Host stand-in (native tests only): EEPROM held in RAM
+// Starts erased (0xFF) and is always ready, like a fresh part
+#ifndef NATIVE_AVR_EEPROM_H
+#define NATIVE_AVR_EEPROM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+static inline uint8_t* native_eeprom() {
+  static uint8_t cells[1024];
+  static bool erased = false;
+  if (!erased) {
+    memset(cells, 0xFF, sizeof(cells));
+    erased = true;
+  }
+  return cells;
+}
+
+static inline bool eeprom_is_ready() { return true; }
+static inline uint8_t eeprom_read_byte(const uint8_t* addr) { return native_eeprom()[(size_t)addr]; }
+static inline void eeprom_write_byte(uint8_t* addr, uint8_t value) { native_eeprom()[(size_t)addr] = value; }
+static inline void eeprom_update_byte(uint8_t* addr, uint8_t value) { native_eeprom()[(size_t)addr] = value; }
+static inline void eeprom_read_block(void* dst, const void* src, size_t n) {
+  memcpy(dst, native_eeprom() + (size_t)src, n);
+}
+static inline void eeprom_update_block(const void* src, void* dst, size_t n) {
+  memcpy(native_eeprom() + (size_t)dst, src, n);
+}
+
+#endif // NATIVE_AVR_EEPROM_H
@@ -0,0 +1,9 @@
+// avr/interrupt.h - Host stand-in (native tests only): no interrupts
+#ifndef NATIVE_AVR_INTERRUPT_H
+#define NATIVE_AVR_INTERRUPT_H
+
+#define cli()  do {} while (0)
+#define sei()  do {} while (0)
+#define ISR(vector, ...)  void vector(void)
+
+#endif // NATIVE_AVR_INTERRUPT_H
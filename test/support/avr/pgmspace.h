@@ -0,0 +1,16 @@
+// avr/pgmspace.h - Host stand-in (native tests only): flash is plain memory
+#ifndef NATIVE_AVR_PGMSPACE_H
+#define NATIVE_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)            (s)
+#define pgm_read_byte(p)   (*(const uint8_t*)(p))
+#define pgm_read_word(p)   (*(const uint16_t*)(p))
+#define pgm_read_dword(p)  (*(const uint32_t*)(p))
+#define pgm_read_ptr(p)    (*(const void* const*)(p))
+#define memcpy_P           memcpy
+
+#endif // NATIVE_AVR_PGMSPACE_H
@@ -0,0 +1,9 @@
+// util/atomic.h - Host stand-in (native tests only): single-threaded
+#ifndef NATIVE_UTIL_ATOMIC_H
+#define NATIVE_UTIL_ATOMIC_H
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+#define ATOMIC_BLOCK(type)  for (int atomic_once_ = 1; atomic_once_; atomic_once_ = 0)
+
+#endif // NATIVE_UTIL_ATOMIC_H
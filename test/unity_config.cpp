@@ -0,0 +1,34 @@
+// unity_config.cpp - Unity output over the CRSF UART driver (AVR only)
+// UpVote Battlebot - Phase 8
+#ifdef ARDUINO
+
+#include "unity_config.h"
+#include "crsf_uart.h"
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/delay.h>
+
+void unity_output_start(void) {
+  CrsfSerial.begin(420000);   // Same rate as the receiver link (400 kbaud)
+  sei();
+}
+
+void unity_output_char(unsigned int c) {
+  CrsfSerial.write((uint8_t)c);
+}
+
+void unity_output_flush(void) {
+  CrsfSerial.flush();
+}
+
+// Drain the report, then stop: simavr exits when the CPU sleeps with
+// interrupts off, and a real board simply halts
+void unity_output_complete(void) {
+  CrsfSerial.flush();
+  _delay_us(50);               // Last byte leaves the shift register
+  cli();
+  sleep_enable();
+  sleep_cpu();
+}
+
+#endif // ARDUINO
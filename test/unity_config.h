@@ -0,0 +1,31 @@
+// unity_config.h - Unity output for the test environments
+// UpVote Battlebot - Phase 8
+// Native suites use Unity's default (stdout). On the AVR the firmware's
+// CRSF UART driver owns USART0's interrupt vectors, so Serial cannot be
+// linked; results go out through CrsfSerial instead (see unity_config.cpp)
+#ifndef UNITY_CONFIG_H
+#define UNITY_CONFIG_H
+
+#ifdef ARDUINO
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void unity_output_start(void);
+void unity_output_char(unsigned int c);
+void unity_output_flush(void);
+void unity_output_complete(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define UNITY_OUTPUT_START()     unity_output_start()
+#define UNITY_OUTPUT_CHAR(c)     unity_output_char(c)
+#define UNITY_OUTPUT_FLUSH()     unity_output_flush()
+#define UNITY_OUTPUT_COMPLETE()  unity_output_complete()
+
+#endif // ARDUINO
+
+#endif // UNITY_CONFIG_H
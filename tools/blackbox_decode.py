@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""
+Black-box dump decoder for UpVote Arduino BattleBot.
+
+Turns a black-box dump (see src/blackbox.cpp) into CSV, one row per control
+loop tick. The dump is sent as CRSF frames (type 0x7F) on the receiver UART.
+Capture that line with any USB-serial adapter on the Arduino TX pin (D1), or
+the Uno's own USB port. The line runs at 400000 baud, the nearest rate the
+ATmega328P can make of CRSF's 420000.
+
+Usage:
+    blackbox_decode.py capture.bin [-o out.csv]
+    blackbox_decode.py --port /dev/ttyACM0 [-o out.csv]   (needs pyserial)
+
+The capture may contain any other traffic; only valid black-box frames are
+used.
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import sys
+import time
+from typing import Dict, Iterator, List, Optional, Tuple
+
+# Must match include/blackbox.h
+CRSF_SYNC = 0xC8
+CRSF_FRAMETYPE_BLACKBOX = 0x7F
+FORMAT_VERSION = 1
+UART_BAUD = 400000
+
+FIELDS = [
+    "ch1", "ch2", "ch3", "ch4", "ch5", "ch6", "ch7", "ch8",
+    "motor_fl", "motor_fr", "motor_rl", "motor_rr",
+    "weapon_us", "servo_us", "armed", "loop_us",
+]
+MOTOR_OFFSET = 256
+
+TRIGGERS = {0: "none (manual dump)", 1: "failsafe", 2: "error"}
+
+
+class DecodeError(Exception):
+    """Dump is incomplete or does not match this decoder."""
+    pass
+
+
+def crc8_dvb_s2(data: bytes) -> int:
+    """CRC8 DVB-S2 (polynomial 0xD5), as used by CRSF over type + payload."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0xD5) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def crc_ccitt(data: bytes) -> int:
+    """CRC-CCITT as avr-libc's _crc_ccitt_update (reflected 0x8408), start 0xFFFF."""
+    crc = 0xFFFF
+    for byte in data:
+        byte ^= crc & 0xFF
+        byte = (byte ^ (byte << 4)) & 0xFF
+        crc = (((byte << 8) | (crc >> 8)) ^ (byte >> 4) ^ (byte << 3)) & 0xFFFF
+    return crc
+
+
+def crsf_payloads(stream: bytes) -> Iterator[bytes]:
+    """Yield the payloads of valid black-box frames found in a byte stream."""
+    i = 0
+    while i + 4 <= len(stream):
+        length = stream[i + 1]
+        end = i + 2 + length
+        if stream[i] != CRSF_SYNC or length < 2 or end > len(stream):
+            i += 1
+            continue
+        body = stream[i + 2:end - 1]
+        if crc8_dvb_s2(body) != stream[end - 1]:
+            i += 1
+            continue
+        if body[0] == CRSF_FRAMETYPE_BLACKBOX:
+            yield body[1:]
+        i = end
+
+
+def assemble(stream: bytes) -> Tuple[Dict[str, int], bytes]:
+    """Collect the header and ring bytes of the last complete dump."""
+    header: Optional[Dict[str, int]] = None
+    chunks: Dict[int, bytes] = {}
+    result = None
+
+    for payload in crsf_payloads(stream):
+        kind = payload[:1]
+        if kind == b"H" and len(payload) >= 16:
+            header = {
+                "version": payload[1],
+                "trigger": payload[2],
+                "trigger_ms": int.from_bytes(payload[3:7], "big"),
+                "last_ms": int.from_bytes(payload[7:11], "big"),
+                "length": int.from_bytes(payload[11:13], "big"),
+                "period_ms": payload[13],
+                "loop_shift": payload[14],
+                "channel_shift": payload[15],
+            }
+            chunks = {}
+        elif kind == b"D" and header is not None:
+            chunks[int.from_bytes(payload[1:3], "big")] = payload[3:]
+        elif kind == b"E" and header is not None:
+            length = int.from_bytes(payload[1:3], "big")
+            crc = int.from_bytes(payload[3:5], "big")
+            data = b"".join(chunks[k] for k in sorted(chunks))
+            if len(data) != length or crc_ccitt(data) != crc:
+                raise DecodeError(
+                    f"dump incomplete: {len(data)}/{length} bytes received, "
+                    "frames were lost (repeat the dump)")
+            result = (header, data)
+            header = None
+
+    if result is None:
+        raise DecodeError("no complete black-box dump found")
+    if result[0]["version"] != FORMAT_VERSION:
+        raise DecodeError(f"format version {result[0]['version']}, decoder is {FORMAT_VERSION}")
+    return result
+
+
+class BitReader:
+    """MSB-first bit reader over the ring bytes."""
+
+    def __init__(self, data: bytes) -> None:
+        self.data = data
+        self.pos = 0  # Bit position
+
+    def bits(self, count: int) -> int:
+        value = 0
+        for _ in range(count):
+            if self.pos >= len(self.data) * 8:
+                raise DecodeError("ran past the end of the dump")
+            byte = self.data[self.pos >> 3]
+            value = (value << 1) | ((byte >> (7 - (self.pos & 7))) & 1)
+            self.pos += 1
+        return value
+
+    def golomb(self) -> int:
+        zeros = 0
+        while self.bits(1) == 0:
+            zeros += 1
+        return ((1 << zeros) | self.bits(zeros)) - 1
+
+    def align(self) -> None:
+        self.pos = (self.pos + 7) & ~7
+
+    def bytes_left(self) -> int:
+        return len(self.data) - (self.pos >> 3)
+
+
+def decode(header: Dict[str, int], data: bytes) -> List[List[int]]:
+    """Decode every block into rows of [t_ms] + FIELDS (time from the block start)."""
+    reader = BitReader(data)
+    rows: List[List[int]] = []
+    field_bits = [11 - header["channel_shift"]] * 8 + [9] * 4 + [12, 12, 1, 8]
+    period = header["period_ms"]
+    last_ms: Optional[int] = None
+
+    while reader.bytes_left() >= 3:
+        # Block header and keyframe
+        count = reader.bits(8)
+        start_ms = reader.bits(16)
+        if last_ms is not None:
+            # Unwrap the 16-bit start time (blocks are in order)
+            start_ms += (last_ms - start_ms + 0xFFFF) & ~0xFFFF
+        last_ms = start_ms
+        values = [reader.bits(bits) for bits in field_bits]
+        rows.append([start_ms] + values)
+
+        # Ticks coded as differences from the tick before
+        for tick in range(1, count):
+            if reader.bits(1):
+                for i in range(len(FIELDS)):
+                    z = reader.golomb()
+                    diff = (z >> 1) ^ -(z & 1)
+                    values[i] = (values[i] + diff) & 0xFFFF
+            rows.append([start_ms + tick * period] + values[:])
+        reader.align()
+
+    return rows
+
+
+def to_csv_row(row: List[int], header: Dict[str, int], time_offset: int) -> List[int]:
+    """Undo the field offsets and scaling for output."""
+    out = [row[0] + time_offset] + row[1:]
+    for i in range(0, 8):
+        out[1 + i] <<= header["channel_shift"]
+    for i in range(8, 12):
+        out[1 + i] -= MOTOR_OFFSET
+    out[-1] <<= header["loop_shift"]
+    return out
+
+
+def read_port(port: str, seconds: float) -> bytes:
+    """Capture the UART for a while (start the dump gesture meanwhile)."""
+    try:
+        import serial  # pyserial
+    except ImportError as e:
+        raise DecodeError("reading a port needs pyserial (pip install pyserial)") from e
+
+    print(f"Capturing {port} for {seconds:.0f} s - hold the dump gesture now", file=sys.stderr)
+    captured = bytearray()
+    with serial.Serial(port, UART_BAUD, timeout=0.1) as ser:
+        end = time.monotonic() + seconds
+        while time.monotonic() < end:
+            captured += ser.read(4096)
+    return bytes(captured)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Decode a black-box dump into CSV")
+    parser.add_argument("capture", nargs="?", help="Raw UART capture file")
+    parser.add_argument("--port", help="Serial port to capture from instead of a file")
+    parser.add_argument("--seconds", type=float, default=15.0, help="Capture time with --port")
+    parser.add_argument("-o", "--output", help="CSV file (default: stdout)")
+    args = parser.parse_args()
+
+    try:
+        if args.port:
+            stream = read_port(args.port, args.seconds)
+        elif args.capture:
+            with open(args.capture, "rb") as f:
+                stream = f.read()
+        else:
+            parser.error("give a capture file or --port")
+
+        header, data = assemble(stream)
+        rows = decode(header, data)
+    except (DecodeError, OSError) as e:
+        print(f"✗ {e}", file=sys.stderr)
+        return 1
+
+    # Times: ms since boot (block start times only carry the low 16 bits;
+    # the newest tick's full time places them)
+    time_offset = 0
+    trigger = header["trigger"]
+    if rows:
+        time_offset = (header["last_ms"] - rows[-1][0] + 0x8000) & ~0xFFFF
+    print(f"{len(rows)} ticks, {len(data)} bytes, trigger: {TRIGGERS.get(trigger, trigger)}"
+          + (f" at {header['trigger_ms']} ms" if trigger else ""), file=sys.stderr)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        writer = csv.writer(out)
+        writer.writerow(["t_ms"] + FIELDS)
+        for row in rows:
+            writer.writerow(to_csv_row(row, header, time_offset))
+    finally:
+        if args.output:
+            out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""
+DShot timing check for UpVote Arduino BattleBot.
+
+Reads a VCD trace of the weapon ESC pin (D9 / PB1) and checks every DShot
+frame in it: bit period, high time of 0 and 1 bits, and the frame CRC.
+The trace comes from the simavr_dshot test environment (see platformio.ini)
+or from any logic analyser that can save VCD.
+
+Usage:
+    dshot_trace_check.py trace.vcd [--rate 300] [--expect 0,48,2047]
+
+--expect checks the decoded 11-bit values of the first frames in order.
+Exit status is 0 when every frame passes.
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+from typing import List, Optional, Tuple
+
+# DShot bit: 0 is high for 3/8 of the period, 1 for 3/4
+T0H_FRACTION = 0.375
+T1H_FRACTION = 0.75
+TOLERANCE = 0.08           # Of the bit period, for each high time
+PERIOD_TOLERANCE = 0.05    # Of the nominal bit period
+FRAME_GAP_BITS = 2.0       # Low for longer than this ends a frame
+
+UNITS = {"s": 1.0, "ms": 1e-3, "us": 1e-6, "ns": 1e-9, "ps": 1e-12, "fs": 1e-15}
+
+
+class TraceError(Exception):
+    """Trace is unreadable or has no usable signal."""
+    pass
+
+
+def read_edges(path: str, signal: Optional[str]) -> List[Tuple[float, int]]:
+    """Level changes (time in s, 0/1) of one signal in a VCD file."""
+    with open(path) as f:
+        tokens = f.read().split()
+
+    timescale = 1e-9
+    ident = None
+    names = []
+    i = 0
+    # Header
+    while i < len(tokens) and tokens[i] != "$enddefinitions":
+        if tokens[i] == "$timescale":
+            text = ""
+            i += 1
+            while tokens[i] != "$end":
+                text += tokens[i]
+                i += 1
+            number = text.rstrip("abcdefghijklmnopqrstuvwxyz") or "1"
+            timescale = float(number) * UNITS[text[len(number):]]
+        elif tokens[i] == "$var":
+            # $var <type> <width> <id> <name> [range] $end
+            name = tokens[i + 4]
+            names.append(name)
+            if ident is None and (signal is None or name == signal):
+                ident = tokens[i + 3]
+        i += 1
+    if ident is None:
+        raise TraceError(f"signal {signal!r} not in trace (have: {', '.join(names)})")
+
+    # Value changes
+    edges: List[Tuple[float, int]] = []
+    now = 0.0
+    level = None
+    while i < len(tokens):
+        token = tokens[i]
+        value = None
+        if token.startswith("#"):
+            now = int(token[1:]) * timescale
+        elif token[0] in "bB" and i + 1 < len(tokens) and tokens[i + 1] == ident:
+            value = 1 if any(c == "1" for c in token[1:]) else 0
+            i += 1
+        elif token[0] in "01xzXZ" and token[1:] == ident:
+            value = 1 if token[0] == "1" else 0
+        if value is not None and value != level:
+            edges.append((now, value))
+            level = value
+        i += 1
+    return edges
+
+
+def split_frames(edges: List[Tuple[float, int]], bit_s: float) -> List[List[Tuple[float, float]]]:
+    """Group pulses (rise time, high time) into frames separated by idle low."""
+    frames: List[List[Tuple[float, float]]] = []
+    current: List[Tuple[float, float]] = []
+    rise = None
+    last_fall = None
+    for time, level in edges:
+        if level == 1:
+            if current and last_fall is not None and time - last_fall > FRAME_GAP_BITS * bit_s:
+                frames.append(current)
+                current = []
+            rise = time
+        elif rise is not None:
+            current.append((rise, time - rise))
+            last_fall = time
+            rise = None
+    if current:
+        frames.append(current)
+    return frames
+
+
+def check_frame(pulses: List[Tuple[float, float]], bit_s: float) -> Tuple[Optional[int], List[str]]:
+    """Decode one frame; returns (11-bit value or None, problems)."""
+    problems = []
+    if len(pulses) != 16:
+        return None, [f"{len(pulses)} bits, expected 16"]
+
+    word = 0
+    for n, (rise, high) in enumerate(pulses):
+        if n > 0:
+            period = rise - pulses[n - 1][0]
+            if abs(period - bit_s) > PERIOD_TOLERANCE * bit_s:
+                problems.append(f"bit {n}: period {period * 1e6:.3f} us")
+        fraction = high / bit_s
+        if abs(fraction - T1H_FRACTION) <= TOLERANCE:
+            word = (word << 1) | 1
+        elif abs(fraction - T0H_FRACTION) <= TOLERANCE:
+            word <<= 1
+        else:
+            problems.append(f"bit {n}: high {high * 1e6:.3f} us is neither a 0 nor a 1")
+            word <<= 1
+
+    packet = word >> 4
+    crc = (packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F
+    if crc != word & 0x0F:
+        problems.append(f"CRC {word & 0x0F:#x}, expected {crc:#x}")
+    return packet >> 1, problems
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Check DShot frame timing in a VCD trace")
+    parser.add_argument("trace", help="VCD file")
+    parser.add_argument("--signal", help="Signal name in the trace (default: the first one)")
+    parser.add_argument("--rate", type=int, default=300, choices=(150, 300, 600),
+                        help="DShot rate in kbit/s (default 300)")
+    parser.add_argument("--expect", help="Comma-separated values of the first frames")
+    args = parser.parse_args()
+
+    bit_s = 1.0 / (args.rate * 1000)
+    try:
+        edges = read_edges(args.trace, args.signal)
+    except (TraceError, OSError, ValueError, KeyError, IndexError) as e:
+        print(f"✗ {args.trace}: {e}", file=sys.stderr)
+        return 1
+
+    frames = split_frames(edges, bit_s)
+    if not frames:
+        print("✗ no DShot frames in the trace", file=sys.stderr)
+        return 1
+
+    failed = 0
+    values = []
+    for n, pulses in enumerate(frames):
+        value, problems = check_frame(pulses, bit_s)
+        values.append(value)
+        highs0 = [h for _, h in pulses if abs(h / bit_s - T0H_FRACTION) <= TOLERANCE]
+        highs1 = [h for _, h in pulses if abs(h / bit_s - T1H_FRACTION) <= TOLERANCE]
+        timing = ""
+        if len(pulses) > 1:
+            period = (pulses[-1][0] - pulses[0][0]) / (len(pulses) - 1)
+            timing = f"bit {period * 1e6:.3f} us"
+            if highs0:
+                timing += f", T0H {max(highs0) * 1e6:.3f} us"
+            if highs1:
+                timing += f", T1H {max(highs1) * 1e6:.3f} us"
+        status = "✓" if not problems else "✗"
+        print(f"{status} frame {n} at {pulses[0][0] * 1e3:.3f} ms: value {value} ({timing})")
+        for problem in problems:
+            print(f"    {problem}")
+        failed += bool(problems)
+
+    if args.expect:
+        expected = [int(v) for v in args.expect.split(",")]
+        if values[:len(expected)] != expected:
+            print(f"✗ first values {values[:len(expected)]}, expected {expected}")
+            failed += 1
+
+    print(f"{len(frames)} frames, {failed} failed")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
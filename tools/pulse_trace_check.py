@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+OneShot125 / Multishot timing check for UpVote Arduino BattleBot.
+
+Reads a VCD trace of the weapon ESC pin (D9 / PB1), the self-right servo
+pin (D10 / PB2) and a marker pin that is high around each pulse_out_write()
+(D13 / PB5), and checks the Timer1 fast-protocol output:
+
+  - weapon pulse widths: within the protocol's range, the same from one
+    write to the next, and the --expect throttles after the first writes
+  - framing: 400 Hz between weapon pulses with no write in between
+  - servo: one pulse every 8 frames (50 Hz), of --servo-us, inside a frame
+    and clear of both weapon pulses around it
+  - restart on write: the next weapon pulse starts within --restart-us of
+    the marker, unless the write fell in a servo frame or in the guard
+    around the weapon pulse and the frame end (then by the next frame)
+
+The trace comes from the simavr_oneshot and simavr_multishot test
+environments (see platformio.ini) or from a logic analyser that saves VCD.
+
+Usage:
+    pulse_trace_check.py trace.vcd --protocol oneshot125 [--expect 1000,1500,2000]
+    pulse_trace_check.py trace.vcd --protocol multishot [--servo-us 1500]
+
+Exit status is 0 when every check passes.
+"""
+
+from __future__ import annotations
+
+import argparse
+import sys
+from typing import List, Tuple
+
+from dshot_trace_check import TraceError, read_edges
+
+FRAME_HZ = 400             # PULSE_FAST_HZ
+SERVO_FRAMES = 8           # PULSE_FAST_HZ / PULSE_OUT_HZ
+THROTTLE_MIN_US = 1000     # WEAPON_ESC_MIN_US
+THROTTLE_MAX_US = 2000     # WEAPON_ESC_MAX_US
+RESTART_MARGIN_S = 64 / 16e6   # PULSE_RESTART_MARGIN ticks at prescaler 1
+WIDTH_TOLERANCE_S = 0.25e-6    # Tick rounding and the compare-match tick
+PERIOD_TOLERANCE = 0.002       # Of the nominal frame or servo period
+
+
+def weapon_width_s(protocol: str, throttle_us: float) -> float:
+    """Nominal weapon pulse for a throttle (1000-2000 us) per the protocol."""
+    if protocol == "oneshot125":
+        return throttle_us / 8 * 1e-6
+    return (5 + (throttle_us - 1000) / 50) * 1e-6
+
+
+def pulses(edges: List[Tuple[float, int]]) -> List[Tuple[float, float]]:
+    """Complete high pulses as (rise time, high time)."""
+    out = []
+    rise = None
+    for time, level in edges:
+        if level == 1:
+            rise = time
+        elif rise is not None:
+            out.append((rise, time - rise))
+            rise = None
+    return out
+
+
+def rises(edges: List[Tuple[float, int]]) -> List[float]:
+    return [time for time, level in edges if level == 1]
+
+
+def between(times: List[float], start: float, end: float) -> int:
+    return sum(1 for t in times if start < t <= end)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Check OneShot125/Multishot timing in a VCD trace")
+    parser.add_argument("trace", help="VCD file")
+    parser.add_argument("--protocol", required=True, choices=("oneshot125", "multishot"))
+    parser.add_argument("--weapon", default="PB1", help="Weapon signal name (default PB1)")
+    parser.add_argument("--servo", default="PB2", help="Servo signal name (default PB2)")
+    parser.add_argument("--marker", default="PB5", help="Write marker signal name (default PB5)")
+    parser.add_argument("--servo-us", type=int, default=1500, help="Servo pulse width (default 1500)")
+    parser.add_argument("--restart-us", type=float, default=5.0,
+                        help="Longest write-to-pulse latency of a restarted frame (default 5)")
+    parser.add_argument("--expect", help="Comma-separated throttles (us) of the first writes")
+    args = parser.parse_args()
+
+    try:
+        weapon = pulses(read_edges(args.trace, args.weapon))
+        servo = pulses(read_edges(args.trace, args.servo))
+        markers = rises(read_edges(args.trace, args.marker))
+    except (TraceError, OSError, ValueError, KeyError, IndexError) as e:
+        print(f"✗ {args.trace}: {e}", file=sys.stderr)
+        return 1
+    if len(weapon) < 2 * SERVO_FRAMES or len(servo) < 2:
+        print(f"✗ {len(weapon)} weapon and {len(servo)} servo pulses: trace too short", file=sys.stderr)
+        return 1
+
+    frame_s = 1.0 / FRAME_HZ
+    min_s = weapon_width_s(args.protocol, THROTTLE_MIN_US)
+    max_s = weapon_width_s(args.protocol, THROTTLE_MAX_US)
+    weapon_rises = [rise for rise, _ in weapon]
+    failed = 0
+
+    def report(ok: bool, text: str, problems: List[str]) -> None:
+        nonlocal failed
+        print(f"{'✓' if ok else '✗'} {text}")
+        for problem in problems[:10]:
+            print(f"    {problem}")
+        if len(problems) > 10:
+            print(f"    ... {len(problems) - 10} more")
+        failed += not ok
+
+    # Weapon widths: in range, constant between writes, --expect after writes
+    problems = []
+    for rise, high in weapon:
+        if not min_s - WIDTH_TOLERANCE_S <= high <= max_s + WIDTH_TOLERANCE_S:
+            problems.append(f"{rise * 1e3:.3f} ms: {high * 1e6:.3f} us out of range")
+    bounds = [0.0] + markers + [weapon_rises[-1] + frame_s]
+    for start, end in zip(bounds, bounds[1:]):
+        # The first pulse after a write may still be the old width
+        held = [high for rise, high in weapon if start < rise <= end][1:]
+        if held and max(held) - min(held) > WIDTH_TOLERANCE_S:
+            problems.append(f"{start * 1e3:.3f} ms: width varies "
+                            f"{min(held) * 1e6:.3f}-{max(held) * 1e6:.3f} us without a write")
+    if args.expect:
+        expected = [int(v) for v in args.expect.split(",")]
+        if len(markers) < len(expected):
+            problems.append(f"{len(markers)} writes, expected at least {len(expected)}")
+        for marker, end, throttle in zip(markers, markers[1:] + [bounds[-1]], expected):
+            held = [high for rise, high in weapon if marker < rise <= end][-1:]
+            want = weapon_width_s(args.protocol, throttle)
+            if not held or abs(held[0] - want) > WIDTH_TOLERANCE_S:
+                got = f"{held[0] * 1e6:.3f} us" if held else "no pulse"
+                problems.append(f"{throttle} us write at {marker * 1e3:.3f} ms: {got}, "
+                                f"expected {want * 1e6:.3f} us")
+    report(not problems, f"weapon widths {min(h for _, h in weapon) * 1e6:.3f}-"
+           f"{max(h for _, h in weapon) * 1e6:.3f} us ({args.protocol} "
+           f"{min_s * 1e6:.0f}-{max_s * 1e6:.0f} us), {len(weapon)} pulses", problems)
+
+    # Framing: undisturbed frames are 2.5 ms
+    problems = []
+    periods = []
+    for a, b in zip(weapon_rises, weapon_rises[1:]):
+        if between(markers, a, b):
+            continue
+        periods.append(b - a)
+        if abs(b - a - frame_s) > PERIOD_TOLERANCE * frame_s:
+            problems.append(f"{a * 1e3:.3f} ms: frame {(b - a) * 1e3:.4f} ms")
+    report(not problems and bool(periods),
+           f"frames {min(periods, default=0) * 1e3:.4f}-{max(periods, default=0) * 1e3:.4f} ms "
+           f"({1e3 / FRAME_HZ:.1f} ms nominal), {len(periods)} without a write", problems)
+
+    # Servo: width, every SERVO_FRAMES frames, inside its frame
+    problems = []
+    servo_s = args.servo_us * 1e-6
+    for n, (rise, high) in enumerate(servo):
+        if abs(high - servo_s) > WIDTH_TOLERANCE_S:
+            problems.append(f"{rise * 1e3:.3f} ms: servo {high * 1e6:.3f} us")
+        before = [(r, h) for r, h in weapon if r <= rise]
+        after = [r for r in weapon_rises if r >= rise]
+        if before and rise < before[-1][0] + before[-1][1] - WIDTH_TOLERANCE_S:
+            problems.append(f"{rise * 1e3:.3f} ms: servo starts inside a weapon pulse")
+        if after and rise + high > after[0] + WIDTH_TOLERANCE_S:
+            problems.append(f"{rise * 1e3:.3f} ms: servo runs into the next frame")
+        if n > 0:
+            last = servo[n - 1][0]
+            frames = between(weapon_rises, last, rise)
+            if frames != SERVO_FRAMES:
+                problems.append(f"{rise * 1e3:.3f} ms: {frames} frames since the last servo pulse")
+            elif not between(markers, last, rise) and \
+                    abs(rise - last - SERVO_FRAMES * frame_s) > PERIOD_TOLERANCE * frame_s:
+                problems.append(f"{rise * 1e3:.3f} ms: servo period {(rise - last) * 1e3:.3f} ms")
+    report(not problems, f"servo {len(servo)} pulses of {args.servo_us} us, "
+           f"every {SERVO_FRAMES} frames ({SERVO_FRAMES * 1e3 / FRAME_HZ:.0f} ms)", problems)
+
+    # Restart on write
+    problems = []
+    latencies = []
+    deferred = 0
+    for marker in markers:
+        after = [r for r in weapon_rises if r >= marker]
+        before = [r for r in weapon_rises if r < marker]
+        if not after or not before:
+            continue
+        latency = after[0] - marker
+        if latency <= args.restart_us * 1e-6:
+            latencies.append(latency)
+            continue
+        deferred += 1
+        into = marker - before[-1]
+        servo_frame = any(before[-1] < r < after[0] for r, _ in servo)
+        guard = into < max_s + RESTART_MARGIN_S + WIDTH_TOLERANCE_S or \
+            into > frame_s - RESTART_MARGIN_S - WIDTH_TOLERANCE_S
+        if not (servo_frame or guard):
+            problems.append(f"write at {marker * 1e3:.3f} ms ({into * 1e6:.1f} us into the frame) "
+                            f"not restarted: next pulse after {latency * 1e6:.1f} us")
+        elif latency > frame_s * (1 + PERIOD_TOLERANCE):
+            problems.append(f"write at {marker * 1e3:.3f} ms: next pulse after {latency * 1e6:.1f} us")
+    if len(latencies) * 2 < len(markers):
+        problems.append(f"only {len(latencies)} of {len(markers)} writes restarted the frame")
+    report(not problems, f"restart on write: {len(latencies)} of {len(markers)} writes, "
+           f"worst {max(latencies, default=0) * 1e6:.3f} us (limit {args.restart_us} us), "
+           f"{deferred} deferred to the next frame", problems)
+
+    print(f"{failed} checks failed" if failed else "all checks passed")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Flash and RAM use of two firmware revisions for UpVote Arduino BattleBot.
+
+Builds the uno environment at each git revision (in a temporary worktree,
+so the checkout is left alone) and prints avr-size figures side by side:
+flash (.text + .data), static RAM (.data + .bss) and what is left of the
+2 KB for the stack. A revision of "." means the working tree as it is.
+
+Usage:
+    size_compare.py BEFORE [AFTER]        (AFTER defaults to ".")
+    size_compare.py eb90ae6^ eb90ae6      (a single commit's effect)
+
+Needs PlatformIO (pio) on the PATH; avr-size is taken from PATH or from
+PlatformIO's toolchain-atmelavr package.
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+from typing import Dict
+
+ENV = "uno"
+FLASH_BYTES = 32256        # ATmega328P less the Optiboot bootloader
+RAM_BYTES = 2048
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SUBMODULE = os.path.join("sub", "AlfredoCRSF")
+
+
+class BuildError(Exception):
+    """A revision did not build or its image could not be read."""
+    pass
+
+
+def find_avr_size() -> str:
+    path = shutil.which("avr-size")
+    if path:
+        return path
+    home = os.environ.get("PLATFORMIO_CORE_DIR", os.path.expanduser("~/.platformio"))
+    path = os.path.join(home, "packages", "toolchain-atmelavr", "bin", "avr-size")
+    if os.path.exists(path):
+        return path
+    raise BuildError("avr-size not found (build once with pio, or put it on PATH)")
+
+
+def sections(elf: str) -> Dict[str, int]:
+    """Section sizes (bytes) of an ELF image, from avr-size -A."""
+    out = subprocess.run([find_avr_size(), "-A", elf], check=True,
+                         capture_output=True, text=True).stdout
+    sizes = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0].startswith(".") and fields[1].isdigit():
+            sizes[fields[0]] = int(fields[1])
+    return sizes
+
+
+def build(project: str) -> Dict[str, int]:
+    result = subprocess.run(["pio", "run", "-e", ENV, "-d", project],
+                            capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout[-2000:] + result.stderr[-2000:])
+        raise BuildError("build failed in " + project)
+    return sections(os.path.join(project, ".pio", "build", ENV, "firmware.elf"))
+
+
+def build_revision(rev: str) -> Dict[str, int]:
+    """Build one revision ("." = the working tree) and return its sections."""
+    if rev == ".":
+        return build(REPO)
+    tmp = tempfile.mkdtemp(prefix="size_compare_")
+    tree = os.path.join(tmp, "tree")
+    try:
+        subprocess.run(["git", "-C", REPO, "worktree", "add", "--detach", tree, rev],
+                       check=True, capture_output=True)
+        # The CRSF library is a submodule: share the checked-out copy
+        link = os.path.join(tree, SUBMODULE)
+        if os.path.isdir(link):
+            os.rmdir(link)
+        os.makedirs(os.path.dirname(link), exist_ok=True)
+        os.symlink(os.path.join(REPO, SUBMODULE), link)
+        return build(tree)
+    finally:
+        subprocess.run(["git", "-C", REPO, "worktree", "remove", "--force", tree],
+                       capture_output=True)
+        shutil.rmtree(tmp, ignore_errors=True)
+
+
+def summary(s: Dict[str, int]) -> Dict[str, int]:
+    text, data, bss = s.get(".text", 0), s.get(".data", 0), s.get(".bss", 0)
+    return {
+        "Flash": text + data,
+        "Static RAM": data + bss,
+        "  .data": data,
+        "  .bss": bss,
+        "Left for stack": RAM_BYTES - data - bss,
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compare flash and RAM use of two revisions")
+    parser.add_argument("before", help="git revision before the change")
+    parser.add_argument("after", nargs="?", default=".", help="revision after (default: working tree)")
+    args = parser.parse_args()
+
+    try:
+        before = summary(build_revision(args.before))
+        after = summary(build_revision(args.after))
+    except (BuildError, OSError, subprocess.CalledProcessError) as e:
+        print("size_compare: %s" % e, file=sys.stderr)
+        return 1
+
+    print("%-16s %10s %10s %8s" % ("bytes", args.before, args.after, "change"))
+    for key in before:
+        print("%-16s %10d %10d %+8d" % (key, before[key], after[key], after[key] - before[key]))
+    print("(flash of %d, RAM of %d)" % (FLASH_BYTES, RAM_BYTES))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())